@@ -25,9 +25,13 @@
 #include <stdio.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
+#include "driver/gpio.h"
+#include "esp_timer.h"
 #include "esp_log.h"
 #include "esp_err.h"
 #include "../i2c_master/include/i2c_master.h"
+#include "../i2c_master/include/i2c_master_int.h"
 
 static const char *TAG = "ADS1115";
 
@@ -36,6 +40,80 @@ static const char *TAG = "ADS1115";
         return (ret);                                                            \
         }
 
+/**
+  * @brief  Get the voltage of one conversion code LSB according to the range.
+  * @param[in]  crh  high byte of the configuration register.
+  * @retval  LSB voltage, single: V.
+  */
+static double ads1115_get_lsb_voltage(uint8_t crh)
+{
+    switch(0b00001110&crh){
+        case(ADS1115_REG_CONFIG_PGA_FSR_6114):
+            return 187.5/1000000.0;
+        case(ADS1115_REG_CONFIG_PGA_FSR_4096):
+            return 125/1000000.0;
+        case(ADS1115_REG_CONFIG_PGA_FSR_2048):
+            return 62.5/1000000.0;
+        case(ADS1115_REG_CONFIG_PGA_FSR_1024):
+            return 31.25/1000000.0;
+        case(ADS1115_REG_CONFIG_PGA_FSR_0512):
+            return 15.625/1000000.0;
+        case(ADS1115_REG_CONFIG_PGA_FSR_0256):
+            return 7.8125/1000000.0;
+    }
+    return 0.0;
+}
+
+/**
+  * @brief  Modify some bits of the configuration register.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[in]  mask  configuration register bits to be modified(CRH<<8 | CRL).
+  * @param[in]  val  new value of the bits.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The OS bit is always written as 0, so no single conversion is started.
+  */
+static esp_err_t ads1115_update_config(ADS1115_handle_t ads1115_handle, uint16_t mask, uint16_t val)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t data_buf[2] = {0};
+    uint16_t config = 0;
+
+    err = I2cMaster_ReadReg(ads1115_handle->i2c_handle, ads1115_handle->i2c_addr, 
+                            ADS1115_POINTER_CONFIG_REG, data_buf, 2);
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
+    config = (data_buf[0] << 8) | data_buf[1];
+    config &= ~(mask | (ADS1115_REG_CONFIG_OS_W_SINGLE_START << 8));
+    config |= (val & mask);
+    data_buf[0] = config >> 8;
+    data_buf[1] = config & 0xFF;
+    err = I2cMaster_WriteReg(ads1115_handle->i2c_handle, ads1115_handle->i2c_addr, 
+                             ADS1115_POINTER_CONFIG_REG, data_buf, 2);
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/**
+  * @brief  ALERT/RDY pin interrupt service, post the current time to the handle queue.
+  * @param[in]  arg  ads1115 operation handle.
+  */
+static void IRAM_ATTR ads1115_alert_isr_handler(void *arg)
+{
+    ADS1115_handle_t ads1115_handle = (ADS1115_handle_t)arg;
+    BaseType_t task_woken = pdFALSE;
+    int64_t time_us = esp_timer_get_time();
+
+    xQueueSendFromISR(ads1115_handle->alert_queue, &time_us, &task_woken);
+    if (pdTRUE == task_woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
 /**
   * @brief  Initialize the ADS1115 and obtain an operation handle.
   * @param[in]  i2c_handle  i2c master operation handle.
@@ -71,6 +149,8 @@ ADS1115_handle_t ADS1115_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr)
     }
     ads1115_handle->i2c_handle = i2c_handle;
     ads1115_handle->i2c_addr = i2c_addr;
+    ads1115_handle->alert_pin = -1;
+    ads1115_handle->alert_queue = NULL;
     ESP_LOGI(TAG, "%s (%d) ads1115 init ok.", __FUNCTION__, __LINE__);
     return ads1115_handle;
 }
@@ -86,6 +166,9 @@ esp_err_t ADS1115_Deinit(ADS1115_handle_t* ads1115_handle)
 {
     ADS1115_HANDLE_CHECK(*ads1115_handle, ESP_FAIL);
 
+    if (NULL != (*ads1115_handle)->alert_queue) {
+        ADS1115_AlertIntrDisable(*ads1115_handle);
+    }
     free(*ads1115_handle);
     *ads1115_handle = NULL;
     ESP_LOGI(TAG, "%s (%d) ads1115 handle deinit ok.", __FUNCTION__, __LINE__);
@@ -194,25 +277,285 @@ double ADS1115_GetVoltageOnce(ADS1115_handle_t ads1115_handle)
     }
 
     // Calculate the voltage value according to the range.
-    switch(0b00001110&crh){
-        case(ADS1115_REG_CONFIG_PGA_FSR_6114):
-            vol_val = (double)vol_data*187.5/1000000.0;
-        break;
-        case(ADS1115_REG_CONFIG_PGA_FSR_4096):
-            vol_val = (double)vol_data*125/1000000.0;
-        break;
-        case(ADS1115_REG_CONFIG_PGA_FSR_2048):
-            vol_val = (double)vol_data*62.5/1000000.0;
-        break;
-        case(ADS1115_REG_CONFIG_PGA_FSR_1024):
-            vol_val = (double)vol_data*31.25/1000000.0;
-        break;
-        case(ADS1115_REG_CONFIG_PGA_FSR_0512):
-            vol_val = (double)vol_data*15.625/1000000.0;
-        break;
-        case(ADS1115_REG_CONFIG_PGA_FSR_0256):
-            vol_val = (double)vol_data*7.8125/1000000.0;
-        break;
-    }
+    vol_val = (double)vol_data*ads1115_get_lsb_voltage(crh);
     return vol_val;
 }
+
+/**
+  * @brief  ADS1115 Operation mode configuration.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[in]  mode_config  ads1115 operation mode.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The comparator only works while conversions are running, use
+  *        ADS1115_REG_CONFIG_MODE_CONT to monitor the input continuously.
+  */
+esp_err_t ADS1115_SetMode(ADS1115_handle_t ads1115_handle, ADS1115_RegConfigMode_t mode_config)
+{
+    ADS1115_HANDLE_CHECK(ads1115_handle, ESP_FAIL);
+
+    return ads1115_update_config(ads1115_handle, (0b1 << 8), (mode_config << 8));
+}
+
+/**
+  * @brief  ADS1115 Conversion rate configuration.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[in]  dr_config  ads1115 conversion rate.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t ADS1115_SetDataRate(ADS1115_handle_t ads1115_handle, ADS1115_RegConfigDr_t dr_config)
+{
+    ADS1115_HANDLE_CHECK(ads1115_handle, ESP_FAIL);
+
+    return ads1115_update_config(ads1115_handle, (0b111 << 5), dr_config);
+}
+
+/**
+  * @brief  ADS1115 Comparator configuration.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[in]  compm_config  comparator mode, traditional or window.
+  * @param[in]  compp_config  ALERT/RDY pin polarity.
+  * @param[in]  compl_config  comparator latching.
+  * @param[in]  compq_config  number of successive conversions exceeding the threshold
+  *                           before the ALERT/RDY pin is asserted, or disable the comparator.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  All comparator bits are written in a single register write.
+  */
+esp_err_t ADS1115_ConfigComparator(ADS1115_handle_t ads1115_handle, ADS1115_RegConfigCompm_t compm_config, 
+                                   ADS1115_RegConfigCompp_t compp_config, ADS1115_RegConfigCompl_t compl_config, 
+                                   ADS1115_RegConfigCompq_t compq_config)
+{
+    ADS1115_HANDLE_CHECK(ads1115_handle, ESP_FAIL);
+
+    // COMP_MODE, COMP_POL, COMP_LAT and COMP_QUE are CRL[4:0].
+    return ads1115_update_config(ads1115_handle, 0b11111, 
+                                 compm_config | compp_config | compl_config | compq_config);
+}
+
+/**
+  * @brief  Write the low and high threshold registers.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[in]  lo_thresh  Lo_thresh register value.
+  * @param[in]  hi_thresh  Hi_thresh register value.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+static esp_err_t ads1115_write_threshold(ADS1115_handle_t ads1115_handle, int16_t lo_thresh, int16_t hi_thresh)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t data_buf[2] = {0};
+
+    data_buf[0] = (uint16_t)lo_thresh >> 8;
+    data_buf[1] = (uint16_t)lo_thresh & 0xFF;
+    err = I2cMaster_WriteReg(ads1115_handle->i2c_handle, ads1115_handle->i2c_addr, 
+                             ADS1115_POINTER_LOTHRESH_REG, data_buf, 2);
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
+    data_buf[0] = (uint16_t)hi_thresh >> 8;
+    data_buf[1] = (uint16_t)hi_thresh & 0xFF;
+    err = I2cMaster_WriteReg(ads1115_handle->i2c_handle, ads1115_handle->i2c_addr, 
+                             ADS1115_POINTER_HITHRESH_REG, data_buf, 2);
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/**
+  * @brief  ADS1115 Set comparator thresholds(conversion code).
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[in]  lo_thresh  low threshold, same format as the conversion register.
+  * @param[in]  hi_thresh  high threshold, same format as the conversion register.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by lo_thresh >= hi_thresh.
+  * @note  Also leaves the conversion ready mode of ADS1115_SetConversionReady().
+  */
+esp_err_t ADS1115_SetThreshold(ADS1115_handle_t ads1115_handle, int16_t lo_thresh, int16_t hi_thresh)
+{
+    ADS1115_HANDLE_CHECK(ads1115_handle, ESP_FAIL);
+    if (lo_thresh >= hi_thresh) {
+        ESP_LOGE(TAG, "%s (%d) low threshold must be less than high threshold.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    return ads1115_write_threshold(ads1115_handle, lo_thresh, hi_thresh);
+}
+
+/**
+  * @brief  ADS1115 Set comparator thresholds(voltage).
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[in]  lo_vol  low threshold, single: V.
+  * @param[in]  hi_vol  high threshold, single: V.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The voltage is converted with the current range, call ADS1115_SetPga() first.
+  */
+esp_err_t ADS1115_SetThresholdVoltage(ADS1115_handle_t ads1115_handle, double lo_vol, double hi_vol)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t data_buf[2] = {0};
+    double lsb = 0.0, lo_code = 0.0, hi_code = 0.0;
+
+    ADS1115_HANDLE_CHECK(ads1115_handle, ESP_FAIL);
+
+    err = I2cMaster_ReadReg(ads1115_handle->i2c_handle, ads1115_handle->i2c_addr, 
+                            ADS1115_POINTER_CONFIG_REG, data_buf, 2);
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
+    lsb = ads1115_get_lsb_voltage(data_buf[0]);
+    if (0.0 == lsb) {
+        return ESP_FAIL;
+    }
+
+    // Limit to the conversion code range.
+    lo_code = lo_vol / lsb;
+    hi_code = hi_vol / lsb;
+    lo_code = (lo_code < -32768.0) ? -32768.0 : ((lo_code > 32767.0) ? 32767.0 : lo_code);
+    hi_code = (hi_code < -32768.0) ? -32768.0 : ((hi_code > 32767.0) ? 32767.0 : hi_code);
+    return ADS1115_SetThreshold(ads1115_handle, (int16_t)lo_code, (int16_t)hi_code);
+}
+
+/**
+  * @brief  ADS1115 Use the ALERT/RDY pin as a conversion ready signal.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Writes Hi_thresh MSB 1 and Lo_thresh MSB 0, which ADS1115_SetThreshold() rejects. 
+  *        The comparator queue must not be ADS1115_REG_CONFIG_COMPQ_DISABLE, see 
+  *        ADS1115_ConfigComparator(), the pin polarity still applies.
+  * @note  In continuous mode the pin pulses for about 8us after each conversion, in single 
+  *        shot mode it is asserted at the end of the conversion. With ADS1115_AlertIntrEnable() 
+  *        each ADS1115_WaitAlert() returns one conversion without polling the OS bit.
+  * @note  Use ADS1115_SetThreshold() to go back to the comparator.
+  */
+esp_err_t ADS1115_SetConversionReady(ADS1115_handle_t ads1115_handle)
+{
+    ADS1115_HANDLE_CHECK(ads1115_handle, ESP_FAIL);
+
+    return ads1115_write_threshold(ads1115_handle, 0x0000, INT16_MIN);
+}
+
+/**
+  * @brief  ADS1115 Route the ALERT/RDY pin to a GPIO interrupt.
+  *         Each time the pin becomes active, the ISR posts an event to the handle queue, 
+  *         use ADS1115_WaitAlert() to receive it.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[in]  alert_pin  gpio connected to the ALERT/RDY pin.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The interrupt edge follows the comparator polarity, call ADS1115_ConfigComparator() first.
+  * @note  alert_pin is set up by I2cMaster_IntPinSetup() on the edge of the comparator polarity.
+  */
+esp_err_t ADS1115_AlertIntrEnable(ADS1115_handle_t ads1115_handle, gpio_num_t alert_pin)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t data_buf[2] = {0};
+
+    ADS1115_HANDLE_CHECK(ads1115_handle, ESP_FAIL);
+    if (NULL != ads1115_handle->alert_queue) {
+        ESP_LOGE(TAG, "%s (%d) alert interrupt has been enabled.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    // The interrupt edge depends on the comparator polarity.
+    err = I2cMaster_ReadReg(ads1115_handle->i2c_handle, ads1115_handle->i2c_addr, 
+                            ADS1115_POINTER_CONFIG_REG, data_buf, 2);
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
+
+    ads1115_handle->alert_queue = xQueueCreate(ADS1115_ALERT_QUEUE_LEN, sizeof(int64_t));
+    if (NULL == ads1115_handle->alert_queue) {
+        ESP_LOGE(TAG, "%s (%d) alert queue create failed.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    // An active high ALERT/RDY pin interrupts on the rising edge.
+    err = I2cMaster_IntPinSetup(alert_pin, (data_buf[1] & ADS1115_REG_CONFIG_COMPP_ACTIVE_HIG) ? 
+                                GPIO_INTR_POSEDGE : GPIO_INTR_NEGEDGE, ads1115_alert_isr_handler, ads1115_handle);
+    if (ESP_OK != err) {
+        goto ADS1115_ALERT_INTR_FAIL;
+    }
+
+    ads1115_handle->alert_pin = alert_pin;
+    ESP_LOGI(TAG, "%s (%d) ads1115 alert interrupt enable ok.", __FUNCTION__, __LINE__);
+    return ESP_OK;
+
+ADS1115_ALERT_INTR_FAIL:
+    ESP_LOGE(TAG, "%s (%d) alert pin config failed.", __FUNCTION__, __LINE__);
+    vQueueDelete(ads1115_handle->alert_queue);
+    ads1115_handle->alert_queue = NULL;
+    return ESP_FAIL;
+}
+
+/**
+  * @brief  ADS1115 Release the ALERT/RDY pin interrupt.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by the interrupt not being enabled.
+  */
+esp_err_t ADS1115_AlertIntrDisable(ADS1115_handle_t ads1115_handle)
+{
+    ADS1115_HANDLE_CHECK(ads1115_handle, ESP_FAIL);
+    if (NULL == ads1115_handle->alert_queue) {
+        ESP_LOGE(TAG, "%s (%d) alert interrupt is not enabled.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    // No worker task, the ISR posts to the queue directly.
+    I2cMaster_IntPinRelease(ads1115_handle->alert_pin, NULL, NULL);
+    vQueueDelete(ads1115_handle->alert_queue);
+    ads1115_handle->alert_queue = NULL;
+    ads1115_handle->alert_pin = -1;
+    return ESP_OK;
+}
+
+/**
+  * @brief  ADS1115 Wait for a comparator alert.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[out] alert_event  alert event.
+  * @param[in]  wait_ticks  maximum ticks to wait.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_ERR_TIMEOUT  no alert within wait_ticks.
+  *         - ESP_FAIL  failed.
+  * @note  The conversion register is read after the alert, which also clears a latched
+  *        ALERT/RDY pin.
+  */
+esp_err_t ADS1115_WaitAlert(ADS1115_handle_t ads1115_handle, ADS1115_AlertEvent_t *alert_event, 
+                            TickType_t wait_ticks)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t data_buf[2] = {0};
+
+    ADS1115_HANDLE_CHECK(ads1115_handle, ESP_FAIL);
+    if (NULL == ads1115_handle->alert_queue || NULL == alert_event) {
+        return ESP_FAIL;
+    }
+
+    if (pdTRUE != xQueueReceive(ads1115_handle->alert_queue, &alert_event->time_us, wait_ticks)) {
+        return ESP_ERR_TIMEOUT;
+    }
+    err = I2cMaster_ReadReg(ads1115_handle->i2c_handle, ads1115_handle->i2c_addr, 
+                            ADS1115_POINTER_CONVERT_REG, data_buf, 2);
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
+    alert_event->conv_data = (int16_t)((data_buf[0] << 8) | data_buf[1]);
+    return ESP_OK;
+}
@@ -25,12 +25,26 @@
 #define __ADS1115_DRIVER_H
 
 #include "driver/i2c.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
 #include "../../i2c_master/include/i2c_master.h"
 #include "ads1115_reg.h"
 
+// ALERT/RDY pin event queue length.
+#define ADS1115_ALERT_QUEUE_LEN     (8)
+
+// ALERT/RDY pin comparator event.
+typedef struct{
+    int64_t time_us;        // esp_timer time when the ALERT pin became active(us).
+    int16_t conv_data;      // Conversion register value read after the alert.
+}ADS1115_AlertEvent_t;
+
 typedef struct{
     I2cMaster_handle_t i2c_handle;
     uint8_t i2c_addr;
+    gpio_num_t alert_pin;           // ALERT/RDY pin, -1 when the interrupt is not enabled.
+    QueueHandle_t alert_queue;      // ALERT/RDY pin event timestamps(int64_t) posted by the ISR.
 }ADS1115_t;
 typedef ADS1115_t *ADS1115_handle_t;
 
@@ -85,4 +99,123 @@ esp_err_t ADS1115_SetPga(ADS1115_handle_t ads1115_handle, ADS1115_RegConfigPga_t
   */
 double ADS1115_GetVoltageOnce(ADS1115_handle_t ads1115_handle);
 
+/**
+  * @brief  ADS1115 Operation mode configuration.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[in]  mode_config  ads1115 operation mode.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The comparator only works while conversions are running, use
+  *        ADS1115_REG_CONFIG_MODE_CONT to monitor the input continuously.
+  */
+esp_err_t ADS1115_SetMode(ADS1115_handle_t ads1115_handle, ADS1115_RegConfigMode_t mode_config);
+
+/**
+  * @brief  ADS1115 Conversion rate configuration.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[in]  dr_config  ads1115 conversion rate.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t ADS1115_SetDataRate(ADS1115_handle_t ads1115_handle, ADS1115_RegConfigDr_t dr_config);
+
+/**
+  * @brief  ADS1115 Comparator configuration.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[in]  compm_config  comparator mode, traditional or window.
+  * @param[in]  compp_config  ALERT/RDY pin polarity.
+  * @param[in]  compl_config  comparator latching.
+  * @param[in]  compq_config  number of successive conversions exceeding the threshold
+  *                           before the ALERT/RDY pin is asserted, or disable the comparator.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  All comparator bits are written in a single register write.
+  */
+esp_err_t ADS1115_ConfigComparator(ADS1115_handle_t ads1115_handle, ADS1115_RegConfigCompm_t compm_config, 
+                                   ADS1115_RegConfigCompp_t compp_config, ADS1115_RegConfigCompl_t compl_config, 
+                                   ADS1115_RegConfigCompq_t compq_config);
+
+/**
+  * @brief  ADS1115 Set comparator thresholds(conversion code).
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[in]  lo_thresh  low threshold, same format as the conversion register.
+  * @param[in]  hi_thresh  high threshold, same format as the conversion register.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by lo_thresh >= hi_thresh.
+  * @note  Also leaves the conversion ready mode of ADS1115_SetConversionReady().
+  */
+esp_err_t ADS1115_SetThreshold(ADS1115_handle_t ads1115_handle, int16_t lo_thresh, int16_t hi_thresh);
+
+/**
+  * @brief  ADS1115 Set comparator thresholds(voltage).
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[in]  lo_vol  low threshold, single: V.
+  * @param[in]  hi_vol  high threshold, single: V.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The voltage is converted with the current range, call ADS1115_SetPga() first.
+  */
+esp_err_t ADS1115_SetThresholdVoltage(ADS1115_handle_t ads1115_handle, double lo_vol, double hi_vol);
+
+/**
+  * @brief  ADS1115 Use the ALERT/RDY pin as a conversion ready signal.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Writes Hi_thresh MSB 1 and Lo_thresh MSB 0, which ADS1115_SetThreshold() rejects. 
+  *        The comparator queue must not be ADS1115_REG_CONFIG_COMPQ_DISABLE, see 
+  *        ADS1115_ConfigComparator(), the pin polarity still applies.
+  * @note  In continuous mode the pin pulses for about 8us after each conversion, in single 
+  *        shot mode it is asserted at the end of the conversion. With ADS1115_AlertIntrEnable() 
+  *        each ADS1115_WaitAlert() returns one conversion without polling the OS bit.
+  * @note  Use ADS1115_SetThreshold() to go back to the comparator.
+  */
+esp_err_t ADS1115_SetConversionReady(ADS1115_handle_t ads1115_handle);
+
+/**
+  * @brief  ADS1115 Route the ALERT/RDY pin to a GPIO interrupt.
+  *         Each time the pin becomes active, the ISR posts an event to the handle queue, 
+  *         use ADS1115_WaitAlert() to receive it.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[in]  alert_pin  gpio connected to the ALERT/RDY pin.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The interrupt edge follows the comparator polarity, call ADS1115_ConfigComparator() first.
+  * @note  alert_pin is set up by I2cMaster_IntPinSetup() on the edge of the comparator polarity.
+  */
+esp_err_t ADS1115_AlertIntrEnable(ADS1115_handle_t ads1115_handle, gpio_num_t alert_pin);
+
+/**
+  * @brief  ADS1115 Release the ALERT/RDY pin interrupt.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by the interrupt not being enabled.
+  */
+esp_err_t ADS1115_AlertIntrDisable(ADS1115_handle_t ads1115_handle);
+
+/**
+  * @brief  ADS1115 Wait for a comparator alert.
+  * @param[in]  ads1115_handle  ads1115 operation handle.
+  * @param[out] alert_event  alert event.
+  * @param[in]  wait_ticks  maximum ticks to wait.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_ERR_TIMEOUT  no alert within wait_ticks.
+  *         - ESP_FAIL  failed.
+  * @note  The conversion register is read after the alert, which also clears a latched
+  *        ALERT/RDY pin.
+  */
+esp_err_t ADS1115_WaitAlert(ADS1115_handle_t ads1115_handle, ADS1115_AlertEvent_t *alert_event, 
+                            TickType_t wait_ticks);
+
 #endif /* __ADS1115_DRIVER_H */
\ No newline at end of file
@@ -24,10 +24,13 @@
 #include "axp192_driver.h"
 #include "axp192_reg.h"
 #include <stdio.h>
+#include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "driver/gpio.h"
 #include "esp_log.h"
 #include "esp_err.h"
+#include "../i2c_master/include/i2c_master_int.h"
 
 static const char *TAG = "AXP192";
 
@@ -36,6 +39,178 @@ static const char *TAG = "AXP192";
         return (ret);                                                            \
         }
 
+/**
+  * @brief  Enable all telemetry ADCs.
+  *         ADC enable register 1: battery voltage/current, ACIN voltage/current, 
+  *         VBUS voltage/current and APS voltage. ADC enable register 2: internal temperature.
+  * @param[in]  axp192_handle  axp192 operation handle.
+  * @retval  reference esp_err_t.
+  */
+static esp_err_t axp192_enable_telemetry_adc(AXP192_handle_t axp192_handle)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t data_buf[2] = {0};
+
+    err = I2cMaster_ReadReg(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
+                            AXP192_ADC_ENABLE_CONTROL_REG_1, data_buf, 2);
+    if (ESP_OK != err) {
+        return err;
+    }
+    if (0xFE == (data_buf[0] & 0xFE) && 0x80 == (data_buf[1] & 0x80)) {
+        return ESP_OK;
+    }
+    data_buf[0] |= 0xFE;
+    data_buf[1] |= 0x80;
+    err = I2cMaster_WriteReg(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
+                             AXP192_ADC_ENABLE_CONTROL_REG_1, &data_buf[0], 1);
+    if (ESP_OK != err) {
+        return err;
+    }
+    err = I2cMaster_WriteReg(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
+                             AXP192_ADC_ENABLE_CONTROL_REG_2, &data_buf[1], 1);
+    if (ESP_OK != err) {
+        return err;
+    }
+    // Wait for the first samples.
+    vTaskDelay(50 / portTICK_PERIOD_MS);
+    return ESP_OK;
+}
+
+/**
+  * @brief  Get 12 bits ADC data(high 8 bits, low 4 bits) from the ADC data block.
+  * @param[in]  adc_block  ADC data block read from AXP192_ADC_BLOCK_START_REG.
+  * @param[in]  reg  high 8 bits register address.
+  * @retval  ADC data.
+  */
+static uint32_t axp192_adc_12bit(const uint8_t *adc_block, uint8_t reg)
+{
+    const uint8_t *p = &adc_block[reg - AXP192_ADC_BLOCK_START_REG];
+    return ((uint32_t)p[0] << 4) | (p[1] & 0x0F);
+}
+
+/**
+  * @brief  Get 13 bits ADC data(high 8 bits, low 5 bits) from the ADC data block.
+  * @param[in]  adc_block  ADC data block read from AXP192_ADC_BLOCK_START_REG.
+  * @param[in]  reg  high 8 bits register address.
+  * @retval  ADC data.
+  */
+static uint32_t axp192_adc_13bit(const uint8_t *adc_block, uint8_t reg)
+{
+    const uint8_t *p = &adc_block[reg - AXP192_ADC_BLOCK_START_REG];
+    return ((uint32_t)p[0] << 5) | (p[1] & 0x1F);
+}
+
+// IRQ status registers, read as one block from AXP192_IRQ_STATUS_REG_1.
+#define AXP192_IRQ_STATUS_BLOCK_LEN     (AXP192_IRQ_STATUS_REG_5 - AXP192_IRQ_STATUS_REG_1 + 1)
+#define AXP192_IRQ_REG_NUM              (5)
+
+// Protects the subscriber table against the IRQ worker task.
+static portMUX_TYPE axp192_irq_spinlock = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+  * @brief  IRQ pin interrupt service, wake the worker task.
+  * @param[in]  arg  axp192 operation handle.
+  */
+static void IRAM_ATTR axp192_irq_isr_handler(void *arg)
+{
+    AXP192_handle_t axp192_handle = (AXP192_handle_t)arg;
+    BaseType_t task_woken = pdFALSE;
+
+    vTaskNotifyGiveFromISR(axp192_handle->irq_task, &task_woken);
+    if (pdTRUE == task_woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+  * @brief  Read all five IRQ status registers in one transfer and clear the pending bits 
+  *         in one transaction, one register per write.
+  * @param[in]  axp192_handle  axp192 operation handle.
+  * @param[out]  status  pending events, AXP192_IRQ_MASK() bits.
+  * @retval  reference esp_err_t.
+  * @note  Only the bits that were read are cleared, an event raised in between stays 
+  *        pending and keeps the IRQ pin low.
+  */
+static esp_err_t axp192_irq_read_clear(AXP192_handle_t axp192_handle, uint64_t *status)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t data_buf[AXP192_IRQ_STATUS_BLOCK_LEN] = {0};
+
+    err = I2cMaster_ReadReg(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
+                            AXP192_IRQ_STATUS_REG_1, data_buf, AXP192_IRQ_STATUS_BLOCK_LEN);
+    if (ESP_OK != err) {
+        return err;
+    }
+    const uint8_t *status_5 = &data_buf[AXP192_IRQ_STATUS_REG_5 - AXP192_IRQ_STATUS_REG_1];
+    *status = (uint64_t)data_buf[0] | (uint64_t)data_buf[1] << 8 | (uint64_t)data_buf[2] << 16 | 
+              (uint64_t)data_buf[3] << 24 | (uint64_t)*status_5 << 32;
+    if (0 == *status) {
+        return ESP_OK;
+    }
+
+    // Write 1 to clear. The AXP192 takes the bytes after the first data byte of a write as 
+    // further register and data pairs, it does not auto-increment, so no register bursts.
+    const uint8_t clear_table[] = {
+        AXP192_IRQ_STATUS_REG_1, 1, data_buf[0],
+        AXP192_IRQ_STATUS_REG_2, 1, data_buf[1],
+        AXP192_IRQ_STATUS_REG_3, 1, data_buf[2],
+        AXP192_IRQ_STATUS_REG_4, 1, data_buf[3],
+        AXP192_IRQ_STATUS_REG_5, 1, *status_5,
+    };
+    return I2cMaster_WriteRegTable(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
+                                   clear_table, sizeof(clear_table));
+}
+
+/**
+  * @brief  IRQ worker task.
+  *         Read and clear the IRQ status, then call the subscribers of each pending event.
+  *         The IRQ pin is level triggered on the AXP192 side, so the status is read again 
+  *         while the pin is still low. A failed transfer or a low pin without pending events 
+  *         is retried after AXP192_IRQ_RETRY_MS, no new falling edge comes before it is cleared.
+  * @param[in]  arg  axp192 operation handle.
+  */
+static void axp192_irq_task(void *arg)
+{
+    AXP192_handle_t axp192_handle = (AXP192_handle_t)arg;
+    AXP192_IrqSubscriber_t subscriber[AXP192_IRQ_SUBSCRIBER_MAX];
+    uint64_t status = 0;
+
+    while (false == axp192_handle->irq_task_exit) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (true == axp192_handle->irq_task_exit) {
+            break;
+        }
+        do {
+            if (ESP_OK != axp192_irq_read_clear(axp192_handle, &status)) {
+                ESP_LOGE(TAG, "%s (%d) read irq status failed.", __FUNCTION__, __LINE__);
+                vTaskDelay(pdMS_TO_TICKS(AXP192_IRQ_RETRY_MS));
+                continue;
+            }
+            if (0 == status) {
+                // Low without a pending event, e.g. another device on the open drain line, do not spin.
+                vTaskDelay(pdMS_TO_TICKS(AXP192_IRQ_RETRY_MS));
+                continue;
+            }
+            taskENTER_CRITICAL(&axp192_irq_spinlock);
+            memcpy(subscriber, axp192_handle->irq_subscriber, sizeof(subscriber));
+            taskEXIT_CRITICAL(&axp192_irq_spinlock);
+            for (uint8_t event = 0; event < AXP192_IRQ_EVENT_MAX; event++) {
+                if (0 == (status & AXP192_IRQ_MASK(event))) {
+                    continue;
+                }
+                for (uint8_t i = 0; i < AXP192_IRQ_SUBSCRIBER_MAX; i++) {
+                    if (NULL != subscriber[i].callback && 
+                        (subscriber[i].event_mask & AXP192_IRQ_MASK(event))) {
+                        subscriber[i].callback((AXP192_IrqEvent_t)event, subscriber[i].arg);
+                    }
+                }
+            }
+        } while (false == axp192_handle->irq_task_exit && 0 == gpio_get_level(axp192_handle->irq_pin));
+    }
+    axp192_handle->irq_task = NULL;
+    vTaskDelete(NULL);
+}
+
 /**
   * @brief  Initialize the AXP192 and obtain an operation handle.
   * @param[in]  i2c_handle  i2c master operation handle.
@@ -44,6 +219,7 @@ static const char *TAG = "AXP192";
   *         successful  axp192 operation handle.
   *         failed      NULL.
   * @note  Use AXP192_Deinit() to release it.
+  * @note  All ADCs used by AXP192_GetTelemetry() are enabled here.
   */
 AXP192_handle_t AXP192_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr)
 {
@@ -67,6 +243,16 @@ AXP192_handle_t AXP192_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr)
     }
     axp192_handle->i2c_handle = i2c_handle;
     axp192_handle->i2c_addr = i2c_addr;
+    axp192_handle->adc_enabled = false;
+    axp192_handle->irq_pin = -1;
+    axp192_handle->irq_task_exit = false;
+    axp192_handle->irq_task = NULL;
+    memset(axp192_handle->irq_subscriber, 0, sizeof(axp192_handle->irq_subscriber));
+    if (ESP_OK == axp192_enable_telemetry_adc(axp192_handle)) {
+        axp192_handle->adc_enabled = true;
+    } else {
+        ESP_LOGE(TAG, "%s (%d) axp192 enable adc failed.", __FUNCTION__, __LINE__);
+    }
     ESP_LOGI(TAG, "%s (%d) axp192 init ok.", __FUNCTION__, __LINE__);
     return axp192_handle;
 }
@@ -82,6 +268,9 @@ esp_err_t AXP192_Deinit(AXP192_handle_t* axp192_handle)
 {
     AXP192_HANDLE_CHECK(*axp192_handle, ESP_FAIL);
 
+    if (NULL != (*axp192_handle)->irq_task) {
+        AXP192_IrqDeinit(*axp192_handle);
+    }
     free(*axp192_handle);
     *axp192_handle = NULL;
     ESP_LOGI(TAG, "%s (%d) axp192 handle deinit ok.", __FUNCTION__, __LINE__);
@@ -209,8 +398,12 @@ float AXP192_GetAcinVal(AXP192_handle_t axp192_handle)
     AXP192_HANDLE_CHECK(axp192_handle, 0);
 
     // If the VCIN voltage ADC is not enabled, enable it first.
-    I2cMaster_ReadRegBit(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
-                         AXP192_ADC_ENABLE_CONTROL_REG_1, 5, &adc_enable, 1);
+    if (false == axp192_handle->adc_enabled) {
+        I2cMaster_ReadRegBit(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
+                             AXP192_ADC_ENABLE_CONTROL_REG_1, 5, &adc_enable, 1);
+    } else {
+        adc_enable = 1;
+    }
     if (!adc_enable) {
         I2cMaster_WriteRegBit(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
                               AXP192_ADC_ENABLE_CONTROL_REG_1, 5, 0x01, 1);
@@ -239,8 +432,12 @@ float AXP192_GetVbusVal(AXP192_handle_t axp192_handle)
     AXP192_HANDLE_CHECK(axp192_handle, 0);
 
     // If VBUS voltage ADC is not enabled, enable first.
-    I2cMaster_ReadRegBit(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
-                         AXP192_ADC_ENABLE_CONTROL_REG_1, 3, &adc_enable, 1);
+    if (false == axp192_handle->adc_enabled) {
+        I2cMaster_ReadRegBit(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
+                             AXP192_ADC_ENABLE_CONTROL_REG_1, 3, &adc_enable, 1);
+    } else {
+        adc_enable = 1;
+    }
     if (!adc_enable) {
         I2cMaster_WriteRegBit(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
                               AXP192_ADC_ENABLE_CONTROL_REG_1, 3, 0x01, 1);
@@ -269,8 +466,12 @@ float AXP192_GetBatteryVal(AXP192_handle_t axp192_handle)
     AXP192_HANDLE_CHECK(axp192_handle, 0);
 
     // If the battery voltage ADC is not enabled, enable it first.
-    I2cMaster_ReadRegBit(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
-                         AXP192_ADC_ENABLE_CONTROL_REG_1, 7, &adc_enable, 1);
+    if (false == axp192_handle->adc_enabled) {
+        I2cMaster_ReadRegBit(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
+                             AXP192_ADC_ENABLE_CONTROL_REG_1, 7, &adc_enable, 1);
+    } else {
+        adc_enable = 1;
+    }
     if (!adc_enable) {
         I2cMaster_WriteRegBit(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
                               AXP192_ADC_ENABLE_CONTROL_REG_1, 7, 0x01, 1);
@@ -295,9 +496,15 @@ float AXP192_GetInternalTemperature(AXP192_handle_t axp192_handle)
     uint8_t data_buf[2] = {0};
     uint8_t adc_enable = 0;
 
+    AXP192_HANDLE_CHECK(axp192_handle, 0);
+
     // If the temperature ADC is not enabled, enable it first.
-    I2cMaster_ReadRegBit(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
-                         AXP192_ADC_ENABLE_CONTROL_REG_2, 7, &adc_enable, 1);
+    if (false == axp192_handle->adc_enabled) {
+        I2cMaster_ReadRegBit(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
+                             AXP192_ADC_ENABLE_CONTROL_REG_2, 7, &adc_enable, 1);
+    } else {
+        adc_enable = 1;
+    }
     if (!adc_enable) {
         I2cMaster_WriteRegBit(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
                               AXP192_ADC_ENABLE_CONTROL_REG_2, 7, 0x01, 1);
@@ -344,3 +551,212 @@ uint8_t AXP192_GetBatteryValPower(AXP192_handle_t axp192_handle)
         return 0;
 }
 
+/**
+  * @brief  AXP192 reads a power telemetry snapshot.
+  *         Voltages, currents, temperature and battery power are read from the ADC 
+  *         data block in a single transfer.
+  * @param[in]  axp192_handle  axp192 operation handle.
+  * @param[out]  telemetry  telemetry snapshot.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t AXP192_GetTelemetry(AXP192_handle_t axp192_handle, AXP192_Telemetry_t *telemetry)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t data_buf[AXP192_ADC_BLOCK_LEN] = {0};
+    uint8_t *p = NULL;
+
+    AXP192_HANDLE_CHECK(axp192_handle, ESP_FAIL);
+    if (NULL == telemetry) {
+        return ESP_FAIL;
+    }
+    if (false == axp192_handle->adc_enabled) {
+        if (ESP_OK != axp192_enable_telemetry_adc(axp192_handle)) {
+            return ESP_FAIL;
+        }
+        axp192_handle->adc_enabled = true;
+    }
+
+    err = I2cMaster_ReadReg(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
+                            AXP192_ADC_BLOCK_START_REG, data_buf, AXP192_ADC_BLOCK_LEN);
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
+
+    telemetry->acin_vol = axp192_adc_12bit(data_buf, AXP192_ACIN_VAL_ADC_REG) * 17 / 10;              // 1.7mV/LSB
+    telemetry->acin_current = axp192_adc_12bit(data_buf, AXP192_ACIN_CURRENT_ADC_REG) * 5 / 8;        // 0.625mA/LSB
+    telemetry->vbus_vol = axp192_adc_12bit(data_buf, AXP192_VBUS_VAL_ADC_REG) * 17 / 10;              // 1.7mV/LSB
+    telemetry->vbus_current = axp192_adc_12bit(data_buf, AXP192_VBUS_CURRENT_ADC_REG) * 3 / 8;        // 0.375mA/LSB
+    telemetry->internal_temperature = 
+        (int16_t)axp192_adc_12bit(data_buf, AXP192_INTERNAL_TEMPERATURE_ADC_REG) - 1447;              // 0.1C/LSB, -144.7C
+    telemetry->battery_vol = axp192_adc_12bit(data_buf, AXP192_BATTERY_VAL_ADC_REG) * 11 / 10;        // 1.1mV/LSB
+    telemetry->battery_charge_current = 
+        axp192_adc_13bit(data_buf, AXP192_BATTERY_CHARGE_CURRENT_ADC_REG) / 2;                         // 0.5mA/LSB
+    telemetry->battery_discharge_current = 
+        axp192_adc_13bit(data_buf, AXP192_BATTERY_DISCHARGE_CURRENT_ADC_REG) / 2;                      // 0.5mA/LSB
+    telemetry->aps_vol = axp192_adc_12bit(data_buf, AXP192_APS_VAL_ADC_REG) * 14 / 10;                // 1.4mV/LSB
+
+    // 24 bits battery power, 1.1mV * 0.5mA = 0.55uW/LSB.
+    p = &data_buf[AXP192_BATTERY_POWER_ADC_REG - AXP192_ADC_BLOCK_START_REG];
+    telemetry->battery_power = (((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2]) * 11 / 20;
+    return ESP_OK;
+}
+
+/**
+  * @brief  AXP192 enable IRQ events and the IRQ pin interrupt.
+  *         The ISR wakes a worker task, which reads and clears the IRQ status registers 
+  *         and calls the subscribers of each pending event.
+  * @param[in]  axp192_handle  axp192 operation handle.
+  * @param[in]  irq_pin  gpio connected to the IRQ pin.
+  * @param[in]  event_mask  events to enable, combination of AXP192_IRQ_MASK().
+  * @param[in]  task_priority  worker task priority.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  All other AXP192 IRQ sources are disabled.
+  * @note  irq_pin is set up by I2cMaster_IntPinSetup(), falling edge with the internal pull-up.
+  */
+esp_err_t AXP192_IrqInit(AXP192_handle_t axp192_handle, gpio_num_t irq_pin, uint64_t event_mask, 
+                         UBaseType_t task_priority)
+{
+    esp_err_t err = ESP_OK;
+    uint64_t status = 0;
+
+    AXP192_HANDLE_CHECK(axp192_handle, ESP_FAIL);
+    if (NULL != axp192_handle->irq_task) {
+        ESP_LOGE(TAG, "%s (%d) irq has been enabled.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    // One register per write, all in one transaction.
+    const uint8_t enable_table[] = {
+        AXP192_IRQ_ENABLE_REG_1, 1, (uint8_t)event_mask,
+        AXP192_IRQ_ENABLE_REG_2, 1, (uint8_t)(event_mask >> 8),
+        AXP192_IRQ_ENABLE_REG_3, 1, (uint8_t)(event_mask >> 16),
+        AXP192_IRQ_ENABLE_REG_4, 1, (uint8_t)(event_mask >> 24),
+        AXP192_IRQ_ENABLE_REG_5, 1, (uint8_t)(event_mask >> 32),
+    };
+    err = I2cMaster_WriteRegTable(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
+                                  enable_table, sizeof(enable_table));
+    if (ESP_OK != err) {
+        ESP_LOGE(TAG, "%s (%d) write irq enable failed.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+    // Clear the events raised before the interrupt was enabled.
+    axp192_irq_read_clear(axp192_handle, &status);
+
+    axp192_handle->irq_pin = irq_pin;
+    axp192_handle->irq_task_exit = false;
+    if (pdPASS != xTaskCreate(axp192_irq_task, "axp192_irq", AXP192_IRQ_TASK_STACK_SIZE, 
+                              axp192_handle, task_priority, &axp192_handle->irq_task)) {
+        ESP_LOGE(TAG, "%s (%d) irq worker task create failed.", __FUNCTION__, __LINE__);
+        axp192_handle->irq_task = NULL;
+        goto AXP192_IRQ_INIT_FAILED;
+    }
+
+    // IRQ is low while any enabled event is pending.
+    err = I2cMaster_IntPinSetup(irq_pin, GPIO_INTR_NEGEDGE, axp192_irq_isr_handler, axp192_handle);
+    if (ESP_OK != err) {
+        goto AXP192_IRQ_INIT_FAILED;
+    }
+    // An event raised before the handler was added left the pin low without an edge.
+    if (0 == gpio_get_level(irq_pin)) {
+        xTaskNotifyGive(axp192_handle->irq_task);
+    }
+
+    ESP_LOGI(TAG, "%s (%d) axp192 irq init ok.", __FUNCTION__, __LINE__);
+    return ESP_OK;
+
+AXP192_IRQ_INIT_FAILED:
+    ESP_LOGE(TAG, "%s (%d) irq init failed.", __FUNCTION__, __LINE__);
+    I2cMaster_IntPinRelease(-1, &axp192_handle->irq_task, &axp192_handle->irq_task_exit);
+    axp192_handle->irq_pin = -1;
+    return ESP_FAIL;
+}
+
+/**
+  * @brief  AXP192 disable the IRQ pin interrupt and stop the worker task.
+  * @param[in]  axp192_handle  axp192 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by the IRQ not being enabled.
+  * @note  The AXP192 IRQ enable registers are left unchanged.
+  */
+esp_err_t AXP192_IrqDeinit(AXP192_handle_t axp192_handle)
+{
+    AXP192_HANDLE_CHECK(axp192_handle, ESP_FAIL);
+    if (NULL == axp192_handle->irq_task) {
+        ESP_LOGE(TAG, "%s (%d) irq is not enabled.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    // Subscriber callbacks in progress complete before the worker exits.
+    I2cMaster_IntPinRelease(axp192_handle->irq_pin, &axp192_handle->irq_task, 
+                            &axp192_handle->irq_task_exit);
+    axp192_handle->irq_pin = -1;
+    return ESP_OK;
+}
+
+/**
+  * @brief  AXP192 subscribe to IRQ events.
+  * @param[in]  axp192_handle  axp192 operation handle.
+  * @param[in]  event_mask  events of interest, combination of AXP192_IRQ_MASK().
+  * @param[in]  callback  event callback.
+  * @param[in]  arg  user argument passed to the callback.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by more than AXP192_IRQ_SUBSCRIBER_MAX subscribers.
+  */
+esp_err_t AXP192_IrqSubscribe(AXP192_handle_t axp192_handle, uint64_t event_mask, 
+                              AXP192_IrqCallback_t callback, void *arg)
+{
+    AXP192_HANDLE_CHECK(axp192_handle, ESP_FAIL);
+    if (NULL == callback) {
+        return ESP_FAIL;
+    }
+
+    // Find and claim the slot under the same lock, two subscribers must not get the same slot.
+    taskENTER_CRITICAL(&axp192_irq_spinlock);
+    for (uint8_t i = 0; i < AXP192_IRQ_SUBSCRIBER_MAX; i++) {
+        if (NULL == axp192_handle->irq_subscriber[i].callback) {
+            axp192_handle->irq_subscriber[i].event_mask = event_mask;
+            axp192_handle->irq_subscriber[i].callback = callback;
+            axp192_handle->irq_subscriber[i].arg = arg;
+            taskEXIT_CRITICAL(&axp192_irq_spinlock);
+            return ESP_OK;
+        }
+    }
+    taskEXIT_CRITICAL(&axp192_irq_spinlock);
+    ESP_LOGE(TAG, "%s (%d) no free irq subscriber.", __FUNCTION__, __LINE__);
+    return ESP_FAIL;
+}
+
+/**
+  * @brief  AXP192 unsubscribe from IRQ events.
+  * @param[in]  axp192_handle  axp192 operation handle.
+  * @param[in]  callback  event callback given when subscribing.
+  * @param[in]  arg  user argument given when subscribing.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by the subscriber not being found.
+  */
+esp_err_t AXP192_IrqUnsubscribe(AXP192_handle_t axp192_handle, AXP192_IrqCallback_t callback, void *arg)
+{
+    AXP192_HANDLE_CHECK(axp192_handle, ESP_FAIL);
+
+    taskENTER_CRITICAL(&axp192_irq_spinlock);
+    for (uint8_t i = 0; i < AXP192_IRQ_SUBSCRIBER_MAX; i++) {
+        if (callback == axp192_handle->irq_subscriber[i].callback && 
+            arg == axp192_handle->irq_subscriber[i].arg) {
+            memset(&axp192_handle->irq_subscriber[i], 0, sizeof(AXP192_IrqSubscriber_t));
+            taskEXIT_CRITICAL(&axp192_irq_spinlock);
+            return ESP_OK;
+        }
+    }
+    taskEXIT_CRITICAL(&axp192_irq_spinlock);
+    return ESP_FAIL;
+}
@@ -0,0 +1,195 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           axp192_fuel_gauge.c
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#include "axp192_fuel_gauge.h"
+#include "axp192_driver.h"
+#include "axp192_reg.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "esp_log.h"
+#include "esp_err.h"
+
+static const char *TAG = "AXP192 fuel gauge";
+
+#define AXP192_FUEL_GAUGE_HANDLE_CHECK(a, ret)  if (NULL == a) {                 \
+        ESP_LOGE(TAG, "%s (%d) driver handle is NULL.", __FUNCTION__, __LINE__); \
+        return (ret);                                                            \
+        }
+
+// Default 3.7V lithium battery OCV curve.
+static const AXP192_OcvPoint_t default_ocv_table[] = {
+    {3400, 0},   {3650, 100}, {3710, 200}, {3730, 300}, {3760, 400}, {3790, 500},
+    {3840, 600}, {3900, 700}, {3970, 800}, {4080, 900}, {4150, 1000},
+};
+
+/**
+  * @brief  Read the coulomb counter net charge.
+  * @param[in]  fuel_gauge_handle  fuel gauge operation handle.
+  * @param[out]  charge  charge minus discharge, unit: uAh.
+  * @retval  reference esp_err_t.
+  */
+static esp_err_t axp192_read_coulomb(AXP192_FuelGauge_handle_t fuel_gauge_handle, int64_t *charge)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t data_buf[8] = {0};
+    uint32_t charge_cnt = 0, discharge_cnt = 0;
+
+    // Charge and discharge counters are read in one transfer.
+    err = I2cMaster_ReadReg(fuel_gauge_handle->axp192_handle->i2c_handle, 
+                            fuel_gauge_handle->axp192_handle->i2c_addr, 
+                            AXP192_COULOMB_CHARGE_REG, data_buf, 8);
+    if (ESP_OK != err) {
+        return err;
+    }
+    charge_cnt = ((uint32_t)data_buf[0] << 24) | ((uint32_t)data_buf[1] << 16) | 
+                 ((uint32_t)data_buf[2] << 8) | data_buf[3];
+    discharge_cnt = ((uint32_t)data_buf[4] << 24) | ((uint32_t)data_buf[5] << 16) | 
+                    ((uint32_t)data_buf[6] << 8) | data_buf[7];
+
+    // mAh = 65536 * 0.5mA * count / 3600 / ADC sample rate.
+    *charge = ((int64_t)charge_cnt - (int64_t)discharge_cnt) * 32768000LL / 
+              (3600LL * fuel_gauge_handle->adc_rate);
+    return ESP_OK;
+}
+
+/**
+  * @brief  Initialize the AXP192 fuel gauge and obtain an operation handle.
+  *         The coulomb counter is enabled and the first estimate is taken from the OCV curve.
+  * @param[in]  axp192_handle  axp192 operation handle.
+  * @param[in]  config  fuel gauge configuration.
+  * @retval  
+  *         successful  fuel gauge operation handle.
+  *         failed      NULL.
+  * @note  Use AXP192_FuelGaugeDeinit() to release it.
+  */
+AXP192_FuelGauge_handle_t AXP192_FuelGaugeInit(AXP192_handle_t axp192_handle, 
+                                               const AXP192_FuelGaugeConfig_t *config)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t data_buf = 0x00;
+    uint16_t soc = 0;
+
+    if (NULL == axp192_handle) {
+        ESP_LOGE(TAG, "%s (%d) axp192 handle is not initialized.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+    if (NULL == config || 0 == config->capacity) {
+        ESP_LOGE(TAG, "%s (%d) fuel gauge config error.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+
+    AXP192_FuelGauge_handle_t fuel_gauge_handle = malloc(sizeof(AXP192_FuelGauge_t));
+    if (NULL == fuel_gauge_handle) {
+        ESP_LOGE(TAG, "%s (%d) driver handle malloc failed.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+    fuel_gauge_handle->axp192_handle = axp192_handle;
+    fuel_gauge_handle->config = *config;
+    if (NULL == config->ocv_table || 0 == config->ocv_table_len) {
+        fuel_gauge_handle->config.ocv_table = default_ocv_table;
+        fuel_gauge_handle->config.ocv_table_len = sizeof(default_ocv_table)/sizeof(default_ocv_table[0]);
+    }
+    fuel_gauge_handle->state.anchor_soc = 0;
+    fuel_gauge_handle->state.anchor_charge = 0;
+    fuel_gauge_handle->state.anchored = false;
+
+    // ADC sample rate bits[7:6]: 25Hz, 50Hz, 100Hz, 200Hz.
+    err = I2cMaster_ReadReg(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
+                            AXP192_ADC_SAMPLE_RATE_REG, &data_buf, 1);
+    if (ESP_OK != err) {
+        goto AXP192_FUEL_GAUGE_INIT_FAILED;
+    }
+    fuel_gauge_handle->adc_rate = 25 << (data_buf >> 6);
+
+    // Enable the coulomb counter.
+    err = I2cMaster_WriteRegBit(axp192_handle->i2c_handle, axp192_handle->i2c_addr, 
+                                AXP192_COULOMB_CONTROL_REG, 7, 0x01, 1);
+    if (ESP_OK != err) {
+        goto AXP192_FUEL_GAUGE_INIT_FAILED;
+    }
+
+    err = AXP192_FuelGaugeUpdate(fuel_gauge_handle, &soc);
+    if (ESP_OK != err) {
+        goto AXP192_FUEL_GAUGE_INIT_FAILED;
+    }
+    ESP_LOGI(TAG, "%s (%d) axp192 fuel gauge init ok.", __FUNCTION__, __LINE__);
+    return fuel_gauge_handle;
+
+AXP192_FUEL_GAUGE_INIT_FAILED:
+    ESP_LOGE(TAG, "%s (%d) axp192 fuel gauge init failed.", __FUNCTION__, __LINE__);
+    free(fuel_gauge_handle);
+    return NULL;
+}
+
+/**
+  * @brief  AXP192 fuel gauge deinitialization.
+  * @param[in]  fuel_gauge_handle  fuel gauge operation handle pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The coulomb counter keeps running.
+  */
+esp_err_t AXP192_FuelGaugeDeinit(AXP192_FuelGauge_handle_t* fuel_gauge_handle)
+{
+    AXP192_FUEL_GAUGE_HANDLE_CHECK(*fuel_gauge_handle, ESP_FAIL);
+
+    free(*fuel_gauge_handle);
+    *fuel_gauge_handle = NULL;
+    ESP_LOGI(TAG, "%s (%d) axp192 fuel gauge handle deinit ok.", __FUNCTION__, __LINE__);
+    return ESP_OK;
+}
+
+/**
+  * @brief  AXP192 fuel gauge update the state of charge estimate.
+  * @param[in]  fuel_gauge_handle  fuel gauge operation handle.
+  * @param[out]  soc  state of charge, unit: 0.1% (0~1000).
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The charge counted since the last rest point is added to the state of charge 
+  *        at that point, so the estimate works under load and while charging. 
+  *        At rest the estimate is pulled toward the load compensated OCV curve.
+  */
+esp_err_t AXP192_FuelGaugeUpdate(AXP192_FuelGauge_handle_t fuel_gauge_handle, uint16_t *soc)
+{
+    AXP192_Telemetry_t telemetry;
+    int64_t charge = 0;
+
+    AXP192_FUEL_GAUGE_HANDLE_CHECK(fuel_gauge_handle, ESP_FAIL);
+    if (NULL == soc) {
+        return ESP_FAIL;
+    }
+
+    if (ESP_OK != AXP192_GetTelemetry(fuel_gauge_handle->axp192_handle, &telemetry)) {
+        return ESP_FAIL;
+    }
+    if (ESP_OK != axp192_read_coulomb(fuel_gauge_handle, &charge)) {
+        return ESP_FAIL;
+    }
+
+    // Current is positive while charging.
+    *soc = AXP192_FuelGaugeStep(&fuel_gauge_handle->config, &fuel_gauge_handle->state, charge, 
+                                telemetry.battery_vol, 
+                                (int32_t)telemetry.battery_charge_current - telemetry.battery_discharge_current);
+    return ESP_OK;
+}
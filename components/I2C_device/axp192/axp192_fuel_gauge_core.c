@@ -0,0 +1,99 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           axp192_fuel_gauge_core.c
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#include "axp192_fuel_gauge_core.h"
+#include <stdlib.h>
+
+/**
+  * @brief  Look up the state of charge of an open circuit voltage.
+  * @param[in]  ocv_table  OCV curve sorted by voltage.
+  * @param[in]  ocv_table_len  number of OCV curve points.
+  * @param[in]  vol  open circuit voltage, unit: mV.
+  * @retval  state of charge, unit: 0.1%, linearly interpolated between the curve points.
+  */
+uint16_t AXP192_FuelGaugeOcvToSoc(const AXP192_OcvPoint_t *ocv_table, uint8_t ocv_table_len, uint16_t vol)
+{
+    uint8_t i = 0;
+
+    if (NULL == ocv_table || 0 == ocv_table_len) {
+        return 0;
+    }
+    if (vol <= ocv_table[0].vol) {
+        return ocv_table[0].soc;
+    }
+    if (vol >= ocv_table[ocv_table_len-1].vol) {
+        return ocv_table[ocv_table_len-1].soc;
+    }
+    for (i = 1; i < ocv_table_len-1; i++) {
+        if (vol < ocv_table[i].vol) {
+            break;
+        }
+    }
+    return ocv_table[i-1].soc + (uint32_t)(vol - ocv_table[i-1].vol) * 
+           (ocv_table[i].soc - ocv_table[i-1].soc) / (ocv_table[i].vol - ocv_table[i-1].vol);
+}
+
+/**
+  * @brief  Update the state of charge estimate with one measurement.
+  * @param[in]  config  fuel gauge configuration, ocv_table must be set.
+  * @param[in,out]  state  estimator state.
+  * @param[in]  charge  coulomb counter net charge, unit: uAh.
+  * @param[in]  vol  battery voltage, unit: mV.
+  * @param[in]  current  battery current, positive while charging, unit: mA.
+  * @retval  state of charge, unit: 0.1% (0~1000).
+  * @note  The charge counted since the last rest point is added to the state of charge 
+  *        at that point, so the estimate works under load and while charging. 
+  *        At rest the estimate is pulled toward the load compensated OCV curve.
+  */
+uint16_t AXP192_FuelGaugeStep(const AXP192_FuelGaugeConfig_t *config, AXP192_FuelGaugeState_t *state, 
+                              int64_t charge, uint16_t vol, int32_t current)
+{
+    int32_t ocv = 0, ocv_soc = 0, coulomb_soc = 0;
+
+    // Remove the internal resistance drop.
+    ocv = vol - current * config->internal_resistance / 1000;
+    ocv = (ocv < 0) ? 0 : ((ocv > 0xFFFF) ? 0xFFFF : ocv);
+    ocv_soc = AXP192_FuelGaugeOcvToSoc(config->ocv_table, config->ocv_table_len, ocv);
+
+    if (false == state->anchored) {
+        state->anchor_soc = ocv_soc;
+        state->anchor_charge = charge;
+        state->anchored = true;
+    }
+    // uAh / mAh gives 0.1%.
+    coulomb_soc = state->anchor_soc + (charge - state->anchor_charge) / config->capacity;
+
+    // At rest the OCV is reliable, move the estimate 1/8 of the way toward it.
+    if (abs(current) <= config->rest_current) {
+        coulomb_soc = (coulomb_soc < 0) ? 0 : ((coulomb_soc > 1000) ? 1000 : coulomb_soc);
+        coulomb_soc = (coulomb_soc * 7 + ocv_soc) / 8;
+        state->anchor_soc = coulomb_soc;
+        state->anchor_charge = charge;
+    } else if (coulomb_soc < 0 || coulomb_soc > 1000) {
+        // Re-anchor at the limit, so counting back starts from empty or full.
+        coulomb_soc = (coulomb_soc < 0) ? 0 : 1000;
+        state->anchor_soc = coulomb_soc;
+        state->anchor_charge = charge;
+    }
+    return coulomb_soc;
+}
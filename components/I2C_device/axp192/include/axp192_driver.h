@@ -25,11 +25,73 @@
 #define __AXP192_DRIVER_H
 
 #include "driver/i2c.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "../../i2c_master/include/i2c_master.h"
 
+#define AXP192_IRQ_SUBSCRIBER_MAX       (4)     // Maximum number of IRQ event subscribers.
+#define AXP192_IRQ_TASK_STACK_SIZE      (2048)  // IRQ worker task stack size.
+#define AXP192_IRQ_RETRY_MS             (10)    // Delay before reading the IRQ status again while the pin stays low(ms).
+
+// IRQ event number, (status register index << 3) | bit.
+#define AXP192_IRQ_EVENT(reg_index, bit)    (((reg_index) << 3) | (bit))
+// IRQ event mask bit of an event.
+#define AXP192_IRQ_MASK(event)              (1ULL << (event))
+
+// IRQ events.
+typedef enum{
+    AXP192_IRQ_ACIN_INSERT          = AXP192_IRQ_EVENT(0, 6),   // ACIN connected.
+    AXP192_IRQ_ACIN_REMOVE          = AXP192_IRQ_EVENT(0, 5),   // ACIN removed.
+    AXP192_IRQ_VBUS_INSERT          = AXP192_IRQ_EVENT(0, 3),   // VBUS connected.
+    AXP192_IRQ_VBUS_REMOVE          = AXP192_IRQ_EVENT(0, 2),   // VBUS removed.
+    AXP192_IRQ_BATTERY_INSERT       = AXP192_IRQ_EVENT(1, 7),   // Battery connected.
+    AXP192_IRQ_BATTERY_REMOVE       = AXP192_IRQ_EVENT(1, 6),   // Battery removed.
+    AXP192_IRQ_CHARGE_START         = AXP192_IRQ_EVENT(1, 3),   // Charging started.
+    AXP192_IRQ_CHARGE_DONE          = AXP192_IRQ_EVENT(1, 2),   // Charging finished.
+    AXP192_IRQ_OVER_TEMPERATURE     = AXP192_IRQ_EVENT(2, 7),   // Internal over temperature.
+    AXP192_IRQ_POWER_KEY_SHORT      = AXP192_IRQ_EVENT(2, 1),   // Power key short press.
+    AXP192_IRQ_POWER_KEY_LONG       = AXP192_IRQ_EVENT(2, 0),   // Power key long press.
+    AXP192_IRQ_LOW_BATTERY          = AXP192_IRQ_EVENT(3, 0),   // APS low voltage warning.
+    AXP192_IRQ_TIMER_TIMEOUT        = AXP192_IRQ_EVENT(4, 7),   // Timer timeout.
+    AXP192_IRQ_EVENT_MAX            = AXP192_IRQ_EVENT(5, 0),
+}AXP192_IrqEvent_t;
+
+/**
+  * @brief  IRQ event callback, called from the IRQ worker task.
+  * @param[in]  event  IRQ event.
+  * @param[in]  arg  user argument given when subscribing.
+  */
+typedef void (*AXP192_IrqCallback_t)(AXP192_IrqEvent_t event, void *arg);
+
+typedef struct{
+    uint64_t event_mask;            // Events of interest, AXP192_IRQ_MASK().
+    AXP192_IrqCallback_t callback;
+    void *arg;
+}AXP192_IrqSubscriber_t;
+
+// Power telemetry snapshot, decoded from one ADC block read.
+typedef struct{
+    uint16_t acin_vol;              // ACIN voltage, unit: mV.
+    uint16_t acin_current;          // ACIN current, unit: mA.
+    uint16_t vbus_vol;              // VBUS voltage, unit: mV.
+    uint16_t vbus_current;          // VBUS current, unit: mA.
+    int16_t internal_temperature;   // Internal temperature, unit: 0.1 degrees Celsius.
+    uint32_t battery_power;         // Battery instantaneous power, unit: uW.
+    uint16_t battery_vol;           // Battery voltage, unit: mV.
+    uint16_t battery_charge_current;    // Battery charge current, unit: mA.
+    uint16_t battery_discharge_current; // Battery discharge current, unit: mA.
+    uint16_t aps_vol;               // APS voltage, unit: mV.
+}AXP192_Telemetry_t;
+
 typedef struct{
     I2cMaster_handle_t i2c_handle;
     uint8_t i2c_addr;
+    bool adc_enabled;               // All telemetry ADCs have been enabled.
+    gpio_num_t irq_pin;             // IRQ pin, -1 when the IRQ is not enabled.
+    volatile bool irq_task_exit;    // Request the IRQ worker task to exit.
+    TaskHandle_t irq_task;          // IRQ worker task.
+    AXP192_IrqSubscriber_t irq_subscriber[AXP192_IRQ_SUBSCRIBER_MAX];
 }AXP192_t;
 typedef AXP192_t *AXP192_handle_t;
 
@@ -41,6 +103,7 @@ typedef AXP192_t *AXP192_handle_t;
   *         successful  axp192 operation handle.
   *         failed      NULL.
   * @note  Use AXP192_Deinit() to release it.
+  * @note  All ADCs used by AXP192_GetTelemetry() are enabled here.
   */
 AXP192_handle_t AXP192_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr);
 
@@ -145,4 +208,70 @@ float AXP192_GetInternalTemperature(AXP192_handle_t axp192_handle);
   */
 uint8_t AXP192_GetBatteryValPower(AXP192_handle_t axp192_handle);
 
+/**
+  * @brief  AXP192 reads a power telemetry snapshot.
+  *         Voltages, currents, temperature and battery power are read from the ADC 
+  *         data block in a single transfer.
+  * @param[in]  axp192_handle  axp192 operation handle.
+  * @param[out]  telemetry  telemetry snapshot.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t AXP192_GetTelemetry(AXP192_handle_t axp192_handle, AXP192_Telemetry_t *telemetry);
+
+/**
+  * @brief  AXP192 enable IRQ events and the IRQ pin interrupt.
+  *         The ISR wakes a worker task, which reads and clears the IRQ status registers 
+  *         and calls the subscribers of each pending event.
+  * @param[in]  axp192_handle  axp192 operation handle.
+  * @param[in]  irq_pin  gpio connected to the IRQ pin.
+  * @param[in]  event_mask  events to enable, combination of AXP192_IRQ_MASK().
+  * @param[in]  task_priority  worker task priority.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  All other AXP192 IRQ sources are disabled.
+  * @note  irq_pin is set up by I2cMaster_IntPinSetup(), falling edge with the internal pull-up.
+  */
+esp_err_t AXP192_IrqInit(AXP192_handle_t axp192_handle, gpio_num_t irq_pin, uint64_t event_mask, 
+                         UBaseType_t task_priority);
+
+/**
+  * @brief  AXP192 disable the IRQ pin interrupt and stop the worker task.
+  * @param[in]  axp192_handle  axp192 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by the IRQ not being enabled.
+  * @note  The AXP192 IRQ enable registers are left unchanged.
+  */
+esp_err_t AXP192_IrqDeinit(AXP192_handle_t axp192_handle);
+
+/**
+  * @brief  AXP192 subscribe to IRQ events.
+  * @param[in]  axp192_handle  axp192 operation handle.
+  * @param[in]  event_mask  events of interest, combination of AXP192_IRQ_MASK().
+  * @param[in]  callback  event callback.
+  * @param[in]  arg  user argument passed to the callback.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by more than AXP192_IRQ_SUBSCRIBER_MAX subscribers.
+  */
+esp_err_t AXP192_IrqSubscribe(AXP192_handle_t axp192_handle, uint64_t event_mask, 
+                              AXP192_IrqCallback_t callback, void *arg);
+
+/**
+  * @brief  AXP192 unsubscribe from IRQ events.
+  * @param[in]  axp192_handle  axp192 operation handle.
+  * @param[in]  callback  event callback given when subscribing.
+  * @param[in]  arg  user argument given when subscribing.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by the subscriber not being found.
+  */
+esp_err_t AXP192_IrqUnsubscribe(AXP192_handle_t axp192_handle, AXP192_IrqCallback_t callback, void *arg);
+
 #endif /* __AXP192_DRIVER_H */
\ No newline at end of file
@@ -0,0 +1,74 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           axp192_fuel_gauge.h
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#ifndef __AXP192_FUEL_GAUGE_H
+#define __AXP192_FUEL_GAUGE_H
+
+#include "axp192_driver.h"
+#include "axp192_fuel_gauge_core.h"
+
+typedef struct{
+    AXP192_handle_t axp192_handle;
+    AXP192_FuelGaugeConfig_t config;
+    uint32_t adc_rate;              // ADC sample rate, unit: Hz.
+    AXP192_FuelGaugeState_t state;
+}AXP192_FuelGauge_t;
+typedef AXP192_FuelGauge_t *AXP192_FuelGauge_handle_t;
+
+/**
+  * @brief  Initialize the AXP192 fuel gauge and obtain an operation handle.
+  *         The coulomb counter is enabled and the first estimate is taken from the OCV curve.
+  * @param[in]  axp192_handle  axp192 operation handle.
+  * @param[in]  config  fuel gauge configuration.
+  * @retval  
+  *         successful  fuel gauge operation handle.
+  *         failed      NULL.
+  * @note  Use AXP192_FuelGaugeDeinit() to release it.
+  */
+AXP192_FuelGauge_handle_t AXP192_FuelGaugeInit(AXP192_handle_t axp192_handle, 
+                                               const AXP192_FuelGaugeConfig_t *config);
+
+/**
+  * @brief  AXP192 fuel gauge deinitialization.
+  * @param[in]  fuel_gauge_handle  fuel gauge operation handle pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The coulomb counter keeps running.
+  */
+esp_err_t AXP192_FuelGaugeDeinit(AXP192_FuelGauge_handle_t* fuel_gauge_handle);
+
+/**
+  * @brief  AXP192 fuel gauge update the state of charge estimate.
+  * @param[in]  fuel_gauge_handle  fuel gauge operation handle.
+  * @param[out]  soc  state of charge, unit: 0.1% (0~1000).
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The charge counted since the last rest point is added to the state of charge 
+  *        at that point, so the estimate works under load and while charging. 
+  *        At rest the estimate is pulled toward the load compensated OCV curve.
+  */
+esp_err_t AXP192_FuelGaugeUpdate(AXP192_FuelGauge_handle_t fuel_gauge_handle, uint16_t *soc);
+
+#endif /* __AXP192_FUEL_GAUGE_H */
@@ -0,0 +1,81 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           axp192_fuel_gauge_core.h
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#ifndef __AXP192_FUEL_GAUGE_CORE_H
+#define __AXP192_FUEL_GAUGE_CORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * State of charge estimate of the AXP192 fuel gauge, plain C so it also runs on a host.
+ * The driver reads the coulomb counter and the battery telemetry and passes them in.
+ */
+
+// Open circuit voltage curve point.
+typedef struct{
+    uint16_t vol;                   // Open circuit voltage, unit: mV.
+    uint16_t soc;                   // State of charge, unit: 0.1%.
+}AXP192_OcvPoint_t;
+
+// Fuel gauge configuration.
+typedef struct{
+    uint16_t capacity;              // Battery capacity, unit: mAh.
+    uint16_t internal_resistance;   // Battery internal resistance, unit: mOhm.
+    uint16_t rest_current;          // Below this current(mA) the battery is at rest and the 
+                                    // estimate is corrected toward the OCV curve.
+    const AXP192_OcvPoint_t *ocv_table;     // OCV curve sorted by voltage, NULL to use the 
+                                            // default 3.7V lithium battery curve.
+    uint8_t ocv_table_len;          // Number of OCV curve points.
+}AXP192_FuelGaugeConfig_t;
+
+// Estimator state, zero it before the first step.
+typedef struct{
+    int32_t anchor_soc;             // State of charge at the anchor point, unit: 0.1%.
+    int64_t anchor_charge;          // Coulomb counter net charge at the anchor point, unit: uAh.
+    bool anchored;
+}AXP192_FuelGaugeState_t;
+
+/**
+  * @brief  Look up the state of charge of an open circuit voltage.
+  * @param[in]  ocv_table  OCV curve sorted by voltage.
+  * @param[in]  ocv_table_len  number of OCV curve points.
+  * @param[in]  vol  open circuit voltage, unit: mV.
+  * @retval  state of charge, unit: 0.1%, linearly interpolated between the curve points.
+  */
+uint16_t AXP192_FuelGaugeOcvToSoc(const AXP192_OcvPoint_t *ocv_table, uint8_t ocv_table_len, uint16_t vol);
+
+/**
+  * @brief  Update the state of charge estimate with one measurement.
+  * @param[in]  config  fuel gauge configuration, ocv_table must be set.
+  * @param[in,out]  state  estimator state.
+  * @param[in]  charge  coulomb counter net charge, unit: uAh.
+  * @param[in]  vol  battery voltage, unit: mV.
+  * @param[in]  current  battery current, positive while charging, unit: mA.
+  * @retval  state of charge, unit: 0.1% (0~1000).
+  * @note  The first step anchors the estimate on the load compensated OCV curve.
+  */
+uint16_t AXP192_FuelGaugeStep(const AXP192_FuelGaugeConfig_t *config, AXP192_FuelGaugeState_t *state, 
+                              int64_t charge, uint16_t vol, int32_t current);
+
+#endif /* __AXP192_FUEL_GAUGE_CORE_H */
@@ -34,15 +34,41 @@
 #define AXP192_BACKUP_CHARGE_CONTROL_REG        (0x35)   // Backup battery charge control register.
 #define AXP192_ADC_ENABLE_CONTROL_REG_1         (0x82)   // ADC enable setting register 1.
 #define AXP192_ADC_ENABLE_CONTROL_REG_2         (0x83)   // ADC enable setting register 2.
+#define AXP192_ADC_SAMPLE_RATE_REG              (0x84)   // ADC sample rate setting register.
 
 // GPIO control class
 
 // Interrupt control class
+#define AXP192_IRQ_ENABLE_REG_1                 (0x40)   // IRQ enable register 1.
+#define AXP192_IRQ_ENABLE_REG_2                 (0x41)   // IRQ enable register 2.
+#define AXP192_IRQ_ENABLE_REG_3                 (0x42)   // IRQ enable register 3.
+#define AXP192_IRQ_ENABLE_REG_4                 (0x43)   // IRQ enable register 4.
+#define AXP192_IRQ_STATUS_REG_1                 (0x44)   // IRQ status register 1, write 1 to clear.
+#define AXP192_IRQ_STATUS_REG_2                 (0x45)   // IRQ status register 2, write 1 to clear.
+#define AXP192_IRQ_STATUS_REG_3                 (0x46)   // IRQ status register 3, write 1 to clear.
+#define AXP192_IRQ_STATUS_REG_4                 (0x47)   // IRQ status register 4, write 1 to clear.
+#define AXP192_IRQ_ENABLE_REG_5                 (0x4A)   // IRQ enable register 5.
+#define AXP192_IRQ_STATUS_REG_5                 (0x4D)   // IRQ status register 5, write 1 to clear.
 
 // ADC data classes
 #define AXP192_ACIN_VAL_ADC_REG                 (0x56)   // ACIN voltage ADC data high 8 bits.
+#define AXP192_ACIN_CURRENT_ADC_REG             (0x58)   // ACIN current ADC data high 8 bits.
 #define AXP192_VBUS_VAL_ADC_REG                 (0x5A)   // VBUS voltage ADC data high 8 bits.
+#define AXP192_VBUS_CURRENT_ADC_REG             (0x5C)   // VBUS current ADC data high 8 bits.
 #define AXP192_INTERNAL_TEMPERATURE_ADC_REG     (0x5E)   // AXP192 internal temperature monitoring ADC data high 8 bits.
+#define AXP192_BATTERY_POWER_ADC_REG            (0x70)   // Battery instantaneous power high 8 bits(24 bits).
 #define AXP192_BATTERY_VAL_ADC_REG              (0x78)   // Battery voltage high 8 bits.
+#define AXP192_BATTERY_CHARGE_CURRENT_ADC_REG   (0x7A)   // Battery charge current high 8 bits.
+#define AXP192_BATTERY_DISCHARGE_CURRENT_ADC_REG (0x7C)  // Battery discharge current high 8 bits.
+#define AXP192_APS_VAL_ADC_REG                  (0x7E)   // APS voltage high 8 bits.
+
+// Coulomb counter class
+#define AXP192_COULOMB_CHARGE_REG               (0xB0)   // Battery charge coulomb counter, 32 bits, high byte first.
+#define AXP192_COULOMB_DISCHARGE_REG            (0xB4)   // Battery discharge coulomb counter, 32 bits, high byte first.
+#define AXP192_COULOMB_CONTROL_REG              (0xB8)   // Coulomb counter control register.
+
+// ADC data block, from ACIN voltage to APS voltage, read with one auto-increment transfer.
+#define AXP192_ADC_BLOCK_START_REG              AXP192_ACIN_VAL_ADC_REG
+#define AXP192_ADC_BLOCK_LEN                    (0x80 - AXP192_ADC_BLOCK_START_REG)
 
 #endif /* __AXP192_REG_H__ */
\ No newline at end of file
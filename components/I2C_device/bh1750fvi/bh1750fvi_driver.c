@@ -25,6 +25,7 @@
 #include <stdio.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "esp_timer.h"
 #include "esp_log.h"
 #include "esp_err.h"
 
@@ -35,6 +36,27 @@ static const char *TAG = "BH1750FVI";
         return (ret);                                                            \
         }
 
+/**
+  * @brief  Send an instruction to bh1750fvi.
+  * @param[in]  bh1750fvi_handle  bh1750fvi operation handle.
+  * @param[in]  instruction  instruction code.
+  * @retval  reference esp_err_t.
+  */
+static esp_err_t bh1750fvi_send_instruction(BH1750FVI_handle_t bh1750fvi_handle, uint8_t instruction)
+{
+    return I2cMaster_WriteData(bh1750fvi_handle->i2c_handle, bh1750fvi_handle->i2c_addr, &instruction, 1);
+}
+
+/**
+  * @brief  Whether the mode is a one time measurement mode.
+  * @param[in]  mode  measurement mode.
+  * @retval  true or false.
+  */
+static bool bh1750fvi_is_one_time_mode(BH1750FVI_Mode_t mode)
+{
+    return (mode & 0x20) ? true : false;
+}
+
 /**
   * @brief  Initialize the bh1750fvi and obtain an operation handle.
   * @param[in]  i2c_handle  i2c master operation handle.
@@ -46,6 +68,7 @@ static const char *TAG = "BH1750FVI";
   *         successful  bh1750fvi operation handle.
   *         failed      NULL.
   * @note  Use BH1750FVI_Deinit() to release it.
+  * @note  The sensor is started in BH1750FVI_MODE_CONTI_H mode.
   */
 BH1750FVI_handle_t BH1750FVI_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr)
 {
@@ -69,7 +92,14 @@ BH1750FVI_handle_t BH1750FVI_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_add
     }
     bh1750fvi_handle->i2c_handle = i2c_handle;
     bh1750fvi_handle->i2c_addr = i2c_addr;
+    bh1750fvi_handle->mtreg = BH1750FVI_MTREG_DEFAULT;
+    bh1750fvi_handle->ready_time = 0;
 
+    if (ESP_OK != BH1750FVI_SetMode(bh1750fvi_handle, BH1750FVI_MODE_CONTI_H)) {
+        ESP_LOGE(TAG, "%s (%d) bh1750fvi start measurement failed.", __FUNCTION__, __LINE__);
+        free(bh1750fvi_handle);
+        return NULL;
+    }
     ESP_LOGI(TAG, "%s (%d) bh1750fvi init ok.", __FUNCTION__, __LINE__);
     return bh1750fvi_handle;
 }
@@ -92,33 +122,190 @@ esp_err_t BH1750FVI_Deinit(BH1750FVI_handle_t* bh1750fvi_handle)
 }
 
 /**
-  * @brief  BH1750FVI Get data once.
+  * @brief  BH1750FVI Set measurement mode.
   * @param[in]  bh1750fvi_handle  bh1750fvi operation handle.
-  * @param[out]  brightness  brightness data, (0-65535), unit: lx
+  * @param[in]  mode  measurement mode.
   * @retval 
   *         - ESP_OK    successful.
   *         - ESP_FAIL  failed.
-  * @note This process requires a small 200ms.
+  * @note  Continuous modes keep the sensor measuring, so reads return immediately. 
+  *        One time modes measure on each read and power down afterwards.
   */
-esp_err_t BH750FVI_GetData(BH1750FVI_handle_t bh1750fvi_handle, float* brightness)
+esp_err_t BH1750FVI_SetMode(BH1750FVI_handle_t bh1750fvi_handle, BH1750FVI_Mode_t mode)
 {
-    uint8_t read_buf[2] = {0};
-    uint8_t send_buf = 0x00;
-    uint32_t dis_data = 0;               
+    esp_err_t err = ESP_OK;
+
+    BH1750FVI_HANDLE_CHECK(bh1750fvi_handle, ESP_FAIL);
+
+    bh1750fvi_handle->mode = mode;
+    // One time modes are started by each read.
+    if (true == bh1750fvi_is_one_time_mode(mode)) {
+        return ESP_OK;
+    }
+    err = bh1750fvi_send_instruction(bh1750fvi_handle, BH1750FVI_POWER_ON);
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
+    err = bh1750fvi_send_instruction(bh1750fvi_handle, mode);
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
+    bh1750fvi_handle->ready_time = esp_timer_get_time() + 
+                                   BH1750FVI_GetMeasurementTimeMs(bh1750fvi_handle)*1000;
+    return ESP_OK;
+}
+
+/**
+  * @brief  BH1750FVI Set measurement time register(sensitivity).
+  * @param[in]  bh1750fvi_handle  bh1750fvi operation handle.
+  * @param[in]  mtreg  measurement time register value(31~254), default 69.
+  *                    A larger value increases sensitivity and measurement time.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  A continuous measurement is restarted, the sensor keeps integrating with 
+  *        the old time until it gets a measurement instruction.
+  */
+esp_err_t BH1750FVI_SetMeasurementTime(BH1750FVI_handle_t bh1750fvi_handle, uint8_t mtreg)
+{
+    esp_err_t err = ESP_OK;
 
     BH1750FVI_HANDLE_CHECK(bh1750fvi_handle, ESP_FAIL);
+    if (mtreg < BH1750FVI_MTREG_MIN || mtreg > BH1750FVI_MTREG_MAX) {
+        ESP_LOGE(TAG, "%s (%d) measurement time register out of range.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    err = bh1750fvi_send_instruction(bh1750fvi_handle, BH1750FVI_MTREG_H | (mtreg >> 5));
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
+    err = bh1750fvi_send_instruction(bh1750fvi_handle, BH1750FVI_MTREG_L | (mtreg & 0x1F));
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
+    bh1750fvi_handle->mtreg = mtreg;
+    // Send the continuous mode instruction again, one time modes send it on each read.
+    return BH1750FVI_SetMode(bh1750fvi_handle, bh1750fvi_handle->mode);
+}
+
+/**
+  * @brief  BH1750FVI Get the maximum measurement time of the current mode.
+  * @param[in]  bh1750fvi_handle  bh1750fvi operation handle.
+  * @retval  measurement time(ms), 0 if the handle is NULL.
+  */
+uint32_t BH1750FVI_GetMeasurementTimeMs(BH1750FVI_handle_t bh1750fvi_handle)
+{
+    uint32_t max_time = 0;
 
-    send_buf = BH1750FVI_POWER_ON;
-    I2cMaster_WriteData(bh1750fvi_handle->i2c_handle, bh1750fvi_handle->i2c_addr, &send_buf, 1);
-    send_buf = BH1750FVI_CONTI_H_MODE;
-    I2cMaster_WriteData(bh1750fvi_handle->i2c_handle, bh1750fvi_handle->i2c_addr, &send_buf, 1);
+    BH1750FVI_HANDLE_CHECK(bh1750fvi_handle, 0);
 
-    vTaskDelay(200 / portTICK_PERIOD_MS);
-    I2cMaster_ReadData(bh1750fvi_handle->i2c_handle, bh1750fvi_handle->i2c_addr, read_buf, 2);
+    // Maximum measurement time at the default measurement time register value.
+    if (BH1750FVI_MODE_CONTI_L == bh1750fvi_handle->mode || 
+        BH1750FVI_MODE_ONE_TIME_L == bh1750fvi_handle->mode) {
+        max_time = 24;
+    } else {
+        max_time = 180;
+    }
+    // Round up.
+    return (max_time*bh1750fvi_handle->mtreg + BH1750FVI_MTREG_DEFAULT - 1) / BH1750FVI_MTREG_DEFAULT;
+}
 
+/**
+  * @brief  BH1750FVI Power down.
+  * @param[in]  bh1750fvi_handle  bh1750fvi operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Use BH1750FVI_SetMode() to start measuring again.
+  */
+esp_err_t BH1750FVI_PowerDown(BH1750FVI_handle_t bh1750fvi_handle)
+{
+    BH1750FVI_HANDLE_CHECK(bh1750fvi_handle, ESP_FAIL);
+
+    return bh1750fvi_send_instruction(bh1750fvi_handle, BH1750FVI_POWER_DOWN);
+}
+
+/**
+  * @brief  BH1750FVI Get illuminance in fixed point.
+  * @param[in]  bh1750fvi_handle  bh1750fvi operation handle.
+  * @param[out]  milli_lux  illuminance, unit: 0.001lx
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  In continuous mode the latest result is read without waiting, except for 
+  *        the first measurement after a mode or measurement time change. In one time 
+  *        mode the measurement time is waited for.
+  */
+esp_err_t BH1750FVI_GetIlluminance(BH1750FVI_handle_t bh1750fvi_handle, uint32_t* milli_lux)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t read_buf[2] = {0};
+    uint32_t dis_data = 0;
+    int64_t wait_time = 0;
+
+    BH1750FVI_HANDLE_CHECK(bh1750fvi_handle, ESP_FAIL);
+    if (NULL == milli_lux) {
+        return ESP_FAIL;
+    }
+
+    if (true == bh1750fvi_is_one_time_mode(bh1750fvi_handle->mode)) {
+        err = bh1750fvi_send_instruction(bh1750fvi_handle, BH1750FVI_POWER_ON);
+        if (ESP_OK != err) {
+            return ESP_FAIL;
+        }
+        err = bh1750fvi_send_instruction(bh1750fvi_handle, bh1750fvi_handle->mode);
+        if (ESP_OK != err) {
+            return ESP_FAIL;
+        }
+        bh1750fvi_handle->ready_time = esp_timer_get_time() + 
+                                       BH1750FVI_GetMeasurementTimeMs(bh1750fvi_handle)*1000;
+    }
+    // Wait until the first result is valid.
+    wait_time = bh1750fvi_handle->ready_time - esp_timer_get_time();
+    if (wait_time > 0) {
+        vTaskDelay((wait_time/1000 + portTICK_PERIOD_MS) / portTICK_PERIOD_MS);
+    }
+
+    err = I2cMaster_ReadData(bh1750fvi_handle->i2c_handle, bh1750fvi_handle->i2c_addr, read_buf, 2);
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
     dis_data = read_buf[0];
     dis_data = (dis_data<<8)+read_buf[1];
-    *brightness = (float)dis_data/1.2;                           // Get the integer part
-    *brightness += (float)((int)(10*dis_data/1.2)%10)/10;        // Get the fractional part
+
+    /* lx = count / 1.2 * (69 / MTreg), and half of it in H2 modes.
+       count * 1000 * 69 / 1.2 = count * 57500, at most 65535 * 57500 < 2^32. */
+    dis_data = dis_data * 57500 / bh1750fvi_handle->mtreg;
+    if (BH1750FVI_MODE_CONTI_H2 == bh1750fvi_handle->mode || 
+        BH1750FVI_MODE_ONE_TIME_H2 == bh1750fvi_handle->mode) {
+        dis_data /= 2;
+    }
+    *milli_lux = dis_data;
     return ESP_OK;
-}
\ No newline at end of file
+}
+
+/**
+  * @brief  BH1750FVI Get data once.
+  * @param[in]  bh1750fvi_handle  bh1750fvi operation handle.
+  * @param[out]  brightness  brightness data, (0-65535), unit: lx
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Same as BH1750FVI_GetIlluminance(), converted to lx.
+  */
+esp_err_t BH750FVI_GetData(BH1750FVI_handle_t bh1750fvi_handle, float* brightness)
+{
+    uint32_t milli_lux = 0;
+
+    BH1750FVI_HANDLE_CHECK(bh1750fvi_handle, ESP_FAIL);
+    if (NULL == brightness) {
+        return ESP_FAIL;
+    }
+
+    if (ESP_OK != BH1750FVI_GetIlluminance(bh1750fvi_handle, &milli_lux)) {
+        return ESP_FAIL;
+    }
+    *brightness = (float)milli_lux / 1000;
+    return ESP_OK;
+}
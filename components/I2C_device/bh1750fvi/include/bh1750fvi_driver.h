@@ -31,10 +31,29 @@
 #define BH1750FVI_POWER_DOWN 			0x00		//bh1750fvi power off
 #define BH1750FVI_RESET 				  0x07		//bh1750fvi reset
 #define BH1750FVI_CONTI_H_MODE 		0x10		//bh1750fvi 11x resolution start measurement
+#define BH1750FVI_MTREG_H 				0x40		//bh1750fvi measurement time register high bits[7:5]
+#define BH1750FVI_MTREG_L 				0x60		//bh1750fvi measurement time register low bits[4:0]
+
+#define BH1750FVI_MTREG_DEFAULT 		(69)		//measurement time register default value
+#define BH1750FVI_MTREG_MIN 			(31)		//measurement time register minimum value
+#define BH1750FVI_MTREG_MAX 			(254)		//measurement time register maximum value
+
+// Measurement mode, the value is the mode instruction.
+typedef enum{
+    BH1750FVI_MODE_CONTI_H      = 0x10,     // Continuous, 1lx resolution, 120ms typical.
+    BH1750FVI_MODE_CONTI_H2     = 0x11,     // Continuous, 0.5lx resolution, 120ms typical.
+    BH1750FVI_MODE_CONTI_L      = 0x13,     // Continuous, 4lx resolution, 16ms typical.
+    BH1750FVI_MODE_ONE_TIME_H   = 0x20,     // One time, 1lx resolution, power down after measurement.
+    BH1750FVI_MODE_ONE_TIME_H2  = 0x21,     // One time, 0.5lx resolution, power down after measurement.
+    BH1750FVI_MODE_ONE_TIME_L   = 0x23,     // One time, 4lx resolution, power down after measurement.
+}BH1750FVI_Mode_t;
 
 typedef struct{
     I2cMaster_handle_t i2c_handle;
     uint8_t i2c_addr;
+    BH1750FVI_Mode_t mode;      // Current measurement mode.
+    uint8_t mtreg;              // Current measurement time register value.
+    int64_t ready_time;         // esp_timer time when the first continuous result is valid(us).
 }BH1750FVI_t;
 typedef BH1750FVI_t *BH1750FVI_handle_t;
 
@@ -49,6 +68,7 @@ typedef BH1750FVI_t *BH1750FVI_handle_t;
   *         successful  bh1750fvi operation handle.
   *         failed      NULL.
   * @note  Use BH1750FVI_Deinit() to release it.
+  * @note  The sensor is started in BH1750FVI_MODE_CONTI_H mode.
   */
 BH1750FVI_handle_t BH1750FVI_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr);
 
@@ -61,6 +81,61 @@ BH1750FVI_handle_t BH1750FVI_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_add
   */
 esp_err_t BH1750FVI_Deinit(BH1750FVI_handle_t* bh1750fvi_handle);
 
+/**
+  * @brief  BH1750FVI Set measurement mode.
+  * @param[in]  bh1750fvi_handle  bh1750fvi operation handle.
+  * @param[in]  mode  measurement mode.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Continuous modes keep the sensor measuring, so reads return immediately. 
+  *        One time modes measure on each read and power down afterwards.
+  */
+esp_err_t BH1750FVI_SetMode(BH1750FVI_handle_t bh1750fvi_handle, BH1750FVI_Mode_t mode);
+
+/**
+  * @brief  BH1750FVI Set measurement time register(sensitivity).
+  * @param[in]  bh1750fvi_handle  bh1750fvi operation handle.
+  * @param[in]  mtreg  measurement time register value(31~254), default 69.
+  *                    A larger value increases sensitivity and measurement time.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  A continuous measurement is restarted, the sensor keeps integrating with 
+  *        the old time until it gets a measurement instruction.
+  */
+esp_err_t BH1750FVI_SetMeasurementTime(BH1750FVI_handle_t bh1750fvi_handle, uint8_t mtreg);
+
+/**
+  * @brief  BH1750FVI Get the maximum measurement time of the current mode.
+  * @param[in]  bh1750fvi_handle  bh1750fvi operation handle.
+  * @retval  measurement time(ms), 0 if the handle is NULL.
+  */
+uint32_t BH1750FVI_GetMeasurementTimeMs(BH1750FVI_handle_t bh1750fvi_handle);
+
+/**
+  * @brief  BH1750FVI Power down.
+  * @param[in]  bh1750fvi_handle  bh1750fvi operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Use BH1750FVI_SetMode() to start measuring again.
+  */
+esp_err_t BH1750FVI_PowerDown(BH1750FVI_handle_t bh1750fvi_handle);
+
+/**
+  * @brief  BH1750FVI Get illuminance in fixed point.
+  * @param[in]  bh1750fvi_handle  bh1750fvi operation handle.
+  * @param[out]  milli_lux  illuminance, unit: 0.001lx
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  In continuous mode the latest result is read without waiting, except for 
+  *        the first measurement after a mode or measurement time change. In one time 
+  *        mode the measurement time is waited for.
+  */
+esp_err_t BH1750FVI_GetIlluminance(BH1750FVI_handle_t bh1750fvi_handle, uint32_t* milli_lux);
+
 /**
   * @brief  BH1750FVI Get data once.
   * @param[in]  bh1750fvi_handle  bh1750fvi operation handle.
@@ -68,7 +143,7 @@ esp_err_t BH1750FVI_Deinit(BH1750FVI_handle_t* bh1750fvi_handle);
   * @retval 
   *         - ESP_OK    successful.
   *         - ESP_FAIL  failed.
-  * @note This process requires a small 200ms.
+  * @note  Same as BH1750FVI_GetIlluminance(), converted to lx.
   */
 esp_err_t BH750FVI_GetData(BH1750FVI_handle_t bh1750fvi_handle, float* brightness);
 
@@ -0,0 +1,93 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           bm8563_codec.c
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#include "bm8563_codec.h"
+
+// Binary(0~99) to BCD lookup table.
+#define BM8563_BIN_TO_BCD_ROW(t)    0x##t##0, 0x##t##1, 0x##t##2, 0x##t##3, 0x##t##4, \
+                                    0x##t##5, 0x##t##6, 0x##t##7, 0x##t##8, 0x##t##9
+static const uint8_t bm8563_bin_to_bcd[100] = {
+    BM8563_BIN_TO_BCD_ROW(0), BM8563_BIN_TO_BCD_ROW(1), BM8563_BIN_TO_BCD_ROW(2), 
+    BM8563_BIN_TO_BCD_ROW(3), BM8563_BIN_TO_BCD_ROW(4), BM8563_BIN_TO_BCD_ROW(5), 
+    BM8563_BIN_TO_BCD_ROW(6), BM8563_BIN_TO_BCD_ROW(7), BM8563_BIN_TO_BCD_ROW(8), 
+    BM8563_BIN_TO_BCD_ROW(9),
+};
+
+// BCD(0x00~0x9F) to binary lookup table, invalid BCD codes decode to 0xFF.
+#define BM8563_BCD_TO_BIN_ROW(t)    (t)*10+0, (t)*10+1, (t)*10+2, (t)*10+3, (t)*10+4, \
+                                    (t)*10+5, (t)*10+6, (t)*10+7, (t)*10+8, (t)*10+9, \
+                                    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+static const uint8_t bm8563_bcd_to_bin[160] = {
+    BM8563_BCD_TO_BIN_ROW(0), BM8563_BCD_TO_BIN_ROW(1), BM8563_BCD_TO_BIN_ROW(2), 
+    BM8563_BCD_TO_BIN_ROW(3), BM8563_BCD_TO_BIN_ROW(4), BM8563_BCD_TO_BIN_ROW(5), 
+    BM8563_BCD_TO_BIN_ROW(6), BM8563_BCD_TO_BIN_ROW(7), BM8563_BCD_TO_BIN_ROW(8), 
+    BM8563_BCD_TO_BIN_ROW(9),
+};
+
+/**
+  * @brief  Convert HEX format to BCD format.
+  * @param[in]  hex_data  HEX format data.
+  * @retval  BCD format data.
+  * @note   Note that the input data range is 0-99, the maximum range of this two-byte BCD code.
+  */
+uint8_t BM8563_HexToBcd(uint8_t hex_data)
+{
+    return (hex_data < sizeof(bm8563_bin_to_bcd)) ? bm8563_bin_to_bcd[hex_data] : 0x00;
+}
+
+/**
+  * @brief  Convert BCD format to HEX format.
+  * @param[in]  bcd_data  BCD format data.
+  * @retval  HEX format data, 0xFF for an invalid BCD code.
+  */
+uint8_t BM8563_BcdToHex(uint8_t bcd_data)
+{
+    return (bcd_data < sizeof(bm8563_bcd_to_bin)) ? bm8563_bcd_to_bin[bcd_data] : 0xFF;
+}
+
+/**
+  * @brief  Encode an alarm into the four alarm register values.
+  * @param[in]  alarm  alarm, at least one field must not be BM8563_ALARM_ANY.
+  * @param[out]  reg_buf  values of BM8563_ALARM_MIN_REG ~ BM8563_ALARM_WEEK_REG.
+  * @retval  0: successful, -1: a field is out of range or no field takes part in the match.
+  */
+int BM8563_AlarmEncode(const BM8563_Alarm_t *alarm, uint8_t reg_buf[4])
+{
+    const uint8_t field[4] = {alarm->min, alarm->hour, alarm->day, alarm->week};
+    const uint8_t field_min[4] = {0, 0, 1, 0};
+    const uint8_t field_max[4] = {59, 23, 31, 6};
+    uint8_t enabled = 0;
+
+    for (uint32_t i=0; i<4; i++) {
+        if (BM8563_ALARM_ANY == field[i]) {
+            reg_buf[i] = BM8563_ALARM_AE_BIT;
+            continue;
+        }
+        if (field[i] < field_min[i] || field[i] > field_max[i]) {
+            return -1;
+        }
+        reg_buf[i] = BM8563_HexToBcd(field[i]);
+        enabled++;
+    }
+    return (0 == enabled) ? -1 : 0;
+}
@@ -23,10 +23,13 @@
 
 #include "bm8563_driver.h"
 #include <stdio.h>
+#include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
 #include "esp_err.h"
+#include "esp_sleep.h"
+#include "driver/rtc_io.h"
 #include "../i2c_master/include/i2c_master.h"
 
 static const char *TAG = "BM8563";
@@ -69,7 +72,13 @@ BM8563_handle_t BM8563_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr)
         ESP_LOGE(TAG, "%s (%d) driver handle malloc failed.", __FUNCTION__, __LINE__);
         return NULL;
     }
-    // Reset to normal mode.
+    // Latch the alarm/timer flags before they are cleared, they tell the wake cause.
+    err = I2cMaster_ReadReg(i2c_handle, i2c_addr, BM8563_CONTROL_STATE_2_REG, &cmd_buf, 1);
+    if (err != ESP_OK) {
+        goto BM8563_INIT_FAILED;
+    }
+    bm8563_handle->boot_flags = cmd_buf & (BM8563_CONTROL_2_AF_BIT | BM8563_CONTROL_2_TF_BIT);
+    // Reset to normal mode, clear the flags and the interrupt enables.
     cmd_buf = 0x00;
     err = I2cMaster_WriteReg(i2c_handle, i2c_addr, BM8563_CONTROL_STATE_1_REG, &cmd_buf, 1);
     if (err != ESP_OK) {
@@ -108,19 +117,21 @@ esp_err_t BM8563_Deinit(BM8563_handle_t* bm8563_handle)
 }
 
 /**
-  * @brief  Convert HEX format to BCD format.
-  * @param[in]  hex_data  HEX format data.
-  * @retval  BCD format data.
-  * @note   Note that the input data range is 0-99, the maximum range of this two-byte BCD code.
-  */
-static uint8_t BM8563_HexToBcd(uint8_t hex_data){return hex_data/10*16 + hex_data%10;}
-
-/**
-  * @brief  Convert BCD format to HEX format.
-  * @param[in]  bcd_data  BCD format data.
-  * @retval  HEX format data.
+  * @brief  Days since 1970-01-01 of a civil date(proleptic Gregorian calendar).
+  * @param[in]  year  full year.
+  * @param[in]  month  1~12
+  * @param[in]  day  1~31
+  * @retval  days since 1970-01-01.
   */
-static uint8_t BM8563_BcdToHex(uint8_t bcd_data){return bcd_data/16*10 + bcd_data%16;}
+static int32_t bm8563_days_from_civil(int32_t year, uint32_t month, uint32_t day)
+{
+    year -= (month <= 2);
+    const int32_t era = (year >= 0 ? year : year - 399) / 400;
+    const uint32_t yoe = (uint32_t)(year - era * 400);
+    const uint32_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int32_t)doe - 719468;
+}
 
 /**
   * @brief  BM8563 set time.
@@ -184,7 +195,6 @@ esp_err_t BM8563_GetTime(BM8563_handle_t bm8563_handle, BM8563_Time_t* time)
 {
     esp_err_t err = ESP_OK;
     uint8_t data_buf[7] = {0};
-    uint8_t *p = (uint8_t*)time;
 
     BM8563_HANDLE_CHECK(bm8563_handle, ESP_FAIL);
     if (NULL == time) {
@@ -192,17 +202,13 @@ esp_err_t BM8563_GetTime(BM8563_handle_t bm8563_handle, BM8563_Time_t* time)
     }
 
     // Read raw time data.
-    err = I2cMaster_WriteReg(bm8563_handle->i2c_handle, bm8563_handle->i2c_addr, 
-                             BM8563_TIME_SEC_REG, data_buf, 7);
+    err = I2cMaster_ReadReg(bm8563_handle->i2c_handle, bm8563_handle->i2c_addr, 
+                            BM8563_TIME_SEC_REG, data_buf, 7);
     if (ESP_OK != err) {
         return ESP_FAIL;
     }
-    // Convert time data from bcd format to hex format.
-    for (uint32_t i=0; i<7; i++) {
-        p[i] = BM8563_BcdToHex(data_buf[i]);
-    }
         
-    // Mask unwanted bits.
+    // Mask unwanted bits and convert time data from bcd format to hex format.
     time->sec = BM8563_BcdToHex(data_buf[0] & 0x7f);
     time->min = BM8563_BcdToHex(data_buf[1] & 0x7f);
     time->hour = BM8563_BcdToHex(data_buf[2] & 0x3f);
@@ -210,5 +216,326 @@ esp_err_t BM8563_GetTime(BM8563_handle_t bm8563_handle, BM8563_Time_t* time)
     time->week = BM8563_BcdToHex(data_buf[4] & 0x07);
     time->month = BM8563_BcdToHex(data_buf[5] & 0x1f);
     time->year = BM8563_BcdToHex(data_buf[6] & 0xff);
+    if (data_buf[0] & BM8563_TIME_VL_BIT) {
+        ESP_LOGW(TAG, "%s (%d) clock integrity is not guaranteed.", __FUNCTION__, __LINE__);
+        return ESP_ERR_INVALID_STATE;
+    }
+    return ESP_OK;
+}
+
+/**
+  * @brief  Convert BM8563 time to struct tm.
+  * @param[in]  time  BM8563 time struct pointer.
+  * @param[out]  tm  struct tm pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_TimeToTm(const BM8563_Time_t *time, struct tm *tm)
+{
+    if (NULL == time || NULL == tm) {
+        return ESP_FAIL;
+    }
+
+    memset(tm, 0, sizeof(struct tm));
+    tm->tm_sec = time->sec;
+    tm->tm_min = time->min;
+    tm->tm_hour = time->hour;
+    tm->tm_mday = time->day;
+    tm->tm_wday = time->week;
+    tm->tm_mon = time->month - 1;
+    tm->tm_year = BM8563_YEAR_BASE - 1900 + time->year;
+    tm->tm_yday = bm8563_days_from_civil(BM8563_YEAR_BASE + time->year, time->month, time->day) - 
+                  bm8563_days_from_civil(BM8563_YEAR_BASE + time->year, 1, 1);
+    return ESP_OK;
+}
+
+/**
+  * @brief  Convert struct tm to BM8563 time.
+  * @param[in]  tm  struct tm pointer, only the years 2000~2099 are supported.
+  * @param[out]  time  BM8563 time struct pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The week is calculated from the date, tm_wday is ignored.
+  */
+esp_err_t BM8563_TmToTime(const struct tm *tm, BM8563_Time_t *time)
+{
+    int32_t year = 0;
+
+    if (NULL == time || NULL == tm) {
+        return ESP_FAIL;
+    }
+    year = tm->tm_year + 1900 - BM8563_YEAR_BASE;
+    if (year < 0 || year > 99 || tm->tm_mon < 0 || tm->tm_mon > 11 || 
+        tm->tm_mday < 1 || tm->tm_mday > 31 || tm->tm_hour < 0 || tm->tm_hour > 23 || 
+        tm->tm_min < 0 || tm->tm_min > 59 || tm->tm_sec < 0 || tm->tm_sec > 59) {
+        return ESP_FAIL;
+    }
+
+    time->sec = tm->tm_sec;
+    time->min = tm->tm_min;
+    time->hour = tm->tm_hour;
+    time->day = tm->tm_mday;
+    time->month = tm->tm_mon + 1;
+    time->year = year;
+    // 1970-01-01 is a Thursday.
+    time->week = (bm8563_days_from_civil(BM8563_YEAR_BASE + year, time->month, time->day) + 4) % 7;
+    return ESP_OK;
+}
+
+/**
+  * @brief  Convert BM8563 time to time_t, the BM8563 is kept in UTC.
+  * @param[in]  time  BM8563 time struct pointer.
+  * @retval  seconds since 1970-01-01 00:00:00 UTC.
+  */
+time_t BM8563_TimeToUnix(const BM8563_Time_t *time)
+{
+    int64_t days = bm8563_days_from_civil(BM8563_YEAR_BASE + time->year, time->month, time->day);
+    return (time_t)(days * 86400 + time->hour * 3600 + time->min * 60 + time->sec);
+}
+
+/**
+  * @brief  Convert time_t to BM8563 time, the BM8563 is kept in UTC.
+  * @param[in]  unix_time  seconds since 1970-01-01 00:00:00 UTC, only the years 2000~2099 are supported.
+  * @param[out]  time  BM8563 time struct pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_UnixToTime(time_t unix_time, BM8563_Time_t *time)
+{
+    struct tm tm;
+
+    if (NULL == gmtime_r(&unix_time, &tm)) {
+        return ESP_FAIL;
+    }
+    return BM8563_TmToTime(&tm, time);
+}
+
+/**
+  * @brief  Update Control/Status Register 2.
+  *         The flags are written as 1 unless they are in clear_flags, writing 1 keeps 
+  *         them, so a flag raised during the read-modify-write is not lost.
+  * @param[in]  bm8563_handle  bm8563 operation handle.
+  * @param[in]  set_enable  interrupt enable bits to set.
+  * @param[in]  clear_enable  interrupt enable bits to clear.
+  * @param[in]  clear_flags  flag bits to clear.
+  * @retval  reference esp_err_t.
+  */
+static esp_err_t bm8563_update_control_2(BM8563_handle_t bm8563_handle, uint8_t set_enable, 
+                                         uint8_t clear_enable, uint8_t clear_flags)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t data = 0;
+
+    err = I2cMaster_ReadReg(bm8563_handle->i2c_handle, bm8563_handle->i2c_addr, 
+                            BM8563_CONTROL_STATE_2_REG, &data, 1);
+    if (ESP_OK != err) {
+        return err;
+    }
+    data = (data & (BM8563_CONTROL_2_TIE_BIT | BM8563_CONTROL_2_AIE_BIT) & ~clear_enable) | set_enable;
+    data |= (BM8563_CONTROL_2_AF_BIT | BM8563_CONTROL_2_TF_BIT) & ~clear_flags;
+    return I2cMaster_WriteReg(bm8563_handle->i2c_handle, bm8563_handle->i2c_addr, 
+                              BM8563_CONTROL_STATE_2_REG, &data, 1);
+}
+
+/**
+  * @brief  BM8563 set the alarm and enable the alarm interrupt.
+  * @param[in]  bm8563_handle  bm8563 operation handle.
+  * @param[in]  alarm  alarm, at least one field must not be BM8563_ALARM_ANY.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_SetAlarm(BM8563_handle_t bm8563_handle, const BM8563_Alarm_t *alarm)
+{
+    uint8_t data_buf[4] = {0};
+
+    BM8563_HANDLE_CHECK(bm8563_handle, ESP_FAIL);
+    if (NULL == alarm || 0 != BM8563_AlarmEncode(alarm, data_buf)) {
+        ESP_LOGE(TAG, "%s (%d) Alarm format error.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    if (ESP_OK != I2cMaster_WriteReg(bm8563_handle->i2c_handle, bm8563_handle->i2c_addr, 
+                                     BM8563_ALARM_MIN_REG, data_buf, 4)) {
+        return ESP_FAIL;
+    }
+    if (ESP_OK != bm8563_update_control_2(bm8563_handle, BM8563_CONTROL_2_AIE_BIT, 0, 
+                                          BM8563_CONTROL_2_AF_BIT)) {
+        return ESP_FAIL;
+    }
     return ESP_OK;
-}
\ No newline at end of file
+}
+
+/**
+  * @brief  BM8563 disable the alarm interrupt and clear the alarm flag.
+  * @param[in]  bm8563_handle  bm8563 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_DisableAlarm(BM8563_handle_t bm8563_handle)
+{
+    BM8563_HANDLE_CHECK(bm8563_handle, ESP_FAIL);
+
+    if (ESP_OK != bm8563_update_control_2(bm8563_handle, 0, BM8563_CONTROL_2_AIE_BIT, 
+                                          BM8563_CONTROL_2_AF_BIT)) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/**
+  * @brief  BM8563 start the countdown timer and enable the timer interrupt.
+  * @param[in]  bm8563_handle  bm8563 operation handle.
+  * @param[in]  seconds  1~BM8563_TIMER_MAX_S, above 255 it is rounded up to whole minutes.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_SetTimer(BM8563_handle_t bm8563_handle, uint32_t seconds)
+{
+    uint8_t timer_control = 0;
+    uint8_t count = 0;
+
+    BM8563_HANDLE_CHECK(bm8563_handle, ESP_FAIL);
+    if (0 == seconds || seconds > BM8563_TIMER_MAX_S) {
+        ESP_LOGE(TAG, "%s (%d) Timer period out of range.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+    if (seconds <= 255) {
+        timer_control = BM8563_TIMER_TE_BIT | BM8563_TIMER_SOURCE_1HZ;
+        count = seconds;
+    } else {
+        timer_control = BM8563_TIMER_TE_BIT | BM8563_TIMER_SOURCE_1_60HZ;
+        count = (seconds + 59) / 60;
+    }
+
+    // Load the countdown value before the timer is enabled, in one transaction.
+    const uint8_t timer_table[] = {
+        BM8563_TIMER_COUNT_DOWN_REG, 1, count,
+        BM8563_TIMER_CONTROL_REG, 1, timer_control,
+    };
+    if (ESP_OK != I2cMaster_WriteRegTable(bm8563_handle->i2c_handle, bm8563_handle->i2c_addr, 
+                                          timer_table, sizeof(timer_table))) {
+        return ESP_FAIL;
+    }
+    if (ESP_OK != bm8563_update_control_2(bm8563_handle, BM8563_CONTROL_2_TIE_BIT, 0, 
+                                          BM8563_CONTROL_2_TF_BIT)) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/**
+  * @brief  BM8563 stop the countdown timer, disable the timer interrupt and clear the timer flag.
+  * @param[in]  bm8563_handle  bm8563 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_DisableTimer(BM8563_handle_t bm8563_handle)
+{
+    uint8_t timer_control = BM8563_TIMER_SOURCE_1_60HZ;     // Lowest power source, disabled.
+
+    BM8563_HANDLE_CHECK(bm8563_handle, ESP_FAIL);
+
+    if (ESP_OK != I2cMaster_WriteReg(bm8563_handle->i2c_handle, bm8563_handle->i2c_addr, 
+                                     BM8563_TIMER_CONTROL_REG, &timer_control, 1)) {
+        return ESP_FAIL;
+    }
+    if (ESP_OK != bm8563_update_control_2(bm8563_handle, 0, BM8563_CONTROL_2_TIE_BIT, 
+                                          BM8563_CONTROL_2_TF_BIT)) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/**
+  * @brief  BM8563 schedule the next wakeup and enable the ESP32 deep sleep wakeup from the INT pin.
+  *         Up to BM8563_TIMER_MAX_S the countdown timer is used, longer delays use the alarm 
+  *         and are rounded up to whole minutes.
+  * @param[in]  bm8563_handle  bm8563 operation handle.
+  * @param[in]  seconds  wakeup delay, 1~BM8563_WAKEUP_MAX_S.
+  * @param[in]  int_pin  RTC gpio connected to the BM8563 INT pin.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Call esp_deep_sleep_start() afterwards.
+  */
+esp_err_t BM8563_SetWakeup(BM8563_handle_t bm8563_handle, uint32_t seconds, gpio_num_t int_pin)
+{
+    esp_err_t err = ESP_OK;
+    BM8563_Time_t time;
+    BM8563_Alarm_t alarm;
+    time_t wake_time = 0;
+
+    BM8563_HANDLE_CHECK(bm8563_handle, ESP_FAIL);
+    if (0 == seconds || seconds > BM8563_WAKEUP_MAX_S) {
+        ESP_LOGE(TAG, "%s (%d) Wakeup delay out of range.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+    if (false == rtc_gpio_is_valid_gpio(int_pin)) {
+        ESP_LOGE(TAG, "%s (%d) INT pin is not an RTC gpio.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    if (seconds <= BM8563_TIMER_MAX_S) {
+        BM8563_DisableAlarm(bm8563_handle);
+        err = BM8563_SetTimer(bm8563_handle, seconds);
+    } else {
+        BM8563_DisableTimer(bm8563_handle);
+        err = BM8563_GetTime(bm8563_handle, &time);
+        if (ESP_OK != err) {
+            return ESP_FAIL;
+        }
+        // Round up, the alarm has minute resolution.
+        wake_time = (BM8563_TimeToUnix(&time) + seconds + 59) / 60 * 60;
+        if (ESP_OK != BM8563_UnixToTime(wake_time, &time)) {
+            return ESP_FAIL;
+        }
+        alarm.min = time.min;
+        alarm.hour = time.hour;
+        alarm.day = time.day;
+        alarm.week = BM8563_ALARM_ANY;
+        err = BM8563_SetAlarm(bm8563_handle, &alarm);
+    }
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
+
+    // The INT pin is open drain, active low. GPIO34~39 have no pull-up and need an external one.
+    rtc_gpio_pullup_en(int_pin);
+    rtc_gpio_pulldown_dis(int_pin);
+    if (ESP_OK != esp_sleep_enable_ext0_wakeup(int_pin, 0)) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/**
+  * @brief  BM8563 get the wake cause.
+  * @param[in]  bm8563_handle  bm8563 operation handle.
+  * @retval  BM8563_WAKE_NONE, or BM8563_WAKE_ALARM and/or BM8563_WAKE_TIMER.
+  * @note  Uses the flags latched by BM8563_Init(), no I2C transfer.
+  */
+uint8_t BM8563_GetWakeCause(BM8563_handle_t bm8563_handle)
+{
+    uint8_t cause = BM8563_WAKE_NONE;
+    esp_sleep_wakeup_cause_t wakeup_cause = esp_sleep_get_wakeup_cause();
+
+    BM8563_HANDLE_CHECK(bm8563_handle, BM8563_WAKE_NONE);
+    if (ESP_SLEEP_WAKEUP_EXT0 != wakeup_cause && ESP_SLEEP_WAKEUP_EXT1 != wakeup_cause) {
+        return BM8563_WAKE_NONE;
+    }
+
+    if (bm8563_handle->boot_flags & BM8563_CONTROL_2_AF_BIT) {
+        cause |= BM8563_WAKE_ALARM;
+    }
+    if (bm8563_handle->boot_flags & BM8563_CONTROL_2_TF_BIT) {
+        cause |= BM8563_WAKE_TIMER;
+    }
+    return cause;
+}
@@ -0,0 +1,385 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           bm8563_time_service.c
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#include "bm8563_time_service.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "esp_err.h"
+
+static const char *TAG = "BM8563_TIME";
+
+#define BM8563_TIME_SERVICE_HANDLE_CHECK(a, ret)  if (NULL == a) {               \
+        ESP_LOGE(TAG, "%s (%d) driver handle is NULL.", __FUNCTION__, __LINE__); \
+        return (ret);                                                            \
+        }
+
+#define BM8563_TIME_SERVICE_EDGE_TIMEOUT_US     (1200000)   // Longest wait for a second edge.
+#define BM8563_TIME_SERVICE_DRIFT_MAX_PPB       (1000000)   // Larger measurements are rejected.
+
+/**
+  * @brief  Read the RTC until the seconds change and time stamp that edge.
+  *         The edge lies between two consecutive reads, its time is taken as the 
+  *         middle of both read midpoints, the error is about half a tick.
+  * @param[in]  time_service_handle  time service operation handle.
+  * @param[out]  rtc_time  RTC time right after the edge.
+  * @param[out]  edge_us  esp_timer time of the edge.
+  * @param[out]  rtc_valid  RTC clock integrity is guaranteed.
+  * @retval  reference esp_err_t.
+  */
+static esp_err_t bm8563_ts_capture_edge(BM8563_TimeService_handle_t time_service_handle, 
+                                        time_t *rtc_time, int64_t *edge_us, bool *rtc_valid)
+{
+    esp_err_t err = ESP_OK;
+    BM8563_Time_t time;
+    uint8_t first_sec = 0;
+    int64_t start_us = 0, before_us = 0, prev_mid_us = 0, mid_us = 0;
+
+    start_us = esp_timer_get_time();
+    err = BM8563_GetTime(time_service_handle->bm8563_handle, &time);
+    if (ESP_OK != err && ESP_ERR_INVALID_STATE != err) {
+        return ESP_FAIL;
+    }
+    prev_mid_us = (start_us + esp_timer_get_time()) / 2;
+    first_sec = time.sec;
+
+    while (prev_mid_us - start_us < BM8563_TIME_SERVICE_EDGE_TIMEOUT_US) {
+        vTaskDelay(1);
+        before_us = esp_timer_get_time();
+        err = BM8563_GetTime(time_service_handle->bm8563_handle, &time);
+        if (ESP_OK != err && ESP_ERR_INVALID_STATE != err) {
+            return ESP_FAIL;
+        }
+        mid_us = (before_us + esp_timer_get_time()) / 2;
+        if (time.sec != first_sec) {
+            *rtc_time = BM8563_TimeToUnix(&time);
+            *edge_us = (prev_mid_us + mid_us) / 2;
+            *rtc_valid = (ESP_OK == err);
+            return ESP_OK;
+        }
+        prev_mid_us = mid_us;
+    }
+    ESP_LOGE(TAG, "%s (%d) rtc is not running.", __FUNCTION__, __LINE__);
+    return ESP_FAIL;
+}
+
+/**
+  * @brief  Current time from esp_timer, corrected by the measured drift.
+  * @param[in]  time_service_handle  time service operation handle.
+  * @retval  microseconds since 1970-01-01 00:00:00 UTC.
+  */
+static int64_t bm8563_ts_now_us(BM8563_TimeService_handle_t time_service_handle)
+{
+    int64_t now_us = esp_timer_get_time();
+
+    taskENTER_CRITICAL(&time_service_handle->lock);
+    int64_t anchor_rtc = time_service_handle->anchor_rtc;
+    int64_t elapsed_us = now_us - time_service_handle->anchor_us;
+    int32_t drift_ppb = time_service_handle->drift_ppb;
+    taskEXIT_CRITICAL(&time_service_handle->lock);
+
+    elapsed_us -= elapsed_us * drift_ppb / 1000000000;
+    return anchor_rtc * 1000000 + elapsed_us;
+}
+
+/**
+  * @brief  Set or slew the system time toward the time service time.
+  * @param[in]  time_service_handle  time service operation handle.
+  * @param[in]  force_step  always set the system time.
+  */
+static void bm8563_ts_discipline_system_time(BM8563_TimeService_handle_t time_service_handle, 
+                                             bool force_step)
+{
+    struct timeval tv;
+    int64_t now_us = 0, offset_us = 0;
+
+    now_us = bm8563_ts_now_us(time_service_handle);
+    gettimeofday(&tv, NULL);
+    offset_us = now_us - ((int64_t)tv.tv_sec * 1000000 + tv.tv_usec);
+    if (true == force_step || llabs(offset_us) > BM8563_TIME_SERVICE_STEP_US) {
+        tv.tv_sec = now_us / 1000000;
+        tv.tv_usec = now_us % 1000000;
+        settimeofday(&tv, NULL);
+        ESP_LOGI(TAG, "%s (%d) system time set, offset %lld us.", __FUNCTION__, __LINE__, 
+                 (long long)offset_us);
+    } else {
+        tv.tv_sec = offset_us / 1000000;
+        tv.tv_usec = offset_us % 1000000;
+        adjtime(&tv, NULL);
+    }
+}
+
+/**
+  * @brief  Read the RTC, update the drift estimate and re-anchor the time service.
+  * @param[in]  time_service_handle  time service operation handle.
+  * @param[in]  restart  drop the previous anchor, the RTC time was changed.
+  * @retval  reference esp_err_t.
+  */
+static esp_err_t bm8563_ts_sync(BM8563_TimeService_handle_t time_service_handle, bool restart)
+{
+    time_t rtc_time = 0;
+    int64_t edge_us = 0;
+    bool rtc_valid = false;
+    bool first_valid = false;
+
+    if (ESP_OK != bm8563_ts_capture_edge(time_service_handle, &rtc_time, &edge_us, &rtc_valid)) {
+        return ESP_FAIL;
+    }
+
+    taskENTER_CRITICAL(&time_service_handle->lock);
+    if (true == restart || false == time_service_handle->rtc_valid || false == rtc_valid) {
+        time_service_handle->drift_ref_rtc = rtc_time;
+        time_service_handle->drift_ref_us = edge_us;
+        if (true == restart) {
+            time_service_handle->drift_ppb = 0;
+            time_service_handle->drift_valid = false;
+        }
+    } else if (rtc_time - time_service_handle->drift_ref_rtc >= BM8563_TIME_SERVICE_DRIFT_MIN_S) {
+        int64_t rtc_elapsed_s = rtc_time - time_service_handle->drift_ref_rtc;
+        int64_t esp_elapsed_us = edge_us - time_service_handle->drift_ref_us;
+        int64_t drift_ppb = (esp_elapsed_us - rtc_elapsed_s * 1000000) * 1000 / rtc_elapsed_s;
+        if (llabs(drift_ppb) <= BM8563_TIME_SERVICE_DRIFT_MAX_PPB) {
+            if (true == time_service_handle->drift_valid) {
+                // First order low pass, 1/4 of the new measurement.
+                time_service_handle->drift_ppb += (int32_t)(drift_ppb - time_service_handle->drift_ppb) / 4;
+            } else {
+                time_service_handle->drift_ppb = (int32_t)drift_ppb;
+                time_service_handle->drift_valid = true;
+            }
+        }
+        time_service_handle->drift_ref_rtc = rtc_time;
+        time_service_handle->drift_ref_us = edge_us;
+    }
+    time_service_handle->anchor_rtc = rtc_time;
+    time_service_handle->anchor_us = edge_us;
+    first_valid = (false == time_service_handle->rtc_valid && true == rtc_valid);
+    time_service_handle->rtc_valid = rtc_valid;
+    taskEXIT_CRITICAL(&time_service_handle->lock);
+
+    if (false == rtc_valid) {
+        ESP_LOGW(TAG, "%s (%d) rtc time is not valid, system time unchanged.", __FUNCTION__, __LINE__);
+        return ESP_OK;
+    }
+    bm8563_ts_discipline_system_time(time_service_handle, restart || first_valid);
+    return ESP_OK;
+}
+
+/**
+  * @brief  Resync task, resync from the RTC every period or when notified.
+  * @param[in]  arg  time service operation handle.
+  */
+static void bm8563_ts_task(void *arg)
+{
+    BM8563_TimeService_handle_t time_service_handle = (BM8563_TimeService_handle_t)arg;
+    TickType_t period = (TickType_t)((uint64_t)time_service_handle->resync_period_s * 1000 / 
+                                     portTICK_PERIOD_MS);
+
+    while (false == time_service_handle->task_exit) {
+        ulTaskNotifyTake(pdTRUE, period);
+        if (true == time_service_handle->task_exit) {
+            break;
+        }
+        xSemaphoreTake(time_service_handle->sync_mutex, portMAX_DELAY);
+        if (ESP_OK != bm8563_ts_sync(time_service_handle, false)) {
+            ESP_LOGE(TAG, "%s (%d) rtc resync failed.", __FUNCTION__, __LINE__);
+        }
+        xSemaphoreGive(time_service_handle->sync_mutex);
+    }
+    time_service_handle->task = NULL;
+    vTaskDelete(NULL);
+}
+
+/**
+  * @brief  Start the BM8563 time service and obtain an operation handle.
+  *         The RTC is read once here and then every resync_period_s by a task, 
+  *         each read sets or slews the system time(settimeofday()/adjtime()).
+  *         Time queries are served from esp_timer, corrected by the measured drift.
+  * @param[in]  bm8563_handle  bm8563 operation handle.
+  * @param[in]  resync_period_s  RTC resync period, unit: s.
+  * @param[in]  task_priority  resync task priority.
+  * @retval  
+  *         successful  time service operation handle.
+  *         failed      NULL.
+  * @note  Use BM8563_TimeServiceDeinit() to release it.
+  * @note  Each RTC read waits for the next second edge, this blocks for up to 1 second.
+  */
+BM8563_TimeService_handle_t BM8563_TimeServiceInit(BM8563_handle_t bm8563_handle, 
+                                                   uint32_t resync_period_s, UBaseType_t task_priority)
+{
+    if (NULL == bm8563_handle) {
+        ESP_LOGE(TAG, "%s (%d) bm8563 handle is not initialized.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+    if (0 == resync_period_s) {
+        ESP_LOGE(TAG, "%s (%d) resync period is 0.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+
+    BM8563_TimeService_handle_t time_service_handle = calloc(1, sizeof(BM8563_TimeService_t));
+    if (NULL == time_service_handle) {
+        ESP_LOGE(TAG, "%s (%d) driver handle malloc failed.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+    time_service_handle->bm8563_handle = bm8563_handle;
+    time_service_handle->resync_period_s = resync_period_s;
+    time_service_handle->lock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+    time_service_handle->sync_mutex = xSemaphoreCreateMutex();
+    if (NULL == time_service_handle->sync_mutex) {
+        goto BM8563_TIME_SERVICE_INIT_FAILED;
+    }
+    if (ESP_OK != bm8563_ts_sync(time_service_handle, true)) {
+        goto BM8563_TIME_SERVICE_INIT_FAILED;
+    }
+
+    time_service_handle->task_exit = false;
+    if (pdPASS != xTaskCreate(bm8563_ts_task, "bm8563_time", BM8563_TIME_SERVICE_TASK_STACK_SIZE, 
+                              time_service_handle, task_priority, &time_service_handle->task)) {
+        time_service_handle->task = NULL;
+        goto BM8563_TIME_SERVICE_INIT_FAILED;
+    }
+    ESP_LOGI(TAG, "%s (%d) bm8563 time service init ok.", __FUNCTION__, __LINE__);
+    return time_service_handle;
+
+BM8563_TIME_SERVICE_INIT_FAILED:
+    if (NULL != time_service_handle->sync_mutex) {
+        vSemaphoreDelete(time_service_handle->sync_mutex);
+    }
+    free(time_service_handle);
+    ESP_LOGE(TAG, "%s (%d) bm8563 time service init failed.", __FUNCTION__, __LINE__);
+    return NULL;
+}
+
+/**
+  * @brief  Stop the BM8563 time service.
+  * @param[in]  time_service_handle  time service operation handle pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_TimeServiceDeinit(BM8563_TimeService_handle_t* time_service_handle)
+{
+    BM8563_TIME_SERVICE_HANDLE_CHECK(*time_service_handle, ESP_FAIL);
+
+    // Let the task finish the current resync and delete itself.
+    (*time_service_handle)->task_exit = true;
+    xTaskNotifyGive((*time_service_handle)->task);
+    while (NULL != (*time_service_handle)->task) {
+        vTaskDelay(1);
+    }
+    vSemaphoreDelete((*time_service_handle)->sync_mutex);
+    free(*time_service_handle);
+    *time_service_handle = NULL;
+    ESP_LOGI(TAG, "%s (%d) bm8563 time service deinit ok.", __FUNCTION__, __LINE__);
+    return ESP_OK;
+}
+
+/**
+  * @brief  BM8563 time service get the current time, without any I2C transfer.
+  * @param[in]  time_service_handle  time service operation handle.
+  * @param[out]  tv  current UTC time.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_ERR_INVALID_STATE  the time was returned, but the RTC clock integrity 
+  *                                  is not guaranteed.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_TimeServiceGetTime(BM8563_TimeService_handle_t time_service_handle, struct timeval *tv)
+{
+    int64_t now_us = 0;
+
+    BM8563_TIME_SERVICE_HANDLE_CHECK(time_service_handle, ESP_FAIL);
+    if (NULL == tv) {
+        return ESP_FAIL;
+    }
+
+    now_us = bm8563_ts_now_us(time_service_handle);
+    tv->tv_sec = now_us / 1000000;
+    tv->tv_usec = now_us % 1000000;
+    return (true == time_service_handle->rtc_valid) ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+/**
+  * @brief  BM8563 time service get the measured esp_timer drift against the RTC.
+  * @param[in]  time_service_handle  time service operation handle.
+  * @param[out]  drift_ppb  drift, positive when esp_timer runs fast, unit: ppb.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by no drift measurement yet, 
+  *                     it needs two resyncs at least BM8563_TIME_SERVICE_DRIFT_MIN_S apart.
+  */
+esp_err_t BM8563_TimeServiceGetDrift(BM8563_TimeService_handle_t time_service_handle, int32_t *drift_ppb)
+{
+    BM8563_TIME_SERVICE_HANDLE_CHECK(time_service_handle, ESP_FAIL);
+    if (NULL == drift_ppb || false == time_service_handle->drift_valid) {
+        return ESP_FAIL;
+    }
+
+    *drift_ppb = time_service_handle->drift_ppb;
+    return ESP_OK;
+}
+
+/**
+  * @brief  BM8563 time service set the RTC and the system time.
+  * @param[in]  time_service_handle  time service operation handle.
+  * @param[in]  unix_time  UTC time, seconds since 1970-01-01 00:00:00.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The drift measurement restarts.
+  */
+esp_err_t BM8563_TimeServiceSetTime(BM8563_TimeService_handle_t time_service_handle, time_t unix_time)
+{
+    esp_err_t err = ESP_OK;
+    BM8563_Time_t time;
+
+    BM8563_TIME_SERVICE_HANDLE_CHECK(time_service_handle, ESP_FAIL);
+    if (ESP_OK != BM8563_UnixToTime(unix_time, &time)) {
+        ESP_LOGE(TAG, "%s (%d) time out of range.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    xSemaphoreTake(time_service_handle->sync_mutex, portMAX_DELAY);
+    err = BM8563_SetTime(time_service_handle->bm8563_handle, time);
+    if (ESP_OK == err) {
+        err = bm8563_ts_sync(time_service_handle, true);
+    }
+    xSemaphoreGive(time_service_handle->sync_mutex);
+    return err;
+}
+
+/**
+  * @brief  BM8563 time service resync from the RTC now instead of waiting for the period.
+  * @param[in]  time_service_handle  time service operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_TimeServiceResync(BM8563_TimeService_handle_t time_service_handle)
+{
+    BM8563_TIME_SERVICE_HANDLE_CHECK(time_service_handle, ESP_FAIL);
+
+    xTaskNotifyGive(time_service_handle->task);
+    return ESP_OK;
+}
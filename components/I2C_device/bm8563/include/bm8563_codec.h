@@ -0,0 +1,64 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           bm8563_codec.h
+  * @version        1.0
+  * @date           2026-10-19
+  * @brief          BM8563 register encoding, plain C without ESP-IDF dependencies.
+  */
+
+#ifndef __BM8563_CODEC_H
+#define __BM8563_CODEC_H
+
+#include <stdint.h>
+
+#define BM8563_ALARM_AE_BIT             0x80    // Alarm registers, set to disable the field.
+#define BM8563_ALARM_ANY                0xFF    // Alarm field does not take part in the match.
+
+// Alarm, fires when all fields that are not BM8563_ALARM_ANY match.
+typedef struct{
+    uint8_t min;    // 0~59 or BM8563_ALARM_ANY
+    uint8_t hour;   // 0~23 or BM8563_ALARM_ANY
+    uint8_t day;    // 1~31 or BM8563_ALARM_ANY
+    uint8_t week;   // 0~6 or BM8563_ALARM_ANY
+}BM8563_Alarm_t;
+
+/**
+  * @brief  Convert HEX format to BCD format.
+  * @param[in]  hex_data  HEX format data.
+  * @retval  BCD format data.
+  * @note   Note that the input data range is 0-99, the maximum range of this two-byte BCD code.
+  */
+uint8_t BM8563_HexToBcd(uint8_t hex_data);
+
+/**
+  * @brief  Convert BCD format to HEX format.
+  * @param[in]  bcd_data  BCD format data.
+  * @retval  HEX format data, 0xFF for an invalid BCD code.
+  */
+uint8_t BM8563_BcdToHex(uint8_t bcd_data);
+
+/**
+  * @brief  Encode an alarm into the four alarm register values.
+  * @param[in]  alarm  alarm, at least one field must not be BM8563_ALARM_ANY.
+  * @param[out]  reg_buf  values of BM8563_ALARM_MIN_REG ~ BM8563_ALARM_WEEK_REG.
+  * @retval  0: successful, -1: a field is out of range or no field takes part in the match.
+  */
+int BM8563_AlarmEncode(const BM8563_Alarm_t *alarm, uint8_t reg_buf[4]);
+
+#endif /* __BM8563_CODEC_H */
@@ -24,8 +24,11 @@
 #ifndef __BM8563_DRIVER_H
 #define __BM8563_DRIVER_H
 
+#include <time.h>
 #include "driver/i2c.h"
+#include "driver/gpio.h"
 #include "../../i2c_master/include/i2c_master.h"
+#include "bm8563_codec.h"
 
 // BM8563 register
 // control
@@ -48,6 +51,28 @@
 #define BM8563_ALARM_DAY_REG            0x0B    // Day alarm register.
 #define BM8563_ALARM_WEEK_REG           0x0C    // Week alarm register.
 
+#define BM8563_TIME_VL_BIT              0x80    // Seconds register, clock integrity not guaranteed.
+#define BM8563_TIME_CENTURY_BIT         0x80    // Month register, century flag.
+#define BM8563_YEAR_BASE                2000    // Year 0 of the BM8563 year register.
+
+// Control/Status Register 2 bits.
+#define BM8563_CONTROL_2_TIE_BIT        0x01    // Timer interrupt enable.
+#define BM8563_CONTROL_2_AIE_BIT        0x02    // Alarm interrupt enable.
+#define BM8563_CONTROL_2_TF_BIT         0x04    // Timer flag, write 0 to clear, writing 1 keeps it.
+#define BM8563_CONTROL_2_AF_BIT         0x08    // Alarm flag, write 0 to clear, writing 1 keeps it.
+#define BM8563_TIMER_TE_BIT             0x80    // Timer control register, timer enable.
+#define BM8563_TIMER_SOURCE_1HZ         0x02    // Timer control register, 1Hz source clock.
+#define BM8563_TIMER_SOURCE_1_60HZ      0x03    // Timer control register, 1/60Hz source clock.
+
+#define BM8563_TIMER_MAX_S              (255 * 60)      // Longest countdown timer period.
+#define BM8563_WAKEUP_MAX_S             (27 * 86400)    // Longest wakeup delay, the alarm 
+                                                        // matches the day of month.
+
+// Wake cause, combination of the bits below.
+#define BM8563_WAKE_NONE                0x00    // Not woken by the BM8563.
+#define BM8563_WAKE_ALARM               0x01    // Woken by the alarm.
+#define BM8563_WAKE_TIMER               0x02    // Woken by the countdown timer.
+
 typedef struct{
     uint8_t sec;    // 0~59
     uint8_t min;    // 0~59
@@ -61,6 +86,7 @@ typedef struct{
 typedef struct{
     I2cMaster_handle_t i2c_handle;
     uint8_t i2c_addr;
+    uint8_t boot_flags;             // Alarm/timer flags found by BM8563_Init(), before clearing.
 }BM8563_t;
 typedef BM8563_t *BM8563_handle_t;
 
@@ -73,6 +99,8 @@ typedef BM8563_t *BM8563_handle_t;
   *         successful  bm8563 operation handle.
   *         failed      NULL.
   * @note  Use BM8563_Deinit() to release it.
+  * @note  The alarm and timer flags are latched for BM8563_GetWakeCause(), then cleared 
+  *        together with the interrupt enables.
   */
 BM8563_handle_t BM8563_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr);
 
@@ -101,8 +129,108 @@ esp_err_t BM8563_SetTime(BM8563_handle_t bm8563_handle, BM8563_Time_t time);
   * @param[in]  bm8563_handle  bm8563 operation handle.
   * @retval 
   *         - ESP_OK    successful.
+  *         - ESP_ERR_INVALID_STATE  the time was read, but the clock integrity is not 
+  *                                  guaranteed(power was lost since the last BM8563_SetTime()).
   *         - ESP_FAIL  failed.
   */
 esp_err_t BM8563_GetTime(BM8563_handle_t bm8563_handle, BM8563_Time_t* time);
 
+/**
+  * @brief  Convert BM8563 time to struct tm.
+  * @param[in]  time  BM8563 time struct pointer.
+  * @param[out]  tm  struct tm pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_TimeToTm(const BM8563_Time_t *time, struct tm *tm);
+
+/**
+  * @brief  Convert struct tm to BM8563 time.
+  * @param[in]  tm  struct tm pointer, only the years 2000~2099 are supported.
+  * @param[out]  time  BM8563 time struct pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The week is calculated from the date, tm_wday is ignored.
+  */
+esp_err_t BM8563_TmToTime(const struct tm *tm, BM8563_Time_t *time);
+
+/**
+  * @brief  Convert BM8563 time to time_t, the BM8563 is kept in UTC.
+  * @param[in]  time  BM8563 time struct pointer.
+  * @retval  seconds since 1970-01-01 00:00:00 UTC.
+  */
+time_t BM8563_TimeToUnix(const BM8563_Time_t *time);
+
+/**
+  * @brief  Convert time_t to BM8563 time, the BM8563 is kept in UTC.
+  * @param[in]  unix_time  seconds since 1970-01-01 00:00:00 UTC, only the years 2000~2099 are supported.
+  * @param[out]  time  BM8563 time struct pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_UnixToTime(time_t unix_time, BM8563_Time_t *time);
+
+/**
+  * @brief  BM8563 set the alarm and enable the alarm interrupt.
+  * @param[in]  bm8563_handle  bm8563 operation handle.
+  * @param[in]  alarm  alarm, at least one field must not be BM8563_ALARM_ANY.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_SetAlarm(BM8563_handle_t bm8563_handle, const BM8563_Alarm_t *alarm);
+
+/**
+  * @brief  BM8563 disable the alarm interrupt and clear the alarm flag.
+  * @param[in]  bm8563_handle  bm8563 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_DisableAlarm(BM8563_handle_t bm8563_handle);
+
+/**
+  * @brief  BM8563 start the countdown timer and enable the timer interrupt.
+  * @param[in]  bm8563_handle  bm8563 operation handle.
+  * @param[in]  seconds  1~BM8563_TIMER_MAX_S, above 255 it is rounded up to whole minutes.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_SetTimer(BM8563_handle_t bm8563_handle, uint32_t seconds);
+
+/**
+  * @brief  BM8563 stop the countdown timer, disable the timer interrupt and clear the timer flag.
+  * @param[in]  bm8563_handle  bm8563 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_DisableTimer(BM8563_handle_t bm8563_handle);
+
+/**
+  * @brief  BM8563 schedule the next wakeup and enable the ESP32 deep sleep wakeup from the INT pin.
+  *         Up to BM8563_TIMER_MAX_S the countdown timer is used, longer delays use the alarm 
+  *         and are rounded up to whole minutes.
+  * @param[in]  bm8563_handle  bm8563 operation handle.
+  * @param[in]  seconds  wakeup delay, 1~BM8563_WAKEUP_MAX_S.
+  * @param[in]  int_pin  RTC gpio connected to the BM8563 INT pin.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Call esp_deep_sleep_start() afterwards.
+  */
+esp_err_t BM8563_SetWakeup(BM8563_handle_t bm8563_handle, uint32_t seconds, gpio_num_t int_pin);
+
+/**
+  * @brief  BM8563 get the wake cause.
+  * @param[in]  bm8563_handle  bm8563 operation handle.
+  * @retval  BM8563_WAKE_NONE, or BM8563_WAKE_ALARM and/or BM8563_WAKE_TIMER.
+  * @note  Uses the flags latched by BM8563_Init(), no I2C transfer.
+  */
+uint8_t BM8563_GetWakeCause(BM8563_handle_t bm8563_handle);
+
 #endif /* __BM8563_DRIVER_H */
\ No newline at end of file
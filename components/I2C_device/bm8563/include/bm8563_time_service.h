@@ -0,0 +1,125 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           bm8563_time_service.h
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#ifndef __BM8563_TIME_SERVICE_H
+#define __BM8563_TIME_SERVICE_H
+
+#include <sys/time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "bm8563_driver.h"
+
+#define BM8563_TIME_SERVICE_TASK_STACK_SIZE     (2048)  // Resync task stack size.
+#define BM8563_TIME_SERVICE_DRIFT_MIN_S         (600)   // Shortest interval used to measure drift.
+#define BM8563_TIME_SERVICE_STEP_US             (500000)// Larger offsets step the system time, 
+                                                        // smaller offsets are slewed by adjtime().
+
+typedef struct{
+    BM8563_handle_t bm8563_handle;
+    uint32_t resync_period_s;       // RTC resync period, unit: s.
+    volatile bool task_exit;        // Request the resync task to exit.
+    TaskHandle_t task;              // Resync task.
+    SemaphoreHandle_t sync_mutex;   // Serializes RTC reads and writes.
+    portMUX_TYPE lock;              // Protects the anchor and drift fields below.
+    time_t anchor_rtc;              // RTC time at the last captured second edge.
+    int64_t anchor_us;              // esp_timer time of the last captured second edge.
+    time_t drift_ref_rtc;           // RTC time of the drift measurement start.
+    int64_t drift_ref_us;           // esp_timer time of the drift measurement start.
+    int32_t drift_ppb;              // esp_timer drift against the RTC, unit: ppb.
+    bool drift_valid;               // At least one drift measurement was taken.
+    bool rtc_valid;                 // RTC clock integrity is guaranteed.
+}BM8563_TimeService_t;
+typedef BM8563_TimeService_t *BM8563_TimeService_handle_t;
+
+/**
+  * @brief  Start the BM8563 time service and obtain an operation handle.
+  *         The RTC is read once here and then every resync_period_s by a task, 
+  *         each read sets or slews the system time(settimeofday()/adjtime()).
+  *         Time queries are served from esp_timer, corrected by the measured drift.
+  * @param[in]  bm8563_handle  bm8563 operation handle.
+  * @param[in]  resync_period_s  RTC resync period, unit: s.
+  * @param[in]  task_priority  resync task priority.
+  * @retval  
+  *         successful  time service operation handle.
+  *         failed      NULL.
+  * @note  Use BM8563_TimeServiceDeinit() to release it.
+  * @note  Each RTC read waits for the next second edge, this blocks for up to 1 second.
+  */
+BM8563_TimeService_handle_t BM8563_TimeServiceInit(BM8563_handle_t bm8563_handle, 
+                                                   uint32_t resync_period_s, UBaseType_t task_priority);
+
+/**
+  * @brief  Stop the BM8563 time service.
+  * @param[in]  time_service_handle  time service operation handle pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_TimeServiceDeinit(BM8563_TimeService_handle_t* time_service_handle);
+
+/**
+  * @brief  BM8563 time service get the current time, without any I2C transfer.
+  * @param[in]  time_service_handle  time service operation handle.
+  * @param[out]  tv  current UTC time.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_ERR_INVALID_STATE  the time was returned, but the RTC clock integrity 
+  *                                  is not guaranteed.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_TimeServiceGetTime(BM8563_TimeService_handle_t time_service_handle, struct timeval *tv);
+
+/**
+  * @brief  BM8563 time service get the measured esp_timer drift against the RTC.
+  * @param[in]  time_service_handle  time service operation handle.
+  * @param[out]  drift_ppb  drift, positive when esp_timer runs fast, unit: ppb.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by no drift measurement yet, 
+  *                     it needs two resyncs at least BM8563_TIME_SERVICE_DRIFT_MIN_S apart.
+  */
+esp_err_t BM8563_TimeServiceGetDrift(BM8563_TimeService_handle_t time_service_handle, int32_t *drift_ppb);
+
+/**
+  * @brief  BM8563 time service set the RTC and the system time.
+  * @param[in]  time_service_handle  time service operation handle.
+  * @param[in]  unix_time  UTC time, seconds since 1970-01-01 00:00:00.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The drift measurement restarts.
+  */
+esp_err_t BM8563_TimeServiceSetTime(BM8563_TimeService_handle_t time_service_handle, time_t unix_time);
+
+/**
+  * @brief  BM8563 time service resync from the RTC now instead of waiting for the period.
+  * @param[in]  time_service_handle  time service operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t BM8563_TimeServiceResync(BM8563_TimeService_handle_t time_service_handle);
+
+#endif /* __BM8563_TIME_SERVICE_H */
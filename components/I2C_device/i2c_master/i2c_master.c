@@ -479,4 +479,54 @@ esp_err_t I2cMaster_ReadRegBit(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr,
 
     *bit_val = (data_buf>>bit_num) & ~(0xff<<bit_len);
     return ESP_OK;
-}   
\ No newline at end of file
+}   
+
+/**
+  * @brief  I2C master writes a register burst table in one transaction.
+  *         Each burst is written with auto-increment addressing, bursts are separated 
+  *         by repeated start signals and the whole table is sent with a single command link.
+  * @param[in]  i2c_handle  i2c master operation handle.
+  * @param[in]  i2c_addr  i2c slave address(7bit).
+  * @param[in]  reg_table  Burst table, a sequence of bursts in the format
+  *                        {start register address, data length(1~255), data...}.
+  * @param[in]  table_len  Burst table length(byte).
+  * @retval  reference esp_err_t.
+  * @note  The slave must support register address auto-increment when writing.
+  * @note  example: 
+  *        write 0x37=0x07, 0x38=0x17, 0x39=0x06, 0x4C=0x20.
+  *        ```
+  *        static const uint8_t table[] = {0x37, 3, 0x07, 0x17, 0x06, 0x4C, 1, 0x20};
+  *        I2cMaster_WriteRegTable(xxx, xxx, table, sizeof(table));
+  *        ```
+  */
+esp_err_t I2cMaster_WriteRegTable(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr, 
+                                  const uint8_t* reg_table, uint32_t table_len)
+{
+    esp_err_t ret = ESP_OK;
+    uint32_t i = 0;
+
+    I2C_MASTER_HANDLE_CHECK(i2c_handle, ESP_FAIL);
+    I2C_MASTER_SLAVE_ADDR_CHECK(i2c_addr, ESP_FAIL);
+    if (NULL == reg_table) {
+        return ESP_FAIL;
+    }
+    // Check the table format before building the command link.
+    for (i = 0; i < table_len; i += 2 + reg_table[i+1]) {
+        if (i+2 > table_len || 0 == reg_table[i+1] || i+2+reg_table[i+1] > table_len) {
+            ESP_LOGE(TAG, "%s (%d) register table format error.", __FUNCTION__, __LINE__);
+            return ESP_FAIL;
+        }
+    }
+
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    for (i = 0; i < table_len; i += 2 + reg_table[i+1]) {
+        i2c_master_start(cmd);
+        i2c_master_write_byte(cmd, (i2c_addr << 1)|I2C_MASTER_WRITE, true);
+        i2c_master_write_byte(cmd, reg_table[i], true);
+        i2c_master_write(cmd, (uint8_t*)&reg_table[i+2], reg_table[i+1], true);
+    }
+    i2c_master_stop(cmd);
+    ret = i2c_master_cmd_begin(i2c_handle->i2c_port, cmd, 1000/portTICK_RATE_MS);
+    i2c_cmd_link_delete(cmd);
+    return ret;
+}
\ No newline at end of file
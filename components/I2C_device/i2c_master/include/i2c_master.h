@@ -212,5 +212,25 @@ esp_err_t I2cMaster_WriteRegBit(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr,
   */
 esp_err_t I2cMaster_ReadRegBit(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr, uint8_t reg_addr, 
                                 uint8_t bit_num, uint8_t *bit_val, uint8_t bit_len);
+/**
+  * @brief  I2C master writes a register burst table in one transaction.
+  *         Each burst is written with auto-increment addressing, bursts are separated 
+  *         by repeated start signals and the whole table is sent with a single command link.
+  * @param[in]  i2c_handle  i2c master operation handle.
+  * @param[in]  i2c_addr  i2c slave address(7bit).
+  * @param[in]  reg_table  Burst table, a sequence of bursts in the format
+  *                        {start register address, data length(1~255), data...}.
+  * @param[in]  table_len  Burst table length(byte).
+  * @retval  reference esp_err_t.
+  * @note  The slave must support register address auto-increment when writing.
+  * @note  example: 
+  *        write 0x37=0x07, 0x38=0x17, 0x39=0x06, 0x4C=0x20.
+  *        ```
+  *        static const uint8_t table[] = {0x37, 3, 0x07, 0x17, 0x06, 0x4C, 1, 0x20};
+  *        I2cMaster_WriteRegTable(xxx, xxx, table, sizeof(table));
+  *        ```
+  */
+esp_err_t I2cMaster_WriteRegTable(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr, 
+                                  const uint8_t* reg_table, uint32_t table_len);
 
 #endif /* __I2C_MASTER_H_ */
\ No newline at end of file
@@ -0,0 +1,62 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           i2c_master_int.h
+  * @version        1.0
+  * @date           2026-10-19
+  * @brief          Interrupt outputs of I2C slaves, shared by the INT and ALERT pin drivers.
+  */
+
+#ifndef __I2C_MASTER_INT_H_
+#define __I2C_MASTER_INT_H_
+
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "esp_err.h"
+
+/**
+  * @brief  Set up the gpio connected to the interrupt output of an I2C slave.
+  *         The pin becomes an input with the internal pull-up, the interrupt outputs are 
+  *         open drain, and the handler is added to the gpio ISR service.
+  * @param[in]  pin  gpio connected to the interrupt output.
+  * @param[in]  intr_type  interrupt edge, GPIO_INTR_NEGEDGE for an active low output.
+  * @param[in]  isr_handler  ISR handler.
+  * @param[in]  arg  ISR handler argument.
+  * @retval  reference esp_err_t.
+  * @note  The gpio ISR service is shared with other drivers. It is installed if no driver 
+  *        has installed it yet and it is never uninstalled.
+  * @note  On failure the pin is reset. Use I2cMaster_IntPinRelease() to release it.
+  */
+esp_err_t I2cMaster_IntPinSetup(gpio_num_t pin, gpio_int_type_t intr_type, gpio_isr_t isr_handler, void *arg);
+
+/**
+  * @brief  Release an interrupt pin and stop the worker task serving it.
+  *         The handler is removed first, so no ISR wakes the task any more. The task is 
+  *         then asked to exit and the pin is reset once it is gone.
+  * @param[in]  pin  gpio given to I2cMaster_IntPinSetup(), -1 only stops the worker task.
+  * @param[in,out]  task  worker task, the task sets it to NULL right before it deletes 
+  *                       itself. NULL or pointing to NULL when there is no worker task.
+  * @param[out]  task_exit  exit flag polled by the worker task.
+  * @note  The worker task finishes the I2C transfer in progress before it exits, the pin 
+  *        stays an input until then, so the task may still read its level.
+  */
+void I2cMaster_IntPinRelease(gpio_num_t pin, TaskHandle_t *task, volatile bool *task_exit);
+
+#endif /* __I2C_MASTER_INT_H_ */
@@ -26,10 +26,54 @@
 
 #include "../../i2c_master/include/i2c_master.h"
 #include "driver/i2c.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+#define PAJ7620U2_EVENT_QUEUE_LEN       (16)    // Gesture event queue length.
+#define PAJ7620U2_INT_TASK_STACK_SIZE   (2048)  // INT pin and streaming task stack size.
+#define PAJ7620U2_INT_RETRY_MS          (10)    // Delay before reading the gesture flags again after a failure(ms).
+
+// Gesture event posted by the INT pin worker.
+typedef struct {
+    uint16_t gesture;           // One of PAJ7620U2_GESTURE_xxx.
+    int64_t time_us;            // esp_timer time when the INT pin became active(us).
+} PAJ7620U2_GestureEvent_t;
+
+// Object proximity event type.
+typedef enum {
+    PAJ7620U2_APPROACH_ENTER,       // Object brightness rose to the enter threshold.
+    PAJ7620U2_APPROACH_LEAVE,       // Object brightness fell below the leave threshold.
+} PAJ7620U2_ApproachEventType_t;
+
+// Object proximity event posted by the streaming task.
+typedef struct {
+    PAJ7620U2_ApproachEventType_t type;
+    uint8_t obj_brightness;     // Object brightness value (0~255) of the frame.
+    uint16_t obj_size;          // Object size value (0~900) of the frame.
+    int64_t time_us;            // esp_timer time of the frame(us).
+} PAJ7620U2_ApproachEvent_t;
+
+// Object proximity streaming configuration.
+typedef struct {
+    uint32_t frame_period_ms;   // Sampling period(ms).
+    uint8_t enter_brightness;   // Object enters when brightness >= enter_brightness.
+    uint8_t leave_brightness;   // Object leaves when brightness < leave_brightness.
+} PAJ7620U2_ApproachStreamConfig_t;
 
 typedef struct {
     I2cMaster_handle_t i2c_handle;    
     uint8_t i2c_addr;     
+    gpio_num_t int_pin;                 // INT pin, -1 when the interrupt is not enabled.
+    volatile int64_t int_time_us;       // Time of the last INT pin falling edge(us).
+    volatile bool int_task_exit;        // Request the worker task to exit.
+    TaskHandle_t int_task;              // INT pin worker task.
+    QueueHandle_t event_queue;          // Gesture event queue.
+    PAJ7620U2_ApproachStreamConfig_t stream_config;
+    volatile bool stream_task_exit;     // Request the streaming task to exit.
+    TaskHandle_t stream_task;           // Object proximity streaming task.
+    QueueHandle_t approach_queue;       // Object proximity event queue.
 } PAJ7620U2_t;
 typedef PAJ7620U2_t *PAJ7620U2_handle_t;
 
@@ -110,4 +154,87 @@ esp_err_t PAJ7620U2_ApproachInit(PAJ7620U2_handle_t paj7620u2_handle);
 esp_err_t PAJ7620U2_ApproachGetData(PAJ7620U2_handle_t paj7620u2_handle, uint8_t *obj_brightness, 
                                uint16_t *obj_size);
 
+/**
+  * @brief  PAJ7620U2 Enable the gesture INT pin interrupt.
+  *         The ISR wakes a worker task, which reads both gesture flag registers in one 
+  *         transfer and posts one event per detected gesture to the handle queue.
+  *         Use PAJ7620U2_GestureWaitEvent() to receive them.
+  * @param[in]  paj7620u2_handle  paj7620u2 operation handle.
+  * @param[in]  int_pin  gpio connected to the INT pin.
+  * @param[in]  task_priority  worker task priority.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Make sure to perform gesture recognition initialization before using 
+  *        this function.
+  * @note  int_pin is set up by I2cMaster_IntPinSetup(). INT stays low until the gesture flags are read.
+  */
+esp_err_t PAJ7620U2_GestureIntrEnable(PAJ7620U2_handle_t paj7620u2_handle, gpio_num_t int_pin, 
+                                      UBaseType_t task_priority);
+
+/**
+  * @brief  PAJ7620U2 Disable the gesture INT pin interrupt and stop the worker task.
+  * @param[in]  paj7620u2_handle  paj7620u2 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by the interrupt not being enabled.
+  */
+esp_err_t PAJ7620U2_GestureIntrDisable(PAJ7620U2_handle_t paj7620u2_handle);
+
+/**
+  * @brief  PAJ7620U2 Wait for a gesture event.
+  * @param[in]  paj7620u2_handle  paj7620u2 operation handle.
+  * @param[out]  gesture_event  gesture event.
+  * @param[in]  wait_ticks  maximum ticks to wait.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_ERR_TIMEOUT  no gesture within wait_ticks.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t PAJ7620U2_GestureWaitEvent(PAJ7620U2_handle_t paj7620u2_handle, 
+                                     PAJ7620U2_GestureEvent_t *gesture_event, TickType_t wait_ticks);
+
+/**
+  * @brief  PAJ7620U2 Start object proximity streaming.
+  *         A task reads brightness and size in one transfer every frame, applies the 
+  *         hysteresis thresholds and posts enter/leave events to the handle queue.
+  *         Use PAJ7620U2_ApproachWaitEvent() to receive them.
+  * @param[in]  paj7620u2_handle  paj7620u2 operation handle.
+  * @param[in]  stream_config  streaming configuration.
+  * @param[in]  task_priority  streaming task priority.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by leave_brightness > enter_brightness.
+  * @note  Make sure to perform object proximity measurement mode initialization 
+  *        before using this function.
+  */
+esp_err_t PAJ7620U2_ApproachStreamStart(PAJ7620U2_handle_t paj7620u2_handle, 
+                                        const PAJ7620U2_ApproachStreamConfig_t *stream_config, 
+                                        UBaseType_t task_priority);
+
+/**
+  * @brief  PAJ7620U2 Stop object proximity streaming.
+  * @param[in]  paj7620u2_handle  paj7620u2 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by streaming not being started.
+  */
+esp_err_t PAJ7620U2_ApproachStreamStop(PAJ7620U2_handle_t paj7620u2_handle);
+
+/**
+  * @brief  PAJ7620U2 Wait for an object proximity event.
+  * @param[in]  paj7620u2_handle  paj7620u2 operation handle.
+  * @param[out]  approach_event  object proximity event.
+  * @param[in]  wait_ticks  maximum ticks to wait.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_ERR_TIMEOUT  no event within wait_ticks.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t PAJ7620U2_ApproachWaitEvent(PAJ7620U2_handle_t paj7620u2_handle, 
+                                      PAJ7620U2_ApproachEvent_t *approach_event, TickType_t wait_ticks);
+
 #endif /* __PAJ7620U2_DRIVER_H */
\ No newline at end of file
@@ -57,32 +57,77 @@
 #define PAJ7620U2_SET_S1_TO_S2_STEP_1         (0x6E)
 #define PAJ7620U2_OPERATION_ENABLE            (0x72)
 
+/* Initialization queues are stored as register burst tables, see I2cMaster_WriteRegTable().
+   Each burst is {start register, length, values...}, consecutive register addresses are 
+   grouped into one auto-increment write. The bank select register(0xEF) is always written 
+   on its own. */
+
 // paj7620u2 initialization queue.
-const uint8_t init_array[][2] = {
-    {0xEF,0x00},{0x37,0x07},{0x38,0x17},{0x39,0x06},{0x41,0x00},{0x42,0x00},{0x46,0x2D},{0x47,0x0F},
-    {0x48,0x3C},{0x49,0x00},{0x4A,0x1E},{0x4C,0x20},{0x51,0x10},{0x5E,0x10},{0x60,0x27},{0x80,0x42},
-    {0x81,0x44},{0x82,0x04},{0x8B,0x01},{0x90,0x06},{0x95,0x0A},{0x96,0x0C},{0x97,0x05},{0x9A,0x14},
-    {0x9C,0x3F},{0xA5,0x19},{0xCC,0x19},{0xCD,0x0B},{0xCE,0x13},{0xCF,0x64},{0xD0,0x21},{0xEF,0x01},
-    {0x02,0x0F},{0x03,0x10},{0x04,0x02},{0x25,0x01},{0x27,0x39},{0x28,0x7F},{0x29,0x08},{0x3E,0xFF},
-    {0x5E,0x3D},{0x65,0x96},{0x67,0x97},{0x69,0xCD},{0x6A,0x01},{0x6D,0x2C},{0x6E,0x01},{0x72,0x01},
-    {0x73,0x35},{0x74,0x00},{0x77,0x01},
+static const uint8_t init_table[] = {
+    0xEF,1, 0x00,
+    0x37,3, 0x07,0x17,0x06,
+    0x41,2, 0x00,0x00,
+    0x46,5, 0x2D,0x0F,0x3C,0x00,0x1E,
+    0x4C,1, 0x20,
+    0x51,1, 0x10,
+    0x5E,1, 0x10,
+    0x60,1, 0x27,
+    0x80,3, 0x42,0x44,0x04,
+    0x8B,1, 0x01,
+    0x90,1, 0x06,
+    0x95,3, 0x0A,0x0C,0x05,
+    0x9A,1, 0x14,
+    0x9C,1, 0x3F,
+    0xA5,1, 0x19,
+    0xCC,5, 0x19,0x0B,0x13,0x64,0x21,
+    0xEF,1, 0x01,
+    0x02,3, 0x0F,0x10,0x02,
+    0x25,1, 0x01,
+    0x27,3, 0x39,0x7F,0x08,
+    0x3E,1, 0xFF,
+    0x5E,1, 0x3D,
+    0x65,1, 0x96,
+    0x67,1, 0x97,
+    0x69,2, 0xCD,0x01,
+    0x6D,2, 0x2C,0x01,
+    0x72,3, 0x01,0x35,0x00,
+    0x77,1, 0x01,
 };
 
 // paj7620u2 gesture recognition mode initialization queue.
-const uint8_t gesture_array[][2] = {
-    {0xEF,0x00},{0x41,0x00},{0x42,0x00},{0xEF,0x00},{0x48,0x3C},{0x49,0x00},{0x51,0x10},{0x83,0x20},
-    {0x9F,0xF9},{0xEF,0x01},{0x01,0x1E},{0x02,0x0F},{0x03,0x10},{0x04,0x02},{0x41,0x40},{0x43,0x30},
-    {0x65,0x96},{0x66,0x00},{0x67,0x97},{0x68,0x01},{0x69,0xCD},{0x6A,0x01},{0x6B,0xB0},{0x6C,0x04},
-    {0x6D,0x2C},{0x6E,0x01},{0x74,0x00},{0xEF,0x00},{0x41,0xFF},{0x42,0x01},
+static const uint8_t gesture_table[] = {
+    0xEF,1, 0x00,
+    0x41,2, 0x00,0x00,
+    0xEF,1, 0x00,
+    0x48,2, 0x3C,0x00,
+    0x51,1, 0x10,
+    0x83,1, 0x20,
+    0x9F,1, 0xF9,
+    0xEF,1, 0x01,
+    0x01,4, 0x1E,0x0F,0x10,0x02,
+    0x41,1, 0x40,
+    0x43,1, 0x30,
+    0x65,10, 0x96,0x00,0x97,0x01,0xCD,0x01,0xB0,0x04,0x2C,0x01,
+    0x74,1, 0x00,
+    0xEF,1, 0x00,
+    0x41,2, 0xFF,0x01,
 };
 
 // paj7620u2 Object proximity measurement mode initialization queue.
-const uint8_t proximity_array[][2] = {
-    {0xEF,0x00},{0x41,0x00},{0x42,0x00},{0x48,0x3C},{0x49,0x00},{0x51,0x13},{0x83,0x20},{0x84,0x20},
-    {0x85,0x00},{0x86,0x10},{0x87,0x00},{0x88,0x05},{0x89,0x18},{0x8A,0x10},{0x9f,0xf8},{0x69,0x96},
-    {0x6A,0x02},{0xEF,0x01},{0x01,0x1E},{0x02,0x0F},{0x03,0x10},{0x04,0x02},{0x41,0x50},{0x43,0x34},
-    {0x65,0xCE},{0x66,0x0B},{0x67,0xCE},{0x68,0x0B},{0x69,0xE9},{0x6A,0x05},{0x6B,0x50},{0x6C,0xC3},
-    {0x6D,0x50},{0x6E,0xC3},{0x74,0x05},
+static const uint8_t proximity_table[] = {
+    0xEF,1, 0x00,
+    0x41,2, 0x00,0x00,
+    0x48,2, 0x3C,0x00,
+    0x51,1, 0x13,
+    0x83,8, 0x20,0x20,0x00,0x10,0x00,0x05,0x18,0x10,
+    0x9F,1, 0xF8,
+    0x69,2, 0x96,0x02,
+    0xEF,1, 0x01,
+    0x01,4, 0x1E,0x0F,0x10,0x02,
+    0x41,1, 0x50,
+    0x43,1, 0x34,
+    0x65,10, 0xCE,0x0B,0xCE,0x0B,0xE9,0x05,0x50,0xC3,0x50,0xC3,
+    0x74,1, 0x05,
 };
 
 #endif /* __PAJ7620U2_REG_H__ */
\ No newline at end of file
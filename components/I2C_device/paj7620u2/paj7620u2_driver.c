@@ -25,8 +25,12 @@
 #include "paj7620u2_reg.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
+#include "driver/gpio.h"
+#include "esp_timer.h"
 #include "esp_log.h"
 #include "esp_err.h"
+#include "../i2c_master/include/i2c_master_int.h"
 
 static const char *TAG = "PAJ7620U2";
 
@@ -106,6 +110,127 @@ static esp_err_t paj7620u2_wakeup(PAJ7620U2_handle_t paj7620u2_handle)
     return ESP_OK;
 }
 
+/**
+  * @brief  INT pin interrupt service, save the time and wake the worker task.
+  * @param[in]  arg  paj7620u2 operation handle.
+  */
+static void IRAM_ATTR paj7620u2_int_isr_handler(void *arg)
+{
+    PAJ7620U2_handle_t paj7620u2_handle = (PAJ7620U2_handle_t)arg;
+    BaseType_t task_woken = pdFALSE;
+
+    paj7620u2_handle->int_time_us = esp_timer_get_time();
+    vTaskNotifyGiveFromISR(paj7620u2_handle->int_task, &task_woken);
+    if (pdTRUE == task_woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+  * @brief  INT pin worker task.
+  *         Read both gesture flag registers in one transfer(this also clears them and 
+  *         releases the INT pin), then post one event per gesture bit. Reading repeats 
+  *         while the INT pin is still low, so a failed transfer does not leave it stuck.
+  * @param[in]  arg  paj7620u2 operation handle.
+  */
+static void paj7620u2_int_task(void *arg)
+{
+    PAJ7620U2_handle_t paj7620u2_handle = (PAJ7620U2_handle_t)arg;
+    PAJ7620U2_GestureEvent_t gesture_event;
+    uint8_t data_buf[2] = {0};
+    uint16_t gesture_status = 0;
+
+    while (false == paj7620u2_handle->int_task_exit) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (true == paj7620u2_handle->int_task_exit) {
+            break;
+        }
+        do {
+            if (ESP_OK != I2cMaster_ReadReg(paj7620u2_handle->i2c_handle, paj7620u2_handle->i2c_addr, 
+                                            PAJ7620U2_GET_INT_FLAG1, data_buf, 2)) {
+                ESP_LOGE(TAG, "%s (%d) read gesture flag failed.", __FUNCTION__, __LINE__);
+                vTaskDelay(pdMS_TO_TICKS(PAJ7620U2_INT_RETRY_MS));
+                continue;
+            }
+            gesture_status = (uint16_t)data_buf[1]<<8 | data_buf[0];
+            gesture_event.time_us = paj7620u2_handle->int_time_us;
+            for (uint16_t bit = PAJ7620U2_GESTURE_UP; bit <= PAJ7620U2_GESTURE_WAVE; bit <<= 1) {
+                if (gesture_status & bit) {
+                    gesture_event.gesture = bit;
+                    xQueueSend(paj7620u2_handle->event_queue, &gesture_event, 0);
+                }
+            }
+        } while (false == paj7620u2_handle->int_task_exit && 0 == gpio_get_level(paj7620u2_handle->int_pin));
+    }
+    paj7620u2_handle->int_task = NULL;
+    vTaskDelete(NULL);
+}
+
+/**
+  * @brief  Read object brightness and size in one transfer.
+  * @param[in]  paj7620u2_handle  paj7620u2 operation handle.
+  * @param[out]  obj_brightness  Object brightness value (0~255).
+  * @param[out]  obj_size  Object size value (0~900).
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+static esp_err_t paj7620u2_read_approach(PAJ7620U2_handle_t paj7620u2_handle, uint8_t *obj_brightness, 
+                                         uint16_t *obj_size)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t data_buf[3] = {0};
+
+    err = I2cMaster_ReadReg(paj7620u2_handle->i2c_handle, paj7620u2_handle->i2c_addr, 
+                            PAJ7620U2_GET_OBJECT_BRIGHTNESS, data_buf, 3);
+    if(ESP_OK != err){
+        return ESP_FAIL;
+    }
+    *obj_brightness = data_buf[0];
+    *obj_size = ((uint16_t)data_buf[2] & 0x0f)<<8 | data_buf[1];
+    return ESP_OK;
+}
+
+/**
+  * @brief  Object proximity streaming task.
+  *         Sample once per frame and post an event when the object presence changes.
+  * @param[in]  arg  paj7620u2 operation handle.
+  */
+static void paj7620u2_stream_task(void *arg)
+{
+    PAJ7620U2_handle_t paj7620u2_handle = (PAJ7620U2_handle_t)arg;
+    PAJ7620U2_ApproachEvent_t approach_event;
+    TickType_t last_wake = xTaskGetTickCount();
+    TickType_t period = pdMS_TO_TICKS(paj7620u2_handle->stream_config.frame_period_ms);
+    bool obj_present = false;
+
+    if (0 == period) {
+        period = 1;
+    }
+    while (false == paj7620u2_handle->stream_task_exit) {
+        vTaskDelayUntil(&last_wake, period);
+        if (ESP_OK != paj7620u2_read_approach(paj7620u2_handle, &approach_event.obj_brightness, 
+                                              &approach_event.obj_size)) {
+            continue;
+        }
+        approach_event.time_us = esp_timer_get_time();
+        // Hysteresis, the leave threshold is not higher than the enter threshold.
+        if (false == obj_present && 
+            approach_event.obj_brightness >= paj7620u2_handle->stream_config.enter_brightness) {
+            obj_present = true;
+            approach_event.type = PAJ7620U2_APPROACH_ENTER;
+            xQueueSend(paj7620u2_handle->approach_queue, &approach_event, 0);
+        } else if (true == obj_present && 
+                   approach_event.obj_brightness < paj7620u2_handle->stream_config.leave_brightness) {
+            obj_present = false;
+            approach_event.type = PAJ7620U2_APPROACH_LEAVE;
+            xQueueSend(paj7620u2_handle->approach_queue, &approach_event, 0);
+        }
+    }
+    paj7620u2_handle->stream_task = NULL;
+    vTaskDelete(NULL);
+}
+
 /**
   * @brief  Initialize the PAJ7620U2 and obtain an operation handle.
   * @param[in]  i2c_handle  i2c master operation handle.
@@ -119,8 +244,6 @@ static esp_err_t paj7620u2_wakeup(PAJ7620U2_handle_t paj7620u2_handle)
 PAJ7620U2_handle_t PAJ7620U2_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr)
 {   
     esp_err_t err = ESP_OK;
-    uint8_t reg_buf = 0x00;
-    uint8_t val_buf = 0x00;
 
     if (NULL == i2c_handle) {
         ESP_LOGE(TAG, "%s (%d) i2c handle is not initialized.", __FUNCTION__, __LINE__);
@@ -142,6 +265,14 @@ PAJ7620U2_handle_t PAJ7620U2_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_add
     }
     paj7620u2_handle->i2c_handle = i2c_handle;
     paj7620u2_handle->i2c_addr = i2c_addr;
+    paj7620u2_handle->int_pin = -1;
+    paj7620u2_handle->int_time_us = 0;
+    paj7620u2_handle->int_task_exit = false;
+    paj7620u2_handle->int_task = NULL;
+    paj7620u2_handle->event_queue = NULL;
+    paj7620u2_handle->stream_task_exit = false;
+    paj7620u2_handle->stream_task = NULL;
+    paj7620u2_handle->approach_queue = NULL;
 
     err = paj7620u2_wakeup(paj7620u2_handle);
     if (ESP_OK != err) {
@@ -149,15 +280,11 @@ PAJ7620U2_handle_t PAJ7620U2_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_add
         goto PAJ7620U2_INIT_FAILED;
     }
     paj7620u2_select_bank(paj7620u2_handle, PAJ7620U2_BANK_0);
-    for (uint32_t i=0; i<sizeof(init_array)/2; i++) {
-        reg_buf = init_array[i][0];
-        val_buf = init_array[i][1];
-        err = I2cMaster_WriteReg(paj7620u2_handle->i2c_handle, paj7620u2_handle->i2c_addr, 
-                                 reg_buf, &val_buf, 1);    
-        if (ESP_OK != err) {
-            ESP_LOGE(TAG, "%s (%d) paj7620u2 send init array failed.", __FUNCTION__, __LINE__);
-            goto PAJ7620U2_INIT_FAILED;
-        }
+    err = I2cMaster_WriteRegTable(paj7620u2_handle->i2c_handle, paj7620u2_handle->i2c_addr, 
+                                  init_table, sizeof(init_table));
+    if (ESP_OK != err) {
+        ESP_LOGE(TAG, "%s (%d) paj7620u2 send init array failed.", __FUNCTION__, __LINE__);
+        goto PAJ7620U2_INIT_FAILED;
     }
     paj7620u2_select_bank(paj7620u2_handle, PAJ7620U2_BANK_0);
     ESP_LOGI(TAG, "%s (%d) paj7620u2 init ok.", __FUNCTION__, __LINE__);
@@ -179,6 +306,12 @@ esp_err_t PAJ7620U2_Deinit(PAJ7620U2_handle_t* paj7620u2_handle)
 {
     PAJ7620U2_HANDLE_CHECK(*paj7620u2_handle, ESP_FAIL);
 
+    if (NULL != (*paj7620u2_handle)->int_task) {
+        PAJ7620U2_GestureIntrDisable(*paj7620u2_handle);
+    }
+    if (NULL != (*paj7620u2_handle)->stream_task) {
+        PAJ7620U2_ApproachStreamStop(*paj7620u2_handle);
+    }
     free(*paj7620u2_handle);
     *paj7620u2_handle = NULL;
     ESP_LOGI(TAG, "%s (%d) paj7620u2 handle deinit ok.", __FUNCTION__, __LINE__);
@@ -195,21 +328,15 @@ esp_err_t PAJ7620U2_Deinit(PAJ7620U2_handle_t* paj7620u2_handle)
 esp_err_t PAJ7620U2_GestureInit(PAJ7620U2_handle_t paj7620u2_handle)
 { 
     esp_err_t err = ESP_OK;
-    uint8_t reg_buf = 0x00;
-    uint8_t val_buf = 0x00;
 
     PAJ7620U2_HANDLE_CHECK(paj7620u2_handle, ESP_FAIL);
         
     paj7620u2_select_bank(paj7620u2_handle, PAJ7620U2_BANK_0);
-    for (uint32_t i=0; i<sizeof(gesture_array)/2; i++) {
-        reg_buf = gesture_array[i][0];
-        val_buf = gesture_array[i][1];
-        err = I2cMaster_WriteReg(paj7620u2_handle->i2c_handle, paj7620u2_handle->i2c_addr, 
-                                 reg_buf, &val_buf, 1);    
-        if (ESP_OK != err) {
-            ESP_LOGE(TAG, "%s (%d) paj7620u2 send gesture init array failed.", __FUNCTION__, __LINE__);
-            return ESP_FAIL;
-        }
+    err = I2cMaster_WriteRegTable(paj7620u2_handle->i2c_handle, paj7620u2_handle->i2c_addr, 
+                                  gesture_table, sizeof(gesture_table));
+    if (ESP_OK != err) {
+        ESP_LOGE(TAG, "%s (%d) paj7620u2 send gesture init array failed.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
     }
     paj7620u2_select_bank(paj7620u2_handle, PAJ7620U2_BANK_0);
     return ESP_OK;
@@ -232,8 +359,8 @@ esp_err_t PAJ7620U2_GestureGetState(PAJ7620U2_handle_t paj7620u2_handle, uint16_
         return ESP_FAIL;
     }
 
-    I2cMaster_ReadReg(paj7620u2_handle->i2c_handle, paj7620u2_handle->i2c_addr, 
-                      PAJ7620U2_GET_INT_FLAG1, data_buf, 2);
+    err = I2cMaster_ReadReg(paj7620u2_handle->i2c_handle, paj7620u2_handle->i2c_addr, 
+                            PAJ7620U2_GET_INT_FLAG1, data_buf, 2);
     if(ESP_OK != err){
         return ESP_FAIL;
     }
@@ -251,21 +378,15 @@ esp_err_t PAJ7620U2_GestureGetState(PAJ7620U2_handle_t paj7620u2_handle, uint16_
 esp_err_t PAJ7620U2_ApproachInit(PAJ7620U2_handle_t paj7620u2_handle)
 {
     esp_err_t err = ESP_OK;
-    uint8_t reg_buf = 0x00;
-    uint8_t val_buf = 0x00;
 
     PAJ7620U2_HANDLE_CHECK(paj7620u2_handle, ESP_FAIL);
 
     paj7620u2_select_bank(paj7620u2_handle, PAJ7620U2_BANK_0);
-    for (uint32_t i=0; i<sizeof(proximity_array)/2; i++) {
-        reg_buf = proximity_array[i][0];
-        val_buf = proximity_array[i][1];
-        err = I2cMaster_WriteReg(paj7620u2_handle->i2c_handle, paj7620u2_handle->i2c_addr, 
-                                 reg_buf, &val_buf, 1);    
-        if (ESP_OK != err) {
-            ESP_LOGE(TAG, "%s (%d) paj7620u2 send gesture init array failed.", __FUNCTION__, __LINE__);
-            return ESP_FAIL;
-        }
+    err = I2cMaster_WriteRegTable(paj7620u2_handle->i2c_handle, paj7620u2_handle->i2c_addr, 
+                                  proximity_table, sizeof(proximity_table));
+    if (ESP_OK != err) {
+        ESP_LOGE(TAG, "%s (%d) paj7620u2 send approach init array failed.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
     }
     paj7620u2_select_bank(paj7620u2_handle, PAJ7620U2_BANK_0);
     return ESP_OK;
@@ -281,21 +402,226 @@ esp_err_t PAJ7620U2_ApproachInit(PAJ7620U2_handle_t paj7620u2_handle)
   */
 esp_err_t PAJ7620U2_ApproachGetData(PAJ7620U2_handle_t paj7620u2_handle, uint8_t *obj_brightness, 
                                uint16_t *obj_size)
+{
+    PAJ7620U2_HANDLE_CHECK(paj7620u2_handle, ESP_FAIL);
+    if (NULL == obj_brightness || NULL == obj_size) {
+        return ESP_FAIL;
+    }
+
+    return paj7620u2_read_approach(paj7620u2_handle, obj_brightness, obj_size);
+}
+
+/**
+  * @brief  PAJ7620U2 Enable the gesture INT pin interrupt.
+  *         The ISR wakes a worker task, which reads both gesture flag registers in one 
+  *         transfer and posts one event per detected gesture to the handle queue.
+  *         Use PAJ7620U2_GestureWaitEvent() to receive them.
+  * @param[in]  paj7620u2_handle  paj7620u2 operation handle.
+  * @param[in]  int_pin  gpio connected to the INT pin.
+  * @param[in]  task_priority  worker task priority.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Make sure to perform gesture recognition initialization before using 
+  *        this function.
+  * @note  int_pin is set up by I2cMaster_IntPinSetup(). INT stays low until the gesture flags are read.
+  */
+esp_err_t PAJ7620U2_GestureIntrEnable(PAJ7620U2_handle_t paj7620u2_handle, gpio_num_t int_pin, 
+                                      UBaseType_t task_priority)
 {
     esp_err_t err = ESP_OK;
-    uint8_t data_buf[3] = {0};
 
     PAJ7620U2_HANDLE_CHECK(paj7620u2_handle, ESP_FAIL);
-    if (NULL == obj_brightness || NULL == obj_size) {
+    if (NULL != paj7620u2_handle->int_task) {
+        ESP_LOGE(TAG, "%s (%d) gesture interrupt has been enabled.", __FUNCTION__, __LINE__);
         return ESP_FAIL;
     }
 
-    err = I2cMaster_ReadReg(paj7620u2_handle->i2c_handle, paj7620u2_handle->i2c_addr, 
-                      PAJ7620U2_GET_OBJECT_BRIGHTNESS, data_buf, 3);
-    if(ESP_OK != err){
+    paj7620u2_handle->event_queue = xQueueCreate(PAJ7620U2_EVENT_QUEUE_LEN, 
+                                                 sizeof(PAJ7620U2_GestureEvent_t));
+    if (NULL == paj7620u2_handle->event_queue) {
+        ESP_LOGE(TAG, "%s (%d) gesture event queue create failed.", __FUNCTION__, __LINE__);
         return ESP_FAIL;
     }
-    *obj_brightness = data_buf[0];
-    *obj_size = ((uint16_t)data_buf[2] & 0x0f)<<8 | data_buf[1];
+    paj7620u2_handle->int_pin = int_pin;
+    paj7620u2_handle->int_task_exit = false;
+    if (pdPASS != xTaskCreate(paj7620u2_int_task, "paj7620u2_int", PAJ7620U2_INT_TASK_STACK_SIZE, 
+                              paj7620u2_handle, task_priority, &paj7620u2_handle->int_task)) {
+        ESP_LOGE(TAG, "%s (%d) gesture worker task create failed.", __FUNCTION__, __LINE__);
+        paj7620u2_handle->int_task = NULL;
+        goto PAJ7620U2_INTR_ENABLE_FAILED;
+    }
+
+    // INT falls when a gesture flag is set, the ISR keeps the time of the edge.
+    err = I2cMaster_IntPinSetup(int_pin, GPIO_INTR_NEGEDGE, paj7620u2_int_isr_handler, paj7620u2_handle);
+    if (ESP_OK != err) {
+        goto PAJ7620U2_INTR_ENABLE_FAILED;
+    }
+    // A gesture flagged before the handler was added pulls INT low without an edge to catch.
+    if (0 == gpio_get_level(int_pin)) {
+        paj7620u2_handle->int_time_us = esp_timer_get_time();
+        xTaskNotifyGive(paj7620u2_handle->int_task);
+    }
+
+    ESP_LOGI(TAG, "%s (%d) paj7620u2 gesture interrupt enable ok.", __FUNCTION__, __LINE__);
+    return ESP_OK;
+
+PAJ7620U2_INTR_ENABLE_FAILED:
+    ESP_LOGE(TAG, "%s (%d) gesture interrupt enable failed.", __FUNCTION__, __LINE__);
+    I2cMaster_IntPinRelease(-1, &paj7620u2_handle->int_task, &paj7620u2_handle->int_task_exit);
+    vQueueDelete(paj7620u2_handle->event_queue);
+    paj7620u2_handle->event_queue = NULL;
+    paj7620u2_handle->int_pin = -1;
+    return ESP_FAIL;
+}
+
+/**
+  * @brief  PAJ7620U2 Disable the gesture INT pin interrupt and stop the worker task.
+  * @param[in]  paj7620u2_handle  paj7620u2 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by the interrupt not being enabled.
+  */
+esp_err_t PAJ7620U2_GestureIntrDisable(PAJ7620U2_handle_t paj7620u2_handle)
+{
+    PAJ7620U2_HANDLE_CHECK(paj7620u2_handle, ESP_FAIL);
+    if (NULL == paj7620u2_handle->int_task) {
+        ESP_LOGE(TAG, "%s (%d) gesture interrupt is not enabled.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    // The queue is deleted only after the worker posted its last events.
+    I2cMaster_IntPinRelease(paj7620u2_handle->int_pin, &paj7620u2_handle->int_task, 
+                            &paj7620u2_handle->int_task_exit);
+    paj7620u2_handle->int_pin = -1;
+    vQueueDelete(paj7620u2_handle->event_queue);
+    paj7620u2_handle->event_queue = NULL;
+    return ESP_OK;
+}
+
+/**
+  * @brief  PAJ7620U2 Wait for a gesture event.
+  * @param[in]  paj7620u2_handle  paj7620u2 operation handle.
+  * @param[out]  gesture_event  gesture event.
+  * @param[in]  wait_ticks  maximum ticks to wait.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_ERR_TIMEOUT  no gesture within wait_ticks.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t PAJ7620U2_GestureWaitEvent(PAJ7620U2_handle_t paj7620u2_handle, 
+                                     PAJ7620U2_GestureEvent_t *gesture_event, TickType_t wait_ticks)
+{
+    PAJ7620U2_HANDLE_CHECK(paj7620u2_handle, ESP_FAIL);
+    if (NULL == paj7620u2_handle->event_queue || NULL == gesture_event) {
+        return ESP_FAIL;
+    }
+
+    if (pdTRUE != xQueueReceive(paj7620u2_handle->event_queue, gesture_event, wait_ticks)) {
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
+}
+
+/**
+  * @brief  PAJ7620U2 Start object proximity streaming.
+  *         A task reads brightness and size in one transfer every frame, applies the 
+  *         hysteresis thresholds and posts enter/leave events to the handle queue.
+  *         Use PAJ7620U2_ApproachWaitEvent() to receive them.
+  * @param[in]  paj7620u2_handle  paj7620u2 operation handle.
+  * @param[in]  stream_config  streaming configuration.
+  * @param[in]  task_priority  streaming task priority.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by leave_brightness > enter_brightness.
+  * @note  Make sure to perform object proximity measurement mode initialization 
+  *        before using this function.
+  */
+esp_err_t PAJ7620U2_ApproachStreamStart(PAJ7620U2_handle_t paj7620u2_handle, 
+                                        const PAJ7620U2_ApproachStreamConfig_t *stream_config, 
+                                        UBaseType_t task_priority)
+{
+    PAJ7620U2_HANDLE_CHECK(paj7620u2_handle, ESP_FAIL);
+    if (NULL == stream_config) {
+        return ESP_FAIL;
+    }
+    if (stream_config->leave_brightness > stream_config->enter_brightness) {
+        ESP_LOGE(TAG, "%s (%d) leave threshold must not exceed enter threshold.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+    if (NULL != paj7620u2_handle->stream_task) {
+        ESP_LOGE(TAG, "%s (%d) approach streaming has been started.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    paj7620u2_handle->approach_queue = xQueueCreate(PAJ7620U2_EVENT_QUEUE_LEN, 
+                                                    sizeof(PAJ7620U2_ApproachEvent_t));
+    if (NULL == paj7620u2_handle->approach_queue) {
+        ESP_LOGE(TAG, "%s (%d) approach event queue create failed.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+    paj7620u2_handle->stream_config = *stream_config;
+    paj7620u2_handle->stream_task_exit = false;
+    if (pdPASS != xTaskCreate(paj7620u2_stream_task, "paj7620u2_stream", PAJ7620U2_INT_TASK_STACK_SIZE, 
+                              paj7620u2_handle, task_priority, &paj7620u2_handle->stream_task)) {
+        ESP_LOGE(TAG, "%s (%d) approach streaming task create failed.", __FUNCTION__, __LINE__);
+        paj7620u2_handle->stream_task = NULL;
+        vQueueDelete(paj7620u2_handle->approach_queue);
+        paj7620u2_handle->approach_queue = NULL;
+        return ESP_FAIL;
+    }
+    ESP_LOGI(TAG, "%s (%d) paj7620u2 approach streaming start ok.", __FUNCTION__, __LINE__);
+    return ESP_OK;
+}
+
+/**
+  * @brief  PAJ7620U2 Stop object proximity streaming.
+  * @param[in]  paj7620u2_handle  paj7620u2 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by streaming not being started.
+  */
+esp_err_t PAJ7620U2_ApproachStreamStop(PAJ7620U2_handle_t paj7620u2_handle)
+{
+    PAJ7620U2_HANDLE_CHECK(paj7620u2_handle, ESP_FAIL);
+    if (NULL == paj7620u2_handle->stream_task) {
+        ESP_LOGE(TAG, "%s (%d) approach streaming is not started.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    // The task exits after the current frame.
+    paj7620u2_handle->stream_task_exit = true;
+    while (NULL != paj7620u2_handle->stream_task) {
+        vTaskDelay(1);
+    }
+    vQueueDelete(paj7620u2_handle->approach_queue);
+    paj7620u2_handle->approach_queue = NULL;
+    return ESP_OK;
+}
+
+/**
+  * @brief  PAJ7620U2 Wait for an object proximity event.
+  * @param[in]  paj7620u2_handle  paj7620u2 operation handle.
+  * @param[out]  approach_event  object proximity event.
+  * @param[in]  wait_ticks  maximum ticks to wait.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_ERR_TIMEOUT  no event within wait_ticks.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t PAJ7620U2_ApproachWaitEvent(PAJ7620U2_handle_t paj7620u2_handle, 
+                                      PAJ7620U2_ApproachEvent_t *approach_event, TickType_t wait_ticks)
+{
+    PAJ7620U2_HANDLE_CHECK(paj7620u2_handle, ESP_FAIL);
+    if (NULL == paj7620u2_handle->approach_queue || NULL == approach_event) {
+        return ESP_FAIL;
+    }
+
+    if (pdTRUE != xQueueReceive(paj7620u2_handle->approach_queue, approach_event, wait_ticks)) {
+        return ESP_ERR_TIMEOUT;
+    }
     return ESP_OK;
 }
@@ -25,6 +25,10 @@
 #define __PCA9554_DRIVER_H
 
 #include "driver/i2c.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "../../i2c_master/include/i2c_master.h"
 
 #define PCA9554_INPUT_PORT_REGISTER           0x00    //PCA9554 input port register.
@@ -32,6 +36,9 @@
 #define PCA9554_POLARITY_INVERSION_REGISTER   0x02    //PCA9554 polarity inversion register.
 #define PCA9554_CONFIGURATION_REGISTER        0x03    //PCA9554 configuration register.
 
+#define PCA9554_INT_TASK_STACK_SIZE           (2048)  //INT worker task stack size.
+#define PCA9554_INT_RETRY_MS                  (10)    //Delay before reading the input port again after a failure(ms).
+
 // PCA9554 port number enum.
 typedef enum{
     PCA9554_PIN_0, 
@@ -57,9 +64,32 @@ typedef enum{
     PCA9554_PIN_LEVEL_HIG,
 }PCA9554_PinLevel_t;
 
+/**
+  * @brief  Input edge callback, called from the INT worker task after debouncing.
+  * @param[in]  pin  PCA9554 port number.
+  * @param[in]  level  new debounced port level.
+  * @param[in]  arg  user argument given when registering.
+  */
+typedef void (*PCA9554_EdgeCallback_t)(PCA9554_PinNum_t pin, PCA9554_PinLevel_t level, void *arg);
+
+typedef struct{
+    PCA9554_EdgeCallback_t callback;
+    void *arg;
+}PCA9554_EdgeHandler_t;
+
 typedef struct{
     I2cMaster_handle_t i2c_handle;
     uint8_t i2c_addr;
+    uint8_t output_shadow;          // Copy of the output port register.
+    uint8_t config_shadow;          // Copy of the configuration register.
+    SemaphoreHandle_t lock;         // Keeps the shadow registers and the device in step.
+    gpio_num_t int_pin;             // INT pin, -1 when the input service is not enabled.
+    volatile bool int_task_exit;    // Request the INT worker task to exit.
+    TaskHandle_t int_task;          // INT worker task.
+    uint8_t input_mask;             // Ports served by the input service.
+    uint32_t debounce_us;           // A port level must be stable this long, unit: us.
+    volatile uint8_t input_stable;  // Debounced input port levels.
+    PCA9554_EdgeHandler_t edge_handler[PCA9554_PIN_MAX];
 }PCA9554_t;
 typedef PCA9554_t *PCA9554_handle_t;
 
@@ -72,6 +102,8 @@ typedef PCA9554_t *PCA9554_handle_t;
   *         successful  pca9554 operation handle.
   *         failed      NULL.
   * @note  Use PCA9554_Deinit() to release it.
+  * @note  The output port and configuration registers are read once here and kept as 
+  *        shadow registers, later updates write them without reading back.
   */
 PCA9554_handle_t PCA9554_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr);
 
@@ -134,4 +166,117 @@ esp_err_t PCA9554_SetLevelHex(PCA9554_handle_t pca9554_handle, uint8_t level);
   */
 uint8_t PCA9554_GetLevelHex(PCA9554_handle_t pca9554_handle);
 
+/**
+  * @brief  PCA9554 Set, clear and toggle output levels in one write.
+  *         The new level is ((level | set_mask) & ~clear_mask) ^ toggle_mask.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @param[in]  set_mask  ports to drive high.
+  * @param[in]  clear_mask  ports to drive low.
+  * @param[in]  toggle_mask  ports to invert.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Nothing is written if the level does not change.
+  */
+esp_err_t PCA9554_UpdateLevelMask(PCA9554_handle_t pca9554_handle, uint8_t set_mask, 
+                                  uint8_t clear_mask, uint8_t toggle_mask);
+
+/**
+  * @brief  PCA9554 Drive the ports in mask high.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @param[in]  mask  ports to drive high.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t PCA9554_SetLevelMask(PCA9554_handle_t pca9554_handle, uint8_t mask);
+
+/**
+  * @brief  PCA9554 Drive the ports in mask low.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @param[in]  mask  ports to drive low.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t PCA9554_ClearLevelMask(PCA9554_handle_t pca9554_handle, uint8_t mask);
+
+/**
+  * @brief  PCA9554 Invert the ports in mask.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @param[in]  mask  ports to invert.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t PCA9554_ToggleLevelMask(PCA9554_handle_t pca9554_handle, uint8_t mask);
+
+/**
+  * @brief  PCA9554 Output a sequence of port levels back-to-back in one transaction.
+  *         The PCA9554 does not auto-increment the register address, every data byte 
+  *         after the command byte updates the output port on its acknowledge.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @param[in]  levels  port levels(8bit) in output order.
+  * @param[in]  len  number of port levels.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Each level is held for 9 SCL clocks, 22.5us at 400Kbit/s.
+  */
+esp_err_t PCA9554_WriteLevelSequence(PCA9554_handle_t pca9554_handle, const uint8_t *levels, uint32_t len);
+
+/**
+  * @brief  PCA9554 Get the last written level of all ports, without any I2C transfer.
+  * @param[in] pca9554_handle  pca9554 operation handle.
+  * @retval output port register.(8bit)
+  */
+uint8_t PCA9554_GetOutputHex(PCA9554_handle_t pca9554_handle);
+
+/**
+  * @brief  PCA9554 Start the INT driven input service.
+  *         The input port is read only when the INT pin falls, the levels are debounced 
+  *         per port and the edge callbacks are called from a worker task.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @param[in]  int_pin  gpio connected to the INT pin.
+  * @param[in]  pin_mask  ports to serve, they must be configured as inputs.
+  * @param[in]  debounce_ms  a port level must be stable this long before its callback is called.
+  * @param[in]  task_priority  worker task priority.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  int_pin is set up by I2cMaster_IntPinSetup(). INT stays low until the input port is read.
+  */
+esp_err_t PCA9554_InputIntrEnable(PCA9554_handle_t pca9554_handle, gpio_num_t int_pin, uint8_t pin_mask, 
+                                  uint32_t debounce_ms, UBaseType_t task_priority);
+
+/**
+  * @brief  PCA9554 Stop the INT driven input service.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by the input service not being enabled.
+  */
+esp_err_t PCA9554_InputIntrDisable(PCA9554_handle_t pca9554_handle);
+
+/**
+  * @brief  PCA9554 Register the edge callback of a port, NULL removes it.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @param[in]  pin  PCA9554 port number.
+  * @param[in]  callback  edge callback.
+  * @param[in]  arg  user argument passed to the callback.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t PCA9554_RegisterEdgeCallback(PCA9554_handle_t pca9554_handle, PCA9554_PinNum_t pin, 
+                                       PCA9554_EdgeCallback_t callback, void *arg);
+
+/**
+  * @brief  PCA9554 Get the debounced input levels of the input service, without any I2C transfer.
+  * @param[in] pca9554_handle  pca9554 operation handle.
+  * @retval debounced port levels.(8bit)
+  */
+uint8_t PCA9554_GetDebouncedLevelHex(PCA9554_handle_t pca9554_handle);
+
 #endif /* __PCA9554_DRIVER_H */
\ No newline at end of file
@@ -23,10 +23,14 @@
 
 #include "pca9554_driver.h"
 #include <stdio.h>
+#include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
 #include "esp_log.h"
 #include "esp_err.h"
+#include "../i2c_master/include/i2c_master_int.h"
 
 static const char *TAG = "PCA9554";
 
@@ -35,6 +39,97 @@ static const char *TAG = "PCA9554";
         return (ret);                                                            \
         }
 
+// Protects the edge handler table against the INT worker task.
+static portMUX_TYPE pca9554_edge_spinlock = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+  * @brief  INT pin interrupt service, wake the worker task.
+  * @param[in]  arg  pca9554 operation handle.
+  */
+static void IRAM_ATTR pca9554_int_isr_handler(void *arg)
+{
+    PCA9554_handle_t pca9554_handle = (PCA9554_handle_t)arg;
+    BaseType_t task_woken = pdFALSE;
+
+    vTaskNotifyGiveFromISR(pca9554_handle->int_task, &task_woken);
+    if (pdTRUE == task_woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+  * @brief  INT worker task.
+  *         On INT the input port is read(this also releases the INT pin) and the changed 
+  *         ports restart their debounce time. The INT pin falls again on any further 
+  *         change, so a port whose debounce time expires without a new INT is stable and 
+  *         needs no extra read.
+  *         A failed read leaves INT low without a further edge, so it is retried every 
+  *         PCA9554_INT_RETRY_MS until it succeeds.
+  * @param[in]  arg  pca9554 operation handle.
+  */
+static void pca9554_int_task(void *arg)
+{
+    PCA9554_handle_t pca9554_handle = (PCA9554_handle_t)arg;
+    PCA9554_EdgeHandler_t handler;
+    int64_t change_time[PCA9554_PIN_MAX] = {0};
+    int64_t now = 0, deadline = 0;
+    uint8_t input_raw = pca9554_handle->input_stable;
+    uint8_t input = 0, pending = 0, bit = 0;
+    bool read_retry = false;
+    TickType_t wait = portMAX_DELAY;
+
+    while (false == pca9554_handle->int_task_exit) {
+        uint32_t notified = ulTaskNotifyTake(pdTRUE, wait);
+        if (true == pca9554_handle->int_task_exit) {
+            break;
+        }
+        now = esp_timer_get_time();
+        if (0 != notified || read_retry) {
+            read_retry = (ESP_OK != I2cMaster_ReadReg(pca9554_handle->i2c_handle, pca9554_handle->i2c_addr, 
+                                                      PCA9554_INPUT_PORT_REGISTER, &input, 1));
+            if (false == read_retry) {
+                for (uint8_t pin = 0; pin < PCA9554_PIN_MAX; pin++) {
+                    if ((input ^ input_raw) & pca9554_handle->input_mask & (0x1 << pin)) {
+                        change_time[pin] = now;
+                    }
+                }
+                input_raw = input;
+            } else {
+                ESP_LOGE(TAG, "%s (%d) read input port failed.", __FUNCTION__, __LINE__);
+            }
+        }
+
+        // Commit the ports that have been stable for the debounce time.
+        wait = portMAX_DELAY;
+        pending = (input_raw ^ pca9554_handle->input_stable) & pca9554_handle->input_mask;
+        for (uint8_t pin = 0; pin < PCA9554_PIN_MAX; pin++) {
+            bit = 0x1 << pin;
+            if (0 == (pending & bit)) {
+                continue;
+            }
+            deadline = change_time[pin] + pca9554_handle->debounce_us;
+            if (now < deadline) {
+                TickType_t ticks = (deadline - now + 999) / 1000 / portTICK_PERIOD_MS + 1;
+                wait = (ticks < wait) ? ticks : wait;
+                continue;
+            }
+            pca9554_handle->input_stable ^= bit;
+            taskENTER_CRITICAL(&pca9554_edge_spinlock);
+            handler = pca9554_handle->edge_handler[pin];
+            taskEXIT_CRITICAL(&pca9554_edge_spinlock);
+            if (NULL != handler.callback) {
+                handler.callback((PCA9554_PinNum_t)pin, (input_raw & bit) ? PCA9554_PIN_LEVEL_HIG : 
+                                 PCA9554_PIN_LEVEL_LOW, handler.arg);
+            }
+        }
+        if (true == read_retry && wait > pdMS_TO_TICKS(PCA9554_INT_RETRY_MS)) {
+            wait = pdMS_TO_TICKS(PCA9554_INT_RETRY_MS);
+        }
+    }
+    pca9554_handle->int_task = NULL;
+    vTaskDelete(NULL);
+}
+
 /**
   * @brief  Initialize the PCA9554 and obtain an operation handle.
   * @param[in]  i2c_handle  i2c master operation handle.
@@ -44,6 +139,8 @@ static const char *TAG = "PCA9554";
   *         successful  pca9554 operation handle.
   *         failed      NULL.
   * @note  Use PCA9554_Deinit() to release it.
+  * @note  The output port and configuration registers are read once here and kept as 
+  *        shadow registers, later updates write them without reading back.
   */
 PCA9554_handle_t PCA9554_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr)
 {
@@ -67,9 +164,37 @@ PCA9554_handle_t PCA9554_Init(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr)
     }
     pca9554_handle->i2c_handle = i2c_handle;
     pca9554_handle->i2c_addr = i2c_addr;
+    pca9554_handle->int_pin = -1;
+    pca9554_handle->int_task_exit = false;
+    pca9554_handle->int_task = NULL;
+    pca9554_handle->input_mask = 0;
+    pca9554_handle->debounce_us = 0;
+    pca9554_handle->input_stable = 0;
+    memset(pca9554_handle->edge_handler, 0, sizeof(pca9554_handle->edge_handler));
+    pca9554_handle->lock = xSemaphoreCreateMutex();
+    if (NULL == pca9554_handle->lock) {
+        goto PCA9554_INIT_FAILED;
+    }
+    // Load the shadow registers.
+    if (ESP_OK != I2cMaster_ReadReg(i2c_handle, i2c_addr, PCA9554_OUTPUT_PORT_REGISTER, 
+                                    &pca9554_handle->output_shadow, 1)) {
+        goto PCA9554_INIT_FAILED;
+    }
+    if (ESP_OK != I2cMaster_ReadReg(i2c_handle, i2c_addr, PCA9554_CONFIGURATION_REGISTER, 
+                                    &pca9554_handle->config_shadow, 1)) {
+        goto PCA9554_INIT_FAILED;
+    }
 
     ESP_LOGI(TAG, "%s (%d) pca9554 init ok.", __FUNCTION__, __LINE__);
     return pca9554_handle;
+
+PCA9554_INIT_FAILED:
+    if (NULL != pca9554_handle->lock) {
+        vSemaphoreDelete(pca9554_handle->lock);
+    }
+    free(pca9554_handle);
+    ESP_LOGE(TAG, "%s (%d) pca9554 init failed.", __FUNCTION__, __LINE__);
+    return NULL;
 }
 
 /**
@@ -83,6 +208,10 @@ esp_err_t PCA9554_Deinit(PCA9554_handle_t* pca9554_handle)
 {
     PCA9554_HANDLE_CHECK(*pca9554_handle, ESP_FAIL);
 
+    if (NULL != (*pca9554_handle)->int_task) {
+        PCA9554_InputIntrDisable(*pca9554_handle);
+    }
+    vSemaphoreDelete((*pca9554_handle)->lock);
     free(*pca9554_handle);
     *pca9554_handle = NULL;
     ESP_LOGI(TAG, "%s (%d) pca9554 handle deinit ok.", __FUNCTION__, __LINE__);
@@ -106,18 +235,19 @@ esp_err_t PCA9554_ConfigPinDirection(PCA9554_handle_t pca9554_handle,
 
     PCA9554_HANDLE_CHECK(pca9554_handle, ESP_FAIL);
 
-    // Read the current configuration status.
-    ret = I2cMaster_ReadReg(pca9554_handle->i2c_handle, pca9554_handle->i2c_addr, 
-                            PCA9554_CONFIGURATION_REGISTER, &data_buf, 1);
-    if (ret != ESP_OK) {
-        return ESP_FAIL;
-    }
-
+    xSemaphoreTake(pca9554_handle->lock, portMAX_DELAY);
     // Clear the bit to be configured and write the new configuration.
+    data_buf = pca9554_handle->config_shadow;
     data_buf &= ~(0x1 << pin);
     data_buf |= (dir << pin);
-    ret = I2cMaster_WriteReg(pca9554_handle->i2c_handle, pca9554_handle->i2c_addr, 
-                             PCA9554_CONFIGURATION_REGISTER, &data_buf, 1);
+    if (data_buf != pca9554_handle->config_shadow) {
+        ret = I2cMaster_WriteReg(pca9554_handle->i2c_handle, pca9554_handle->i2c_addr, 
+                                 PCA9554_CONFIGURATION_REGISTER, &data_buf, 1);
+        if (ESP_OK == ret) {
+            pca9554_handle->config_shadow = data_buf;
+        }
+    }
+    xSemaphoreGive(pca9554_handle->lock);
     if (ret != ESP_OK) {
         return ESP_FAIL;
     }
@@ -136,25 +266,12 @@ esp_err_t PCA9554_ConfigPinDirection(PCA9554_handle_t pca9554_handle,
 esp_err_t PCA9554_SetPinLevel(PCA9554_handle_t pca9554_handle, PCA9554_PinNum_t pin, 
                               PCA9554_PinLevel_t level)
 {   
-    esp_err_t err = 0;
-    uint8_t data_buf = 0;
-    
-    // Read the current configuration status.
-    err = I2cMaster_ReadReg(pca9554_handle->i2c_handle, pca9554_handle->i2c_addr, 
-                            PCA9554_OUTPUT_PORT_REGISTER, &data_buf, 1);
-    if (err != ESP_OK) {
-        return ESP_FAIL;
-    }
+    PCA9554_HANDLE_CHECK(pca9554_handle, ESP_FAIL);
 
-    // Clear the bit to be configured and write the new configuration.
-    data_buf &= ~(0x1 << pin);
-    data_buf |= (level << pin);
-    err = I2cMaster_WriteReg(pca9554_handle->i2c_handle, pca9554_handle->i2c_addr, 
-                             PCA9554_OUTPUT_PORT_REGISTER, &data_buf, 1);
-    if (err != ESP_OK) {
-        return ESP_FAIL;
+    if (PCA9554_PIN_LEVEL_LOW == level) {
+        return PCA9554_UpdateLevelMask(pca9554_handle, 0, 0x1 << pin, 0);
     }
-    return ESP_OK;
+    return PCA9554_UpdateLevelMask(pca9554_handle, 0x1 << pin, 0, 0);
 }
 
 /**
@@ -193,8 +310,13 @@ esp_err_t PCA9554_SetLevelHex(PCA9554_handle_t pca9554_handle, uint8_t level)
 
     PCA9554_HANDLE_CHECK(pca9554_handle, ESP_FAIL);
 
+    xSemaphoreTake(pca9554_handle->lock, portMAX_DELAY);
     err = I2cMaster_WriteReg(pca9554_handle->i2c_handle, pca9554_handle->i2c_addr, 
-                       PCA9554_OUTPUT_PORT_REGISTER, &buf, 1);
+                             PCA9554_OUTPUT_PORT_REGISTER, &buf, 1);
+    if (ESP_OK == err) {
+        pca9554_handle->output_shadow = level;
+    }
+    xSemaphoreGive(pca9554_handle->lock);
     if (ESP_OK != err) {
         return ESP_FAIL;
     }
@@ -213,4 +335,253 @@ uint8_t PCA9554_GetLevelHex(PCA9554_handle_t pca9554_handle)
     I2cMaster_ReadReg(pca9554_handle->i2c_handle, pca9554_handle->i2c_addr, 
                       PCA9554_INPUT_PORT_REGISTER, &data_buf, 1);
     return data_buf;
-}
\ No newline at end of file
+}
+
+/**
+  * @brief  PCA9554 Set, clear and toggle output levels in one write.
+  *         The new level is ((level | set_mask) & ~clear_mask) ^ toggle_mask.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @param[in]  set_mask  ports to drive high.
+  * @param[in]  clear_mask  ports to drive low.
+  * @param[in]  toggle_mask  ports to invert.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Nothing is written if the level does not change.
+  */
+esp_err_t PCA9554_UpdateLevelMask(PCA9554_handle_t pca9554_handle, uint8_t set_mask, 
+                                  uint8_t clear_mask, uint8_t toggle_mask)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t data_buf = 0;
+
+    PCA9554_HANDLE_CHECK(pca9554_handle, ESP_FAIL);
+
+    xSemaphoreTake(pca9554_handle->lock, portMAX_DELAY);
+    data_buf = ((pca9554_handle->output_shadow | set_mask) & ~clear_mask) ^ toggle_mask;
+    if (data_buf != pca9554_handle->output_shadow) {
+        err = I2cMaster_WriteReg(pca9554_handle->i2c_handle, pca9554_handle->i2c_addr, 
+                                 PCA9554_OUTPUT_PORT_REGISTER, &data_buf, 1);
+        if (ESP_OK == err) {
+            pca9554_handle->output_shadow = data_buf;
+        }
+    }
+    xSemaphoreGive(pca9554_handle->lock);
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/**
+  * @brief  PCA9554 Drive the ports in mask high.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @param[in]  mask  ports to drive high.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t PCA9554_SetLevelMask(PCA9554_handle_t pca9554_handle, uint8_t mask)
+{
+    return PCA9554_UpdateLevelMask(pca9554_handle, mask, 0, 0);
+}
+
+/**
+  * @brief  PCA9554 Drive the ports in mask low.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @param[in]  mask  ports to drive low.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t PCA9554_ClearLevelMask(PCA9554_handle_t pca9554_handle, uint8_t mask)
+{
+    return PCA9554_UpdateLevelMask(pca9554_handle, 0, mask, 0);
+}
+
+/**
+  * @brief  PCA9554 Invert the ports in mask.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @param[in]  mask  ports to invert.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t PCA9554_ToggleLevelMask(PCA9554_handle_t pca9554_handle, uint8_t mask)
+{
+    return PCA9554_UpdateLevelMask(pca9554_handle, 0, 0, mask);
+}
+
+/**
+  * @brief  PCA9554 Output a sequence of port levels back-to-back in one transaction.
+  *         The PCA9554 does not auto-increment the register address, every data byte 
+  *         after the command byte updates the output port on its acknowledge.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @param[in]  levels  port levels(8bit) in output order.
+  * @param[in]  len  number of port levels.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Each level is held for 9 SCL clocks, 22.5us at 400Kbit/s.
+  */
+esp_err_t PCA9554_WriteLevelSequence(PCA9554_handle_t pca9554_handle, const uint8_t *levels, uint32_t len)
+{
+    esp_err_t err = ESP_OK;
+
+    PCA9554_HANDLE_CHECK(pca9554_handle, ESP_FAIL);
+    if (NULL == levels || 0 == len) {
+        return ESP_FAIL;
+    }
+
+    xSemaphoreTake(pca9554_handle->lock, portMAX_DELAY);
+    err = I2cMaster_WriteReg(pca9554_handle->i2c_handle, pca9554_handle->i2c_addr, 
+                             PCA9554_OUTPUT_PORT_REGISTER, (uint8_t*)levels, len);
+    if (ESP_OK == err) {
+        pca9554_handle->output_shadow = levels[len - 1];
+    }
+    xSemaphoreGive(pca9554_handle->lock);
+    if (ESP_OK != err) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/**
+  * @brief  PCA9554 Get the last written level of all ports, without any I2C transfer.
+  * @param[in] pca9554_handle  pca9554 operation handle.
+  * @retval output port register.(8bit)
+  */
+uint8_t PCA9554_GetOutputHex(PCA9554_handle_t pca9554_handle)
+{
+    PCA9554_HANDLE_CHECK(pca9554_handle, 0);
+
+    return pca9554_handle->output_shadow;
+}
+
+/**
+  * @brief  PCA9554 Start the INT driven input service.
+  *         The input port is read only when the INT pin falls, the levels are debounced 
+  *         per port and the edge callbacks are called from a worker task.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @param[in]  int_pin  gpio connected to the INT pin.
+  * @param[in]  pin_mask  ports to serve, they must be configured as inputs.
+  * @param[in]  debounce_ms  a port level must be stable this long before its callback is called.
+  * @param[in]  task_priority  worker task priority.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  int_pin is set up by I2cMaster_IntPinSetup(). INT stays low until the input port is read.
+  */
+esp_err_t PCA9554_InputIntrEnable(PCA9554_handle_t pca9554_handle, gpio_num_t int_pin, uint8_t pin_mask, 
+                                  uint32_t debounce_ms, UBaseType_t task_priority)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t input = 0;
+
+    PCA9554_HANDLE_CHECK(pca9554_handle, ESP_FAIL);
+    if (NULL != pca9554_handle->int_task) {
+        ESP_LOGE(TAG, "%s (%d) input service has been enabled.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+    if (0 == pin_mask || (pin_mask & ~pca9554_handle->config_shadow)) {
+        ESP_LOGE(TAG, "%s (%d) ports are not configured as inputs.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    // The first read gives the initial levels and releases the INT pin.
+    if (ESP_OK != I2cMaster_ReadReg(pca9554_handle->i2c_handle, pca9554_handle->i2c_addr, 
+                                    PCA9554_INPUT_PORT_REGISTER, &input, 1)) {
+        return ESP_FAIL;
+    }
+    pca9554_handle->input_stable = input;
+    pca9554_handle->input_mask = pin_mask;
+    pca9554_handle->debounce_us = debounce_ms * 1000;
+    pca9554_handle->int_task_exit = false;
+    if (pdPASS != xTaskCreate(pca9554_int_task, "pca9554_int", PCA9554_INT_TASK_STACK_SIZE, 
+                              pca9554_handle, task_priority, &pca9554_handle->int_task)) {
+        ESP_LOGE(TAG, "%s (%d) input worker task create failed.", __FUNCTION__, __LINE__);
+        pca9554_handle->int_task = NULL;
+        goto PCA9554_INTR_ENABLE_FAILED;
+    }
+
+    // INT falls when an input differs from the last read port value.
+    err = I2cMaster_IntPinSetup(int_pin, GPIO_INTR_NEGEDGE, pca9554_int_isr_handler, pca9554_handle);
+    if (ESP_OK != err) {
+        goto PCA9554_INTR_ENABLE_FAILED;
+    }
+    pca9554_handle->int_pin = int_pin;
+    // A change after the first read left the pin low without an edge.
+    if (0 == gpio_get_level(int_pin)) {
+        xTaskNotifyGive(pca9554_handle->int_task);
+    }
+
+    ESP_LOGI(TAG, "%s (%d) pca9554 input service enable ok.", __FUNCTION__, __LINE__);
+    return ESP_OK;
+
+PCA9554_INTR_ENABLE_FAILED:
+    ESP_LOGE(TAG, "%s (%d) input service enable failed.", __FUNCTION__, __LINE__);
+    I2cMaster_IntPinRelease(-1, &pca9554_handle->int_task, &pca9554_handle->int_task_exit);
+    pca9554_handle->input_mask = 0;
+    return ESP_FAIL;
+}
+
+/**
+  * @brief  PCA9554 Stop the INT driven input service.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  *                     May be caused by the input service not being enabled.
+  */
+esp_err_t PCA9554_InputIntrDisable(PCA9554_handle_t pca9554_handle)
+{
+    PCA9554_HANDLE_CHECK(pca9554_handle, ESP_FAIL);
+    if (NULL == pca9554_handle->int_task) {
+        ESP_LOGE(TAG, "%s (%d) input service is not enabled.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    // Edges still in their debounce time are dropped, no callback is called for them.
+    I2cMaster_IntPinRelease(pca9554_handle->int_pin, &pca9554_handle->int_task, 
+                            &pca9554_handle->int_task_exit);
+    pca9554_handle->int_pin = -1;
+    pca9554_handle->input_mask = 0;
+    return ESP_OK;
+}
+
+/**
+  * @brief  PCA9554 Register the edge callback of a port, NULL removes it.
+  * @param[in]  pca9554_handle  pca9554 operation handle.
+  * @param[in]  pin  PCA9554 port number.
+  * @param[in]  callback  edge callback.
+  * @param[in]  arg  user argument passed to the callback.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t PCA9554_RegisterEdgeCallback(PCA9554_handle_t pca9554_handle, PCA9554_PinNum_t pin, 
+                                       PCA9554_EdgeCallback_t callback, void *arg)
+{
+    PCA9554_HANDLE_CHECK(pca9554_handle, ESP_FAIL);
+    if (pin >= PCA9554_PIN_MAX) {
+        return ESP_FAIL;
+    }
+
+    taskENTER_CRITICAL(&pca9554_edge_spinlock);
+    pca9554_handle->edge_handler[pin].callback = callback;
+    pca9554_handle->edge_handler[pin].arg = arg;
+    taskEXIT_CRITICAL(&pca9554_edge_spinlock);
+    return ESP_OK;
+}
+
+/**
+  * @brief  PCA9554 Get the debounced input levels of the input service, without any I2C transfer.
+  * @param[in] pca9554_handle  pca9554 operation handle.
+  * @retval debounced port levels.(8bit)
+  */
+uint8_t PCA9554_GetDebouncedLevelHex(PCA9554_handle_t pca9554_handle)
+{
+    PCA9554_HANDLE_CHECK(pca9554_handle, 0);
+
+    return pca9554_handle->input_stable;
+}
@@ -0,0 +1,219 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           audio_sampler.c
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#include "audio_sampler.h"
+#include "esp_log.h"
+
+static const char *TAG = "audio_sampler";
+
+#define AUDIO_SAMPLER_HANDLE_CHECK(a, ret)  if (NULL == a) {                     \
+        ESP_LOGE(TAG, "%s (%d) driver handle is NULL.", __FUNCTION__, __LINE__); \
+        return (ret);                                                            \
+        }
+
+#define AUDIO_SAMPLER_READ_CHUNK        64      // Samples per i2s_read.
+
+/**
+  * @brief  Read task, converts the DMA samples into the block being filled.
+  * @param[in]  arg  sampler handle.
+  */
+static void audio_sampler_read_task(void *arg)
+{
+    AudioSampler_handle_t sampler = (AudioSampler_handle_t)arg;
+    uint16_t raw[AUDIO_SAMPLER_READ_CHUNK];
+    size_t bytes_read = 0;
+
+    while (false == sampler->task_exit) {
+        if (ESP_OK != i2s_read(AUDIO_SAMPLER_I2S_NUM, raw, sizeof(raw), &bytes_read, 
+                               AUDIO_SAMPLER_READ_TIMEOUT_MS / portTICK_PERIOD_MS)) {
+            continue;
+        }
+        // The I2S ADC mode delivers the samples of each 32 bit word in swapped order.
+        for (uint32_t i=0; i+1<bytes_read/sizeof(uint16_t); i+=2) {
+            uint16_t tmp = raw[i];
+            raw[i] = raw[i + 1];
+            raw[i + 1] = tmp;
+        }
+        for (uint32_t i=0; i<bytes_read/sizeof(uint16_t); i++) {
+            // 12 bit sample in the low bits, the channel number in the high 4 bits.
+            sampler->block[sampler->fill_index][sampler->fill++] = ((int16_t)(raw[i] & 0x0FFF) - 2048) * 16;
+            if (sampler->fill < sampler->block_len) {
+                continue;
+            }
+            sampler->fill = 0;
+            if (sampler->busy) {
+                sampler->overruns++;
+                continue;
+            }
+            sampler->ready_index = sampler->fill_index;
+            sampler->busy = true;
+            sampler->fill_index ^= 1;
+            xTaskNotifyGive(sampler->process_task);
+        }
+    }
+    sampler->read_task = NULL;
+    vTaskDelete(NULL);
+}
+
+/**
+  * @brief  Process task, hands each full block to the callback.
+  * @param[in]  arg  sampler handle.
+  */
+static void audio_sampler_process_task(void *arg)
+{
+    AudioSampler_handle_t sampler = (AudioSampler_handle_t)arg;
+
+    while (false == sampler->task_exit) {
+        if (0 == ulTaskNotifyTake(pdTRUE, AUDIO_SAMPLER_READ_TIMEOUT_MS / portTICK_PERIOD_MS)) {
+            continue;
+        }
+        if (true == sampler->task_exit) {
+            break;
+        }
+        sampler->callback(sampler->block[sampler->ready_index], sampler->block_len, sampler->arg);
+        sampler->busy = false;
+    }
+    sampler->process_task = NULL;
+    vTaskDelete(NULL);
+}
+
+/**
+  * @brief  Start sampling an ADC1 channel at a fixed rate.
+  * @param[in]  adc_channel  ADC1 channel, e.g. ADC1_CHANNEL_6(GPIO34).
+  * @param[in]  sample_rate  unit: Hz.
+  * @param[in]  block_len  samples per block, 64 ~ 1024.
+  * @param[in]  core_id  core of the read and process tasks.
+  * @param[in]  task_priority  process task priority, the read task runs one above.
+  * @param[in]  callback  block callback.
+  * @param[in]  arg  user argument of the callback.
+  * @retval  
+  *         successful  sampler handle.
+  *         failed      NULL.
+  * @note  The I2S DMA samples without the CPU, the read task only copies and converts 
+  *        the samples. A block that arrives while the callback still works on the 
+  *        previous one is dropped and counted in overruns.
+  * @note  ADC1 is used by I2S until AudioSampler_Deinit().
+  */
+AudioSampler_handle_t AudioSampler_Init(adc1_channel_t adc_channel, uint32_t sample_rate, uint16_t block_len, 
+                                        BaseType_t core_id, UBaseType_t task_priority, 
+                                        AudioSampler_BlockCallback_t callback, void *arg)
+{
+    esp_err_t err = ESP_OK;
+
+    if (NULL == callback || block_len < 64 || block_len > 1024 || 0 == sample_rate) {
+        ESP_LOGE(TAG, "%s (%d) invalid argument.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+
+    AudioSampler_handle_t sampler = calloc(1, sizeof(AudioSampler_t));
+    if (NULL == sampler) {
+        ESP_LOGE(TAG, "%s (%d) driver handle malloc failed.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+    sampler->block[0] = malloc(block_len * sizeof(int16_t));
+    sampler->block[1] = malloc(block_len * sizeof(int16_t));
+    if (NULL == sampler->block[0] || NULL == sampler->block[1]) {
+        ESP_LOGE(TAG, "%s (%d) block malloc failed.", __FUNCTION__, __LINE__);
+        goto AUDIO_SAMPLER_INIT_FAILED;
+    }
+    sampler->adc_channel = adc_channel;
+    sampler->sample_rate = sample_rate;
+    sampler->block_len = block_len;
+    sampler->callback = callback;
+    sampler->arg = arg;
+
+    i2s_config_t i2s_config = {
+        .mode = I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN,
+        .sample_rate = sample_rate,
+        .bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT,
+        .channel_format = I2S_CHANNEL_FMT_ONLY_LEFT,
+        .communication_format = I2S_COMM_FORMAT_I2S_MSB,
+        .intr_alloc_flags = 0,
+        .dma_buf_count = AUDIO_SAMPLER_DMA_BUF_COUNT,
+        .dma_buf_len = block_len,
+        .use_apll = false,
+    };
+    err = i2s_driver_install(AUDIO_SAMPLER_I2S_NUM, &i2s_config, 0, NULL);
+    if (ESP_OK != err) {
+        ESP_LOGE(TAG, "%s (%d) i2s driver install failed.", __FUNCTION__, __LINE__);
+        goto AUDIO_SAMPLER_INIT_FAILED;
+    }
+    adc1_config_channel_atten(adc_channel, ADC_ATTEN_DB_11);
+    i2s_set_adc_mode(ADC_UNIT_1, adc_channel);
+
+    sampler->task_exit = false;
+    if (pdPASS != xTaskCreatePinnedToCore(audio_sampler_process_task, "audio_process", 
+                                          AUDIO_SAMPLER_TASK_STACK_SIZE, sampler, task_priority, 
+                                          &sampler->process_task, core_id)) {
+        sampler->process_task = NULL;
+        goto AUDIO_SAMPLER_TASK_FAILED;
+    }
+    if (pdPASS != xTaskCreatePinnedToCore(audio_sampler_read_task, "audio_read", 
+                                          AUDIO_SAMPLER_TASK_STACK_SIZE, sampler, task_priority + 1, 
+                                          &sampler->read_task, core_id)) {
+        sampler->read_task = NULL;
+        goto AUDIO_SAMPLER_TASK_FAILED;
+    }
+    i2s_adc_enable(AUDIO_SAMPLER_I2S_NUM);
+    ESP_LOGI(TAG, "%s (%d) audio sampler init ok.", __FUNCTION__, __LINE__);
+    return sampler;
+
+AUDIO_SAMPLER_TASK_FAILED:
+    ESP_LOGE(TAG, "%s (%d) task create failed.", __FUNCTION__, __LINE__);
+    sampler->task_exit = true;
+    while (NULL != sampler->process_task || NULL != sampler->read_task) {
+        vTaskDelay(1);
+    }
+    i2s_driver_uninstall(AUDIO_SAMPLER_I2S_NUM);
+AUDIO_SAMPLER_INIT_FAILED:
+    free(sampler->block[1]);
+    free(sampler->block[0]);
+    free(sampler);
+    return NULL;
+}
+
+/**
+  * @brief  Stop sampling.
+  * @param[in]  sampler  sampler handle pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t AudioSampler_Deinit(AudioSampler_handle_t *sampler)
+{
+    AUDIO_SAMPLER_HANDLE_CHECK(*sampler, ESP_FAIL);
+
+    // The tasks leave within one read timeout.
+    (*sampler)->task_exit = true;
+    while (NULL != (*sampler)->process_task || NULL != (*sampler)->read_task) {
+        vTaskDelay(1);
+    }
+    i2s_adc_disable(AUDIO_SAMPLER_I2S_NUM);
+    i2s_driver_uninstall(AUDIO_SAMPLER_I2S_NUM);
+
+    free((*sampler)->block[1]);
+    free((*sampler)->block[0]);
+    free(*sampler);
+    *sampler = NULL;
+    return ESP_OK;
+}
@@ -0,0 +1,256 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           audio_spectrum.c
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#include "audio_spectrum.h"
+#include <stdlib.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI    3.14159265358979323846
+#endif
+
+// log2 band energy of a full scale sine, halved input, Hann window and 1/N scaled FFT: (32767/8)^2.
+#define AUDIO_SPECTRUM_FULL_SCALE_Q8    (24 * 256)
+
+/**
+  * @brief  log2(x), Q8, the fraction is interpolated linearly.
+  */
+static int32_t audio_spectrum_log2_q8(uint64_t x)
+{
+    int32_t msb = 0;
+
+    if (0 == x) {
+        return 0;
+    }
+    msb = 63 - __builtin_clzll(x);
+    // The 8 bits after the leading one.
+    if (msb >= 8) {
+        return (msb << 8) | (int32_t)((x >> (msb - 8)) & 0xFF);
+    }
+    return (msb << 8) | (int32_t)((x << (8 - msb)) & 0xFF);
+}
+
+/**
+  * @brief  Q16 coefficient of a one pole filter.
+  * @param[in]  block_ms  time between two blocks.
+  * @param[in]  tau_ms  time constant, 0 follows at once.
+  */
+static uint16_t audio_spectrum_coef(float block_ms, uint16_t tau_ms)
+{
+    float coef = (0 == tau_ms) ? 1.0f : (1.0f - expf(-block_ms / tau_ms));
+
+    return (coef >= 1.0f) ? 0xFFFF : (uint16_t)(coef * 65536.0f);
+}
+
+/**
+  * @brief  In place radix 2 FFT of re/im, Q15, scaled by 1/N.
+  * @note  Each stage halves the values, the magnitude never exceeds the input.
+  */
+static void audio_spectrum_fft(AudioSpectrum_handle_t spectrum)
+{
+    uint16_t n = spectrum->fft_n;
+    int16_t *re = spectrum->re;
+    int16_t *im = spectrum->im;
+    int16_t tmp = 0;
+
+    for (uint16_t i=1, j=0; i<n; i++) {
+        uint16_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            tmp = re[i]; re[i] = re[j]; re[j] = tmp;
+            tmp = im[i]; im[i] = im[j]; im[j] = tmp;
+        }
+    }
+    for (uint16_t len=2; len<=n; len<<=1) {
+        uint16_t half = len >> 1;
+        uint16_t step = n / len;
+        for (uint16_t i=0; i<n; i+=len) {
+            for (uint16_t k=0; k<half; k++) {
+                int32_t wr = spectrum->cos_table[k * step];
+                int32_t wi = -spectrum->sin_table[k * step];
+                uint16_t a = i + k;
+                uint16_t b = a + half;
+                int32_t tr = (re[b] * wr - im[b] * wi) >> 15;
+                int32_t ti = (re[b] * wi + im[b] * wr) >> 15;
+                re[b] = (re[a] - tr) >> 1;
+                im[b] = (im[a] - ti) >> 1;
+                re[a] = (re[a] + tr) >> 1;
+                im[a] = (im[a] + ti) >> 1;
+            }
+        }
+    }
+}
+
+/**
+  * @brief  Create an analyzer.
+  * @param[in]  config  analyzer configuration.
+  * @retval  
+  *         successful  analyzer handle.
+  *         failed      NULL.
+  * @note  Use AudioSpectrum_Deinit() to release it.
+  */
+AudioSpectrum_handle_t AudioSpectrum_Init(const AudioSpectrum_Config_t *config)
+{
+    uint16_t n = 0;
+
+    if (NULL == config || config->fft_n < AUDIO_SPECTRUM_FFT_N_MIN || 
+        config->fft_n > AUDIO_SPECTRUM_FFT_N_MAX || (config->fft_n & (config->fft_n - 1)) || 
+        0 == config->band_num || config->band_num > AUDIO_SPECTRUM_BAND_MAX || 
+        0 == config->sample_rate || 0 == config->freq_low || 
+        config->freq_high <= config->freq_low || config->freq_high > config->sample_rate / 2) {
+        return NULL;
+    }
+    n = config->fft_n;
+
+    AudioSpectrum_handle_t spectrum = calloc(1, sizeof(AudioSpectrum_t));
+    if (NULL == spectrum) {
+        return NULL;
+    }
+    spectrum->window = malloc(n * sizeof(int16_t));
+    spectrum->cos_table = malloc(n / 2 * sizeof(int16_t));
+    spectrum->sin_table = malloc(n / 2 * sizeof(int16_t));
+    spectrum->re = malloc(n * sizeof(int16_t));
+    spectrum->im = malloc(n * sizeof(int16_t));
+    if (NULL == spectrum->window || NULL == spectrum->cos_table || NULL == spectrum->sin_table || 
+        NULL == spectrum->re || NULL == spectrum->im) {
+        AudioSpectrum_Deinit(&spectrum);
+        return NULL;
+    }
+    spectrum->fft_n = n;
+
+    for (uint16_t i=0; i<n; i++) {
+        spectrum->window[i] = (int16_t)(32767.0 * 0.5 * (1.0 - cos(2.0 * M_PI * i / n)));
+    }
+    for (uint16_t i=0; i<n/2; i++) {
+        spectrum->cos_table[i] = (int16_t)lrint(32767.0 * cos(2.0 * M_PI * i / n));
+        spectrum->sin_table[i] = (int16_t)lrint(32767.0 * sin(2.0 * M_PI * i / n));
+    }
+
+    // Log spaced band edges, each band at least one bin wide.
+    spectrum->band_num = config->band_num;
+    for (uint8_t k=0; k<=config->band_num; k++) {
+        double freq = config->freq_low * pow((double)config->freq_high / config->freq_low, 
+                                             (double)k / config->band_num);
+        uint32_t bin = (uint32_t)lrint(freq * n / config->sample_rate);
+        if (bin < 1) {
+            bin = 1;
+        }
+        if (k > 0 && bin <= spectrum->band_bin[k - 1]) {
+            bin = spectrum->band_bin[k - 1] + 1;
+        }
+        spectrum->band_bin[k] = (bin > n / 2) ? n / 2 : bin;
+    }
+
+    float block_ms = 1000.0f * n / config->sample_rate;
+    spectrum->attack = audio_spectrum_coef(block_ms, config->attack_ms);
+    spectrum->decay = audio_spectrum_coef(block_ms, config->decay_ms);
+    AudioSpectrum_SetRange(spectrum, 0, AUDIO_SPECTRUM_RANGE_DB);
+    return spectrum;
+}
+
+/**
+  * @brief  Delete an analyzer.
+  * @param[in]  spectrum  analyzer handle pointer.
+  */
+void AudioSpectrum_Deinit(AudioSpectrum_handle_t *spectrum)
+{
+    if (NULL == *spectrum) {
+        return;
+    }
+    free((*spectrum)->im);
+    free((*spectrum)->re);
+    free((*spectrum)->sin_table);
+    free((*spectrum)->cos_table);
+    free((*spectrum)->window);
+    free(*spectrum);
+    *spectrum = NULL;
+}
+
+/**
+  * @brief  Set the dynamic range of the band levels.
+  * @param[in]  spectrum  analyzer handle.
+  * @param[in]  top_db  level 255, dB relative to a full scale sine(0 or negative).
+  * @param[in]  range_db  level 0 is range_db below top_db.
+  */
+void AudioSpectrum_SetRange(AudioSpectrum_handle_t spectrum, int8_t top_db, uint8_t range_db)
+{
+    // One log2 step of energy is 3.01 dB.
+    spectrum->top_q8 = AUDIO_SPECTRUM_FULL_SCALE_Q8 + top_db * 256 * 100 / 301;
+    spectrum->range_q8 = (0 == range_db) ? 1 : range_db * 256 * 100 / 301;
+}
+
+/**
+  * @brief  Analyze one block and update the band envelopes.
+  * @param[in]  spectrum  analyzer handle.
+  * @param[in]  samples  fft_n signed 16 bit samples.
+  * @note  The DC offset of the block is removed before the window.
+  */
+void AudioSpectrum_Process(AudioSpectrum_handle_t spectrum, const int16_t *samples)
+{
+    uint16_t n = spectrum->fft_n;
+    int32_t mean = 0;
+
+    for (uint16_t i=0; i<n; i++) {
+        mean += samples[i];
+    }
+    mean /= n;
+    for (uint16_t i=0; i<n; i++) {
+        // Without the offset a full scale block spans up to 17 bits, halve it instead of clipping.
+        int32_t x = (samples[i] - mean) >> 1;
+        spectrum->re[i] = (x * spectrum->window[i]) >> 15;
+        spectrum->im[i] = 0;
+    }
+    audio_spectrum_fft(spectrum);
+
+    for (uint8_t k=0; k<spectrum->band_num; k++) {
+        uint64_t energy = 0;
+        for (uint16_t bin=spectrum->band_bin[k]; bin<spectrum->band_bin[k + 1]; bin++) {
+            energy += (int32_t)spectrum->re[bin] * spectrum->re[bin] + 
+                      (int32_t)spectrum->im[bin] * spectrum->im[bin];
+        }
+        // Positive and negative frequencies.
+        int32_t level = (audio_spectrum_log2_q8(energy * 2) - (spectrum->top_q8 - spectrum->range_q8)) 
+                        * 255 / spectrum->range_q8;
+        level = (level < 0) ? 0 : ((level > 255) ? 255 : level);
+
+        int32_t target = level << 8;
+        int32_t env = spectrum->envelope[k];
+        uint32_t coef = (target > env) ? spectrum->attack : spectrum->decay;
+        spectrum->envelope[k] = env + (int32_t)(((int64_t)(target - env) * coef) >> 16);
+    }
+}
+
+/**
+  * @brief  Get the band levels.
+  * @param[in]  spectrum  analyzer handle.
+  * @param[out]  levels  band_num levels, 0 ~ 255 over the dynamic range.
+  */
+void AudioSpectrum_GetLevels(AudioSpectrum_handle_t spectrum, uint8_t *levels)
+{
+    for (uint8_t k=0; k<spectrum->band_num; k++) {
+        levels[k] = (spectrum->envelope[k] + 128) >> 8;
+    }
+}
@@ -0,0 +1,95 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           audio_sampler.h
+  * @version        1.0
+  * @date           2026-10-19
+  * @brief          ADC audio sampling through the I2S DMA, in blocks handed to a callback.
+  */
+
+#ifndef _AUDIO_SAMPLER_H_
+#define _AUDIO_SAMPLER_H_
+
+#include "esp_err.h"
+#include "driver/i2s.h"
+#include "driver/adc.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define AUDIO_SAMPLER_I2S_NUM           I2S_NUM_0   // Only I2S0 can read the built in ADC.
+#define AUDIO_SAMPLER_DMA_BUF_COUNT     4
+#define AUDIO_SAMPLER_TASK_STACK_SIZE   (3072)      // Read and process task stack size.
+#define AUDIO_SAMPLER_READ_TIMEOUT_MS   100         // Bounds the time to stop the tasks.
+
+/**
+  * @brief  Called from the process task with each full block.
+  * @param[in]  block  signed 16 bit samples, the ADC midpoint is 0.
+  * @param[in]  len  number of samples.
+  * @param[in]  arg  user argument.
+  */
+typedef void (*AudioSampler_BlockCallback_t)(const int16_t *block, uint16_t len, void *arg);
+
+typedef struct{
+    adc1_channel_t adc_channel;
+    uint32_t sample_rate;
+    uint16_t block_len;
+    int16_t *block[2];              // Filled and processed in turn.
+    uint16_t fill;                  // Samples in the block being filled.
+    uint8_t fill_index;
+    volatile uint8_t ready_index;
+    volatile bool busy;             // A block is with the process task.
+    uint32_t overruns;              // Blocks dropped because the previous one was not processed.
+    AudioSampler_BlockCallback_t callback;
+    void *arg;
+    TaskHandle_t read_task;
+    TaskHandle_t process_task;
+    volatile bool task_exit;
+}AudioSampler_t;
+typedef AudioSampler_t *AudioSampler_handle_t;
+
+/**
+  * @brief  Start sampling an ADC1 channel at a fixed rate.
+  * @param[in]  adc_channel  ADC1 channel, e.g. ADC1_CHANNEL_6(GPIO34).
+  * @param[in]  sample_rate  unit: Hz.
+  * @param[in]  block_len  samples per block, 64 ~ 1024.
+  * @param[in]  core_id  core of the read and process tasks.
+  * @param[in]  task_priority  process task priority, the read task runs one above.
+  * @param[in]  callback  block callback.
+  * @param[in]  arg  user argument of the callback.
+  * @retval  
+  *         successful  sampler handle.
+  *         failed      NULL.
+  * @note  The I2S DMA samples without the CPU, the read task only copies and converts 
+  *        the samples. A block that arrives while the callback still works on the 
+  *        previous one is dropped and counted in overruns.
+  * @note  ADC1 is used by I2S until AudioSampler_Deinit().
+  */
+AudioSampler_handle_t AudioSampler_Init(adc1_channel_t adc_channel, uint32_t sample_rate, uint16_t block_len, 
+                                        BaseType_t core_id, UBaseType_t task_priority, 
+                                        AudioSampler_BlockCallback_t callback, void *arg);
+
+/**
+  * @brief  Stop sampling.
+  * @param[in]  sampler  sampler handle pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t AudioSampler_Deinit(AudioSampler_handle_t *sampler);
+
+#endif /* _AUDIO_SAMPLER_H_ */
@@ -0,0 +1,104 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           audio_spectrum.h
+  * @version        1.0
+  * @date           2026-10-19
+  * @brief          Audio spectrum analyzer, fixed point FFT, band levels and envelopes.
+  *                 Plain C without ESP-IDF dependencies, floating point only in Init.
+  */
+
+#ifndef _AUDIO_SPECTRUM_H_
+#define _AUDIO_SPECTRUM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define AUDIO_SPECTRUM_FFT_N_MIN        64
+#define AUDIO_SPECTRUM_FFT_N_MAX        1024
+#define AUDIO_SPECTRUM_BAND_MAX         16
+#define AUDIO_SPECTRUM_RANGE_DB         48      // Default dynamic range of the band levels.
+
+// Analyzer configuration.
+typedef struct{
+    uint16_t fft_n;                 // Samples per block, power of 2.
+    uint32_t sample_rate;           // Unit: Hz.
+    uint8_t band_num;               // 1 ~ AUDIO_SPECTRUM_BAND_MAX, log spaced.
+    uint16_t freq_low;              // Lower edge of the first band, unit: Hz.
+    uint16_t freq_high;             // Upper edge of the last band, unit: Hz.
+    uint16_t attack_ms;             // Envelope rise time constant.
+    uint16_t decay_ms;              // Envelope fall time constant.
+}AudioSpectrum_Config_t;
+
+typedef struct{
+    uint16_t fft_n;
+    int16_t *window;                // Hann window, Q15.
+    int16_t *cos_table;             // Twiddle factors, Q15, fft_n/2.
+    int16_t *sin_table;
+    int16_t *re;                    // FFT work buffers.
+    int16_t *im;
+    uint8_t band_num;
+    uint16_t band_bin[AUDIO_SPECTRUM_BAND_MAX + 1];     // First bin of each band, then the end bin.
+    uint16_t attack;                // Envelope coefficients per block, Q16.
+    uint16_t decay;
+    int32_t top_q8;                 // log2 band energy of level 255, Q8.
+    int32_t range_q8;               // log2 band energy range of level 0 ~ 255, Q8.
+    uint32_t envelope[AUDIO_SPECTRUM_BAND_MAX];         // Band levels, Q8.
+}AudioSpectrum_t;
+typedef AudioSpectrum_t *AudioSpectrum_handle_t;
+
+/**
+  * @brief  Create an analyzer.
+  * @param[in]  config  analyzer configuration.
+  * @retval  
+  *         successful  analyzer handle.
+  *         failed      NULL.
+  * @note  Use AudioSpectrum_Deinit() to release it.
+  */
+AudioSpectrum_handle_t AudioSpectrum_Init(const AudioSpectrum_Config_t *config);
+
+/**
+  * @brief  Delete an analyzer.
+  * @param[in]  spectrum  analyzer handle pointer.
+  */
+void AudioSpectrum_Deinit(AudioSpectrum_handle_t *spectrum);
+
+/**
+  * @brief  Set the dynamic range of the band levels.
+  * @param[in]  spectrum  analyzer handle.
+  * @param[in]  top_db  level 255, dB relative to a full scale sine(0 or negative).
+  * @param[in]  range_db  level 0 is range_db below top_db.
+  */
+void AudioSpectrum_SetRange(AudioSpectrum_handle_t spectrum, int8_t top_db, uint8_t range_db);
+
+/**
+  * @brief  Analyze one block and update the band envelopes.
+  * @param[in]  spectrum  analyzer handle.
+  * @param[in]  samples  fft_n signed 16 bit samples.
+  * @note  The DC offset of the block is removed before the window.
+  */
+void AudioSpectrum_Process(AudioSpectrum_handle_t spectrum, const int16_t *samples);
+
+/**
+  * @brief  Get the band levels.
+  * @param[in]  spectrum  analyzer handle.
+  * @param[out]  levels  band_num levels, 0 ~ 255 over the dynamic range.
+  */
+void AudioSpectrum_GetLevels(AudioSpectrum_handle_t spectrum, uint8_t *levels);
+
+#endif /* _AUDIO_SPECTRUM_H_ */
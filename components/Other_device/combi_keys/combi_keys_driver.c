@@ -25,11 +25,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <sys/time.h>
 #include "esp_err.h"
 #include "esp_log.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
 #include "driver/gpio.h"
 
 static const char *TAG = "Combi keys";
@@ -39,6 +41,88 @@ static const char *TAG = "Combi keys";
         return (ret);                                                            \
         }
 
+// Keys are active low.
+#define COMBI_KEY_PRESSED_LEVEL     0
+
+/**
+  * @brief  Engine event output, runs in the esp_timer task and never blocks it.
+  * @param[in]  event  key event.
+  * @param[in]  arg  combi keys handle.
+  */
+static void combi_keys_emit(const CombiKey_Event_t *event, void *arg)
+{
+    CombiKey_handle_t combi_keys_handle = (CombiKey_handle_t)arg;
+
+    if (pdTRUE != xQueueSend(combi_keys_handle->event_queue, event, 0)) {
+        combi_keys_handle->event_lost++;
+    }
+}
+
+/**
+  * @brief  Arm the engine timer for the next engine deadline.
+  * @param[in]  combi_keys_handle  combi keys handle.
+  * @param[in]  now  current time(us).
+  */
+static void combi_keys_engine_schedule(CombiKey_handle_t combi_keys_handle, int64_t now)
+{
+    int64_t deadline = CombiKeys_EngineNextDeadline(&combi_keys_handle->engine);
+
+    esp_timer_stop(combi_keys_handle->engine_timer);
+    if (0 != deadline) {
+        esp_timer_start_once(combi_keys_handle->engine_timer, (deadline > now) ? (deadline - now) : 0);
+    }
+}
+
+/**
+  * @brief  Engine timer, runs in the esp_timer task.
+  * @param[in]  arg  combi keys handle.
+  */
+static void combi_keys_engine_timer_callback(void *arg)
+{
+    CombiKey_handle_t combi_keys_handle = (CombiKey_handle_t)arg;
+    int64_t now = esp_timer_get_time();
+
+    CombiKeys_EngineTick(&combi_keys_handle->engine, now);
+    combi_keys_engine_schedule(combi_keys_handle, now);
+}
+
+/**
+  * @brief  Key debounce timer, runs in the esp_timer task.
+  * @param[in]  arg  key state.
+  */
+static void combi_key_timer_callback(void *arg)
+{
+    CombiKey_Key_t *key = (CombiKey_Key_t *)arg;
+    CombiKey_handle_t combi_keys_handle = key->owner;
+    CombiKey_Mask_t bit = (CombiKey_Mask_t)1 << key->id;
+    int64_t now = esp_timer_get_time();
+
+    // Enable before sampling, an edge after the sample starts a new debounce period.
+    gpio_intr_enable(key->pin);
+    CombiKey_Mask_t state = combi_keys_handle->state & ~bit;
+    if (COMBI_KEY_PRESSED_LEVEL == gpio_get_level(key->pin)) {
+        state |= bit;
+    }
+    if (state != combi_keys_handle->state) {
+        combi_keys_handle->state = state;
+        CombiKeys_EngineUpdate(&combi_keys_handle->engine, state, now);
+        combi_keys_engine_schedule(combi_keys_handle, now);
+    }
+}
+
+/**
+  * @brief  Key edge interrupt, masks the pin and (re)starts the debounce timer.
+  * @param[in]  arg  key state.
+  */
+static void IRAM_ATTR combi_key_isr_handler(void *arg)
+{
+    CombiKey_Key_t *key = (CombiKey_Key_t *)arg;
+
+    gpio_intr_disable(key->pin);
+    esp_timer_stop(key->timer);
+    esp_timer_start_once(key->timer, (uint64_t)key->owner->debounce_time * 1000);
+}
+
 /**
   * @brief  Combination key initialization.
   * @param[in]  key_up  up key number.
@@ -48,44 +132,109 @@ static const char *TAG = "Combi keys";
   *         successful  CombiKeys operation handle.
   *         failed      NULL.
   * @note  Use CombiKeys_Deinit() to release it.
-  * @note  The default long press time is 2000ms.
+  * @note  The keys are active low. Every edge starts a one shot debounce timer for that key, 
+  *        debounced events are sent to the handle event queue, nothing runs while the keys are idle.
+  * @note  The default long press time is 2000ms and the default debounce time is 10ms, 
+  *        repeat and double click are disabled by default.
   */
 CombiKey_handle_t CombiKeys_Init(gpio_num_t key_up, gpio_num_t key_mid, gpio_num_t key_down)
+{
+    gpio_num_t pins[COMBI_KEY_NUM] = {key_up, key_mid, key_down};
+
+    return CombiKeys_InitKeys(pins, COMBI_KEY_NUM);
+}
+
+/**
+  * @brief  Combination key initialization with any number of keys.
+  * @param[in]  pins  key pins, key n of the events is pins[n].
+  * @param[in]  key_num  number of keys, at most COMBI_KEYS_MAX.
+  * @retval  
+  *         successful  CombiKeys operation handle.
+  *         failed      NULL.
+  * @note  Use CombiKeys_Deinit() to release it.
+  * @note  Same defaults as CombiKeys_Init().
+  */
+CombiKey_handle_t CombiKeys_InitKeys(const gpio_num_t *pins, uint8_t key_num)
 {
     esp_err_t err = ESP_FAIL;
 
-    CombiKey_handle_t combi_keys_handle = malloc(sizeof(CombiKey_t));
+    if ((NULL == pins) || (0 == key_num) || (key_num > COMBI_KEYS_MAX)) {
+        ESP_LOGE(TAG, "%s (%d) invalid key number %d.", __FUNCTION__, __LINE__, key_num);
+        return NULL;
+    }
+    CombiKey_handle_t combi_keys_handle = calloc(1, sizeof(CombiKey_t) + sizeof(CombiKey_Key_t) * key_num);
     if (NULL == combi_keys_handle) {
         ESP_LOGE(TAG, "%s (%d) driver handle malloc failed.", __FUNCTION__, __LINE__);
         return NULL;
     }
-    gpio_pad_select_gpio(key_up);
-    err = gpio_set_direction(key_up, GPIO_MODE_INPUT);
-    if(ESP_OK != err) {
+    combi_keys_handle->key_num = key_num;
+    combi_keys_handle->debounce_time = COMBI_KEY_DEFAULT_DEBOUNCE_MS;
+    CombiKeys_EngineInit(&combi_keys_handle->engine, combi_keys_emit, combi_keys_handle);
+    for (uint8_t i = 0; i < key_num; i++) {
+        combi_keys_handle->key[i].pin = -1;
+    }
+
+    combi_keys_handle->event_queue = xQueueCreate(COMBI_KEY_EVENT_QUEUE_LEN, sizeof(CombiKey_Event_t));
+    if (NULL == combi_keys_handle->event_queue) {
         goto COMBI_KEYS_CONFIG_FAIL;
     }
-    gpio_pad_select_gpio(key_mid);
-    err = gpio_set_direction(key_mid, GPIO_MODE_INPUT);
-    if (ESP_OK != err) {
+    esp_timer_create_args_t engine_timer_args = {
+        .callback = combi_keys_engine_timer_callback,
+        .arg = combi_keys_handle,
+        .name = "combi_keys",
+    };
+    if (ESP_OK != esp_timer_create(&engine_timer_args, &combi_keys_handle->engine_timer)) {
+        combi_keys_handle->engine_timer = NULL;
         goto COMBI_KEYS_CONFIG_FAIL;
     }
-    gpio_pad_select_gpio(key_down);
-    err = gpio_set_direction(key_down, GPIO_MODE_INPUT);
-    if (ESP_OK != err) {
+    // Each key pin gets its own handler on the shared service, which the app or another
+    // driver may have installed already(ESP_ERR_INVALID_STATE).
+    err = gpio_install_isr_service(0);
+    if (ESP_OK != err && ESP_ERR_INVALID_STATE != err) {
         goto COMBI_KEYS_CONFIG_FAIL;
     }
-    
-    combi_keys_handle->key_up = key_up;
-    combi_keys_handle->key_mid = key_mid;
-    combi_keys_handle->key_down = key_down;
-    // The long press time defaults to 2000ms.
-    combi_keys_handle->long_press_time = 2000;
+    for (uint8_t i = 0; i < key_num; i++) {
+        CombiKey_Key_t *key = &combi_keys_handle->key[i];
+        key->owner = combi_keys_handle;
+        key->id = i;
+
+        esp_timer_create_args_t timer_args = {
+            .callback = combi_key_timer_callback,
+            .arg = key,
+            .name = "combi_key",
+        };
+        if (ESP_OK != esp_timer_create(&timer_args, &key->timer)) {
+            key->timer = NULL;
+            goto COMBI_KEYS_CONFIG_FAIL;
+        }
+        gpio_config_t io_conf = {
+            .pin_bit_mask = (1ULL << pins[i]),
+            .mode = GPIO_MODE_INPUT,
+            .pull_up_en = GPIO_PULLUP_DISABLE,
+            .pull_down_en = GPIO_PULLDOWN_DISABLE,
+            .intr_type = GPIO_INTR_ANYEDGE,
+        };
+        err = gpio_config(&io_conf);
+        if (ESP_OK != err) {
+            goto COMBI_KEYS_CONFIG_FAIL;
+        }
+        key->pin = pins[i];
+        // A key held at init is only reported when it is released.
+        if (COMBI_KEY_PRESSED_LEVEL == gpio_get_level(key->pin)) {
+            combi_keys_handle->state |= (CombiKey_Mask_t)1 << i;
+            combi_keys_handle->engine.state = combi_keys_handle->state;
+        }
+        err = gpio_isr_handler_add(key->pin, combi_key_isr_handler, key);
+        if (ESP_OK != err) {
+            goto COMBI_KEYS_CONFIG_FAIL;
+        }
+    }
     ESP_LOGI(TAG, "%s (%d) Combi keys init ok.", __FUNCTION__, __LINE__);
     return combi_keys_handle;
 
 COMBI_KEYS_CONFIG_FAIL:
     ESP_LOGE(TAG, "%s (%d) Config combi keys IO failed.", __FUNCTION__, __LINE__);
-    free(combi_keys_handle);
+    CombiKeys_Deinit(&combi_keys_handle);
     return NULL;
 }
 
@@ -100,10 +249,26 @@ esp_err_t CombiKeys_Deinit(CombiKey_handle_t* combi_keys_handle)
 {
     COMBIKEYS_HANDLE_CHECK(*combi_keys_handle, ESP_FAIL);
 
-    // reset gpio.
-    gpio_reset_pin((*combi_keys_handle)->key_up);
-    gpio_reset_pin((*combi_keys_handle)->key_mid);
-    gpio_reset_pin((*combi_keys_handle)->key_down);
+    for (uint8_t i = 0; i < (*combi_keys_handle)->key_num; i++) {
+        CombiKey_Key_t *key = &(*combi_keys_handle)->key[i];
+        // Remove the ISR first, it is the only one restarting the timer once it is stopped.
+        if (key->pin >= 0) {
+            gpio_isr_handler_remove(key->pin);
+            gpio_reset_pin(key->pin);
+        }
+        if (NULL != key->timer) {
+            esp_timer_stop(key->timer);
+            esp_timer_delete(key->timer);
+        }
+    }
+    // No debounce timer is left to restart the engine timer.
+    if (NULL != (*combi_keys_handle)->engine_timer) {
+        esp_timer_stop((*combi_keys_handle)->engine_timer);
+        esp_timer_delete((*combi_keys_handle)->engine_timer);
+    }
+    if (NULL != (*combi_keys_handle)->event_queue) {
+        vQueueDelete((*combi_keys_handle)->event_queue);
+    }
 
     free(*combi_keys_handle);
     *combi_keys_handle = NULL;
@@ -129,20 +294,168 @@ esp_err_t CombiKeys_SetLongPress(CombiKey_handle_t combi_keys_handle, uint32_t t
         return ESP_FAIL;
     }
 
-    combi_keys_handle->long_press_time = time_ms;
+    combi_keys_handle->engine.long_press_time = time_ms;
+    return ESP_OK;
+}
+
+/**
+  * @brief  combi keys Set debounce time.
+  * @param[in]  combi_keys_handle  combi keys operation handle.
+  * @param[in]  time_ms  debounce time(ms), the level must be stable this long.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note   The default debounce time is 10ms, this is also the event latency.
+  */
+esp_err_t CombiKeys_SetDebounce(CombiKey_handle_t combi_keys_handle, uint32_t time_ms)
+{
+    COMBIKEYS_HANDLE_CHECK(combi_keys_handle, ESP_FAIL);
+    if (0 == time_ms) {
+        ESP_LOGE(TAG, "%s (%d) debounce time cannot be set to 0", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    combi_keys_handle->debounce_time = time_ms;
     return ESP_OK;
 }
 
 /**
-  * @brief  Get the current system time(us)
+  * @brief  combi keys Set hold repeat interval.
+  * @param[in]  combi_keys_handle  combi keys operation handle.
+  * @param[in]  time_ms  repeat interval(ms), 0 disables repeat events.
   * @retval 
-  *         system time(us)
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note   Repeat events start after the long press event.
+  */
+esp_err_t CombiKeys_SetRepeat(CombiKey_handle_t combi_keys_handle, uint32_t time_ms)
+{
+    COMBIKEYS_HANDLE_CHECK(combi_keys_handle, ESP_FAIL);
+
+    combi_keys_handle->engine.repeat_time = time_ms;
+    return ESP_OK;
+}
+
+/**
+  * @brief  combi keys Set hold repeat acceleration.
+  * @param[in]  combi_keys_handle  combi keys operation handle.
+  * @param[in]  accel  percent the repeat interval shrinks after each repeat, 0 keeps it constant.
+  * @param[in]  min_time_ms  shortest repeat interval(ms).
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t CombiKeys_SetRepeatAccel(CombiKey_handle_t combi_keys_handle, uint8_t accel, uint32_t min_time_ms)
+{
+    COMBIKEYS_HANDLE_CHECK(combi_keys_handle, ESP_FAIL);
+    if ((accel > 100) || ((accel > 0) && (0 == min_time_ms))) {
+        ESP_LOGE(TAG, "%s (%d) invalid repeat acceleration.", __FUNCTION__, __LINE__);
+        return ESP_FAIL;
+    }
+
+    combi_keys_handle->engine.repeat_accel = accel;
+    combi_keys_handle->engine.repeat_min_time = min_time_ms;
+    return ESP_OK;
+}
+
+/**
+  * @brief  combi keys Set double click time.
+  * @param[in]  combi_keys_handle  combi keys operation handle.
+  * @param[in]  time_ms  max time(ms) from the first release to the second press, 0 disables double click.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note   While enabled, the short press event is held back until the window has passed.
+  */
+esp_err_t CombiKeys_SetDoubleClick(CombiKey_handle_t combi_keys_handle, uint32_t time_ms)
+{
+    COMBIKEYS_HANDLE_CHECK(combi_keys_handle, ESP_FAIL);
+
+    combi_keys_handle->engine.double_click_time = time_ms;
+    return ESP_OK;
+}
+
+/**
+  * @brief  combi keys Set the chord table.
+  * @param[in]  combi_keys_handle  combi keys operation handle.
+  * @param[in]  table  chord table, must stay valid while in use.
+  * @param[in]  num  number of chords.
+  * @param[in]  time_ms  max time(ms) from the first to the last key of a chord.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note   The default chord time is 50ms.
   */
-static int64_t combi_get_current_time(void)
+esp_err_t CombiKeys_SetChords(CombiKey_handle_t combi_keys_handle, const CombiKey_Chord_t *table, uint8_t num, 
+                              uint32_t time_ms)
 {
-    struct timeval tv_now;
-    gettimeofday(&tv_now, NULL);
-    return (int64_t)tv_now.tv_sec * 1000000L + (int64_t)tv_now.tv_usec;
+    COMBIKEYS_HANDLE_CHECK(combi_keys_handle, ESP_FAIL);
+    if ((NULL == table) && (0 != num)) {
+        return ESP_FAIL;
+    }
+
+    combi_keys_handle->engine.chord_num = 0;
+    combi_keys_handle->engine.chord_table = table;
+    combi_keys_handle->engine.chord_time = time_ms;
+    combi_keys_handle->engine.chord_num = num;
+    return ESP_OK;
+}
+
+/**
+  * @brief  combi keys Set the sequence table.
+  * @param[in]  combi_keys_handle  combi keys operation handle.
+  * @param[in]  table  sequence table, must stay valid while in use.
+  * @param[in]  num  number of sequences.
+  * @param[in]  time_ms  max time(ms) between two steps of a sequence.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note   The default sequence time is 1000ms, long presses clear the sequence history.
+  */
+esp_err_t CombiKeys_SetSequences(CombiKey_handle_t combi_keys_handle, const CombiKey_Sequence_t *table, uint8_t num, 
+                                 uint32_t time_ms)
+{
+    COMBIKEYS_HANDLE_CHECK(combi_keys_handle, ESP_FAIL);
+    if ((NULL == table) && (0 != num)) {
+        return ESP_FAIL;
+    }
+    for (uint8_t i = 0; i < num; i++) {
+        if (table[i].len > COMBI_KEYS_SEQUENCE_MAX) {
+            ESP_LOGE(TAG, "%s (%d) sequence %d is longer than %d steps.", __FUNCTION__, __LINE__, 
+                     i, COMBI_KEYS_SEQUENCE_MAX);
+            return ESP_FAIL;
+        }
+    }
+
+    combi_keys_handle->engine.sequence_num = 0;
+    combi_keys_handle->engine.sequence_table = table;
+    combi_keys_handle->engine.sequence_time = time_ms;
+    combi_keys_handle->engine.sequence_num = num;
+    return ESP_OK;
+}
+
+/**
+  * @brief  Wait for the next key event.
+  * @param[in]  combi_keys_handle  combi keys operation handle.
+  * @param[out]  event  key event.
+  * @param[in]  timeout_ms  max wait time(ms), portMAX_DELAY waits forever.
+  * @retval 
+  *         - ESP_OK            successful.
+  *         - ESP_ERR_TIMEOUT   no event in time.
+  *         - ESP_FAIL          failed.
+  */
+esp_err_t CombiKeys_WaitEvent(CombiKey_handle_t combi_keys_handle, CombiKey_Event_t *event, uint32_t timeout_ms)
+{
+    COMBIKEYS_HANDLE_CHECK(combi_keys_handle, ESP_FAIL);
+    if (NULL == event) {
+        return ESP_FAIL;
+    }
+
+    TickType_t ticks = (portMAX_DELAY == timeout_ms) ? portMAX_DELAY : (timeout_ms / portTICK_PERIOD_MS);
+    if (pdTRUE != xQueueReceive(combi_keys_handle->event_queue, event, ticks)) {
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
 }
 
 /**
@@ -151,84 +464,34 @@ static int64_t combi_get_current_time(void)
   * @retval 
   *         - key value combi_Key_Value_t.
   * @note  
-  *         Only one can support the detection of one button at a time.
-  *         Support three states: press, short press and long press.
+  *         Kept for compatibility, takes one event from the queue without waiting.
+  *         Press is reported once per press, long press is reported when the long press time is reached.
+  *         Events without a key value are dropped, use CombiKeys_WaitEvent() to get all of them.
+  *         Only single key events of the first three keys have a key value.
   */
 CombiKey_Value_t CombiKeys_GetValue(CombiKey_handle_t combi_keys_handle)
 {
-    static uint8_t current_press = COMBI_KEY_NONE_VALUE_PRESS;
-    static int64_t begin_time = 0, end_time = 0;
-    
-    // Check if there is a button pressed, if so, keep the current system time, and mark the button pressed.
-    if(current_press == COMBI_KEY_NONE_VALUE_PRESS){
-        if(0 == gpio_get_level(combi_keys_handle->key_up)){
-            vTaskDelay(10 / portTICK_PERIOD_MS);
-            if(0 == gpio_get_level(combi_keys_handle->key_up)){
-                current_press = COMBI_KEY_UP_VALUE_PRESS;
-                begin_time = combi_get_current_time();
-                return COMBI_KEY_UP_VALUE_PRESS;
-            } 
-        }else if(0 == gpio_get_level(combi_keys_handle->key_mid)){
-            vTaskDelay(10 / portTICK_PERIOD_MS);
-            if(0 == gpio_get_level(combi_keys_handle->key_mid)){
-                current_press = COMBI_KEY_MID_VALUE_PRESS;
-                begin_time = combi_get_current_time();
-                return COMBI_KEY_MID_VALUE_PRESS;
-            }
-        }else if(0 == gpio_get_level(combi_keys_handle->key_down)){
-            vTaskDelay(10 / portTICK_PERIOD_MS);
-            if(0 == gpio_get_level(combi_keys_handle->key_down)){
-                current_press = COMBI_KEY_DOUN_VALUE_PRESS;
-                begin_time = combi_get_current_time();
-                return COMBI_KEY_DOUN_VALUE_PRESS;
-            }
-        }else{
+    static const CombiKey_Value_t key_base[COMBI_KEY_NUM] = {
+        COMBI_KEY_UP_VALUE_PRESS, COMBI_KEY_MID_VALUE_PRESS, COMBI_KEY_DOUN_VALUE_PRESS,
+    };
+    CombiKey_Event_t event;
+
+    COMBIKEYS_HANDLE_CHECK(combi_keys_handle, COMBI_KEY_NONE_VALUE_PRESS);
+    if (pdTRUE != xQueueReceive(combi_keys_handle->event_queue, &event, 0)) {
+        return COMBI_KEY_NONE_VALUE_PRESS;
+    }
+    if ((event.mask & (event.mask - 1)) || (event.key >= COMBI_KEY_NUM)) {
+        return COMBI_KEY_NONE_VALUE_PRESS;
+    }
+    // Each key has press, short press and long press values in that order.
+    switch (event.type) {
+        case COMBI_KEY_EVENT_PRESS:
+            return key_base[event.key];
+        case COMBI_KEY_EVENT_SHORT_PRESS:
+            return key_base[event.key] + 1;
+        case COMBI_KEY_EVENT_LONG_PRESS:
+            return key_base[event.key] + 2;
+        default:
             return COMBI_KEY_NONE_VALUE_PRESS;
-        }
-    }else{ // If a button is marked as pressed, judge whether the button is released, if released, judge whether to press long or short according to the system time.
-        if(current_press == COMBI_KEY_UP_VALUE_PRESS){
-            if(1 == gpio_get_level(combi_keys_handle->key_up)){
-                end_time = combi_get_current_time();
-                if((end_time-begin_time) > (combi_keys_handle->long_press_time)*1000){
-                    begin_time = 0;
-                    current_press = COMBI_KEY_NONE_VALUE_PRESS;
-                    return COMBI_KEY_UP_VALUE_LONG_PRESS;
-                }else{
-                    begin_time = 0;
-                    current_press = COMBI_KEY_NONE_VALUE_PRESS;
-                    return COMBI_KEY_UP_VALUE_SHORT_PRESS;
-                }
-            }
-            return COMBI_KEY_UP_VALUE_PRESS;
-        }else if(current_press == COMBI_KEY_MID_VALUE_PRESS){
-            if(1 == gpio_get_level(combi_keys_handle->key_mid)){
-                end_time = combi_get_current_time();
-                if((end_time-begin_time) > (combi_keys_handle->long_press_time)*1000){
-                    begin_time = 0;
-                    current_press = COMBI_KEY_NONE_VALUE_PRESS;
-                    return COMBI_KEY_MID_VALUE_LONG_PRESS;
-                }else{
-                    begin_time = 0;
-                    current_press = COMBI_KEY_NONE_VALUE_PRESS;
-                    return COMBI_KEY_MID_VALUE_SHORT_PRESS;
-                }
-            }
-            return COMBI_KEY_MID_VALUE_PRESS;
-        }else if(current_press == COMBI_KEY_DOUN_VALUE_PRESS){
-            if(1 == gpio_get_level(combi_keys_handle->key_down)){
-                end_time = combi_get_current_time();
-                if((end_time-begin_time) > (combi_keys_handle->long_press_time)*1000){
-                    begin_time = 0;
-                    current_press = COMBI_KEY_NONE_VALUE_PRESS;
-                    return COMBI_KEY_DOUN_VALUE_LONG_PRESS;
-                }else{
-                    begin_time = 0;
-                    current_press = COMBI_KEY_NONE_VALUE_PRESS;
-                    return COMBI_KEY_DOUN_VALUE_SHORT_PRESS;
-                }
-            }
-            return COMBI_KEY_DOUN_VALUE_PRESS;
-        }
     }
-    return  COMBI_KEY_NONE_VALUE_PRESS;
 }
@@ -0,0 +1,282 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           combi_keys_engine.c
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#include "combi_keys_engine.h"
+#include <string.h>
+
+/**
+  * @brief  Emit one event.
+  * @param[in]  engine  combi keys engine.
+  * @param[in]  type  event type.
+  * @param[in]  mask  keys of the event.
+  * @param[in]  id  chord or sequence id.
+  * @param[in]  now  event time(us).
+  */
+static void combi_engine_emit(CombiKey_Engine_t *engine, CombiKey_EventType_t type, CombiKey_Mask_t mask, 
+                              uint16_t id, int64_t now)
+{
+    CombiKey_Event_t event = {
+        .type = type,
+        .key = 0,
+        .mask = mask,
+        .id = id,
+        .count = (COMBI_KEY_EVENT_REPEAT == type) ? engine->repeat_count : 0,
+        .time_us = now,
+    };
+
+    while ((0 != mask) && !(mask & 1)) {
+        mask >>= 1;
+        event.key++;
+    }
+    engine->emit(&event, engine->emit_arg);
+}
+
+/**
+  * @brief  Close the chord window and report the chord if it is in the table.
+  * @param[in]  engine  combi keys engine.
+  * @param[in]  now  current time(us).
+  */
+static void combi_engine_chord_close(CombiKey_Engine_t *engine, int64_t now)
+{
+    engine->chord_deadline = 0;
+    // A single key is not a chord.
+    if (0 == (engine->gesture & (engine->gesture - 1))) {
+        return;
+    }
+    for (uint8_t i = 0; i < engine->chord_num; i++) {
+        if (engine->chord_table[i].mask == engine->gesture) {
+            combi_engine_emit(engine, COMBI_KEY_EVENT_CHORD, engine->gesture, engine->chord_table[i].id, now);
+            return;
+        }
+    }
+}
+
+/**
+  * @brief  Report the short press waiting for a double click.
+  * @param[in]  engine  combi keys engine.
+  * @param[in]  now  current time(us).
+  */
+static void combi_engine_click_flush(CombiKey_Engine_t *engine, int64_t now)
+{
+    engine->click_deadline = 0;
+    if (0 != engine->pending_click) {
+        combi_engine_emit(engine, COMBI_KEY_EVENT_SHORT_PRESS, engine->pending_click, 0, now);
+        engine->pending_click = 0;
+    }
+}
+
+/**
+  * @brief  Add a short press to the sequence history and report a matching sequence.
+  * @param[in]  engine  combi keys engine.
+  * @param[in]  mask  keys of the short press.
+  * @param[in]  now  current time(us).
+  */
+static void combi_engine_sequence_step(CombiKey_Engine_t *engine, CombiKey_Mask_t mask, int64_t now)
+{
+    if (0 == engine->sequence_num) {
+        return;
+    }
+    if ((0 != engine->sequence_len) && 
+        (now - engine->sequence_last > (int64_t)engine->sequence_time * 1000)) {
+        engine->sequence_len = 0;
+    }
+    // Keep the newest steps.
+    if (COMBI_KEYS_SEQUENCE_MAX == engine->sequence_len) {
+        memmove(engine->sequence, engine->sequence + 1, sizeof(CombiKey_Mask_t) * (COMBI_KEYS_SEQUENCE_MAX - 1));
+        engine->sequence_len--;
+    }
+    engine->sequence[engine->sequence_len++] = mask;
+    engine->sequence_last = now;
+
+    for (uint8_t i = 0; i < engine->sequence_num; i++) {
+        const CombiKey_Sequence_t *sequence = &engine->sequence_table[i];
+        if ((0 == sequence->len) || (sequence->len > engine->sequence_len)) {
+            continue;
+        }
+        // Compare with the end of the history.
+        const CombiKey_Mask_t *tail = engine->sequence + engine->sequence_len - sequence->len;
+        if (0 == memcmp(tail, sequence->steps, sizeof(CombiKey_Mask_t) * sequence->len)) {
+            engine->sequence_len = 0;
+            combi_engine_emit(engine, COMBI_KEY_EVENT_SEQUENCE, mask, sequence->id, now);
+            return;
+        }
+    }
+}
+
+/**
+  * @brief  All keys of the gesture are released.
+  * @param[in]  engine  combi keys engine.
+  * @param[in]  now  current time(us).
+  */
+static void combi_engine_gesture_end(CombiKey_Engine_t *engine, int64_t now)
+{
+    CombiKey_Mask_t mask = engine->gesture;
+
+    if (0 != engine->chord_deadline) {
+        combi_engine_chord_close(engine, now);
+    }
+    engine->gesture = 0;
+    engine->hold_deadline = 0;
+    if (engine->long_sent) {
+        return;
+    }
+
+    combi_engine_sequence_step(engine, mask, now);
+    if (0 == engine->double_click_time) {
+        combi_engine_emit(engine, COMBI_KEY_EVENT_SHORT_PRESS, mask, 0, now);
+    } else if (engine->pending_click == mask) {
+        engine->pending_click = 0;
+        combi_engine_emit(engine, COMBI_KEY_EVENT_DOUBLE_CLICK, mask, 0, now);
+    } else {
+        // A click on other keys ends the previous window.
+        combi_engine_click_flush(engine, now);
+        engine->pending_click = mask;
+        engine->click_deadline = now + (int64_t)engine->double_click_time * 1000;
+    }
+}
+
+/**
+  * @brief  Long press or repeat deadline.
+  * @param[in]  engine  combi keys engine.
+  * @param[in]  now  current time(us).
+  */
+static void combi_engine_hold(CombiKey_Engine_t *engine, int64_t now)
+{
+    engine->hold_deadline = 0;
+    if (!engine->long_sent) {
+        combi_engine_click_flush(engine, now);
+        engine->long_sent = true;
+        engine->sequence_len = 0;
+        engine->repeat_count = 0;
+        engine->repeat_interval = engine->repeat_time;
+        combi_engine_emit(engine, COMBI_KEY_EVENT_LONG_PRESS, engine->gesture, 0, now);
+    } else {
+        engine->repeat_count++;
+        combi_engine_emit(engine, COMBI_KEY_EVENT_REPEAT, engine->gesture, 0, now);
+        uint32_t interval = engine->repeat_interval - engine->repeat_interval * engine->repeat_accel / 100;
+        engine->repeat_interval = (interval < engine->repeat_min_time) ? engine->repeat_min_time : interval;
+    }
+    if (0 != engine->repeat_interval) {
+        engine->hold_deadline = now + (int64_t)engine->repeat_interval * 1000;
+    }
+}
+
+/**
+  * @brief  Combi keys engine initialization.
+  * @param[out]  engine  engine to initialize.
+  * @param[in]  emit  called for every event.
+  * @param[in]  arg  passed to emit.
+  * @note  Long press 2000ms, chord 50ms, sequence 1000ms, repeat and double click disabled.
+  */
+void CombiKeys_EngineInit(CombiKey_Engine_t *engine, CombiKey_EmitCallback_t emit, void *arg)
+{
+    memset(engine, 0, sizeof(CombiKey_Engine_t));
+    engine->long_press_time = 2000;
+    engine->chord_time = 50;
+    engine->sequence_time = 1000;
+    engine->emit = emit;
+    engine->emit_arg = arg;
+}
+
+/**
+  * @brief  Handle expired deadlines.
+  * @param[in]  engine  combi keys engine.
+  * @param[in]  now  current time(us).
+  */
+void CombiKeys_EngineTick(CombiKey_Engine_t *engine, int64_t now)
+{
+    if ((0 != engine->chord_deadline) && (now >= engine->chord_deadline)) {
+        combi_engine_chord_close(engine, now);
+    }
+    if ((0 != engine->hold_deadline) && (now >= engine->hold_deadline)) {
+        combi_engine_hold(engine, now);
+    }
+    if ((0 != engine->click_deadline) && (now >= engine->click_deadline)) {
+        combi_engine_click_flush(engine, now);
+    }
+}
+
+/**
+  * @brief  Feed the new debounced key state.
+  * @param[in]  engine  combi keys engine.
+  * @param[in]  state  one bit per key, set while pressed.
+  * @param[in]  now  current time(us).
+  * @note  Expired deadlines are handled first.
+  */
+void CombiKeys_EngineUpdate(CombiKey_Engine_t *engine, CombiKey_Mask_t state, int64_t now)
+{
+    CombiKey_Mask_t pressed = state & ~engine->state;
+    CombiKey_Mask_t released = engine->state & ~state;
+
+    CombiKeys_EngineTick(engine, now);
+    engine->state = state;
+    for (uint8_t i = 0; i < COMBI_KEYS_MAX; i++) {
+        CombiKey_Mask_t bit = (CombiKey_Mask_t)1 << i;
+        if (pressed & bit) {
+            combi_engine_emit(engine, COMBI_KEY_EVENT_PRESS, bit, 0, now);
+        } else if (released & bit) {
+            combi_engine_emit(engine, COMBI_KEY_EVENT_RELEASE, bit, 0, now);
+        }
+    }
+
+    if (0 != pressed) {
+        if (0 == engine->gesture) {
+            engine->gesture = pressed;
+            engine->long_sent = false;
+            engine->repeat_count = 0;
+            engine->chord_deadline = now + (int64_t)engine->chord_time * 1000;
+            engine->hold_deadline = now + (int64_t)engine->long_press_time * 1000;
+            // The double click decision waits for this gesture to end.
+            engine->click_deadline = 0;
+        } else if (0 != engine->chord_deadline) {
+            engine->gesture |= pressed;
+        }
+        // Keys pressed after the chord window only report press and release.
+    }
+    if (0 != (released & engine->gesture)) {
+        // Hold events need every key of the gesture.
+        engine->hold_deadline = 0;
+    }
+    if ((0 != engine->gesture) && (0 == (state & engine->gesture))) {
+        combi_engine_gesture_end(engine, now);
+    }
+}
+
+/**
+  * @brief  Get the next time CombiKeys_EngineTick() has work to do.
+  * @param[in]  engine  combi keys engine.
+  * @retval 
+  *         - deadline(us), 0 for none.
+  */
+int64_t CombiKeys_EngineNextDeadline(const CombiKey_Engine_t *engine)
+{
+    int64_t deadline = 0;
+    int64_t list[3] = {engine->chord_deadline, engine->hold_deadline, engine->click_deadline};
+
+    for (uint8_t i = 0; i < 3; i++) {
+        if ((0 != list[i]) && ((0 == deadline) || (list[i] < deadline))) {
+            deadline = list[i];
+        }
+    }
+    return deadline;
+}
@@ -26,6 +26,13 @@
 
 #include "driver/gpio.h"
 #include "esp_err.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "combi_keys_engine.h"
+
+#define COMBI_KEY_EVENT_QUEUE_LEN       16      // Events buffered when nobody reads the queue.
+#define COMBI_KEY_DEFAULT_DEBOUNCE_MS   10
 
 // Combination key key value enumeration.
 typedef enum{
@@ -42,12 +49,34 @@ typedef enum{
     COMBI_KEY_VALUE_MAX,
 }CombiKey_Value_t;
 
+// Key number of the three key board used by CombiKeys_Init().
+typedef enum{
+    COMBI_KEY_UP,
+    COMBI_KEY_MID,
+    COMBI_KEY_DOWN,
+    COMBI_KEY_NUM,
+}CombiKey_Id_t;
+
+typedef struct CombiKey CombiKey_t;
+
+// Debounce state of one key, only touched by its ISR and its timer callback.
 typedef struct{
-    gpio_num_t key_up;
-    gpio_num_t key_mid;
-    gpio_num_t key_down;
-    uint32_t long_press_time;    // ms
-}CombiKey_t;
+    CombiKey_t *owner;
+    uint8_t id;
+    gpio_num_t pin;
+    esp_timer_handle_t timer;       // One shot debounce timer, the pin interrupt is off while it runs.
+}CombiKey_Key_t;
+
+struct CombiKey{
+    uint8_t key_num;
+    uint32_t debounce_time;         // ms
+    QueueHandle_t event_queue;
+    uint32_t event_lost;            // Events dropped because the queue was full.
+    CombiKey_Mask_t state;          // Debounced level, bit set while pressed.
+    esp_timer_handle_t engine_timer;    // One shot, runs the engine at its next deadline.
+    CombiKey_Engine_t engine;       // Only used from the esp_timer task.
+    CombiKey_Key_t key[];
+};
 typedef CombiKey_t *CombiKey_handle_t;
     
 /**
@@ -59,10 +88,25 @@ typedef CombiKey_t *CombiKey_handle_t;
   *         successful  CombiKeys operation handle.
   *         failed      NULL.
   * @note  Use CombiKeys_Deinit() to release it.
-  * @note  The default long press time is 2000ms.
+  * @note  The keys are active low. Every edge starts a one shot debounce timer for that key, 
+  *        debounced events are sent to the handle event queue, nothing runs while the keys are idle.
+  * @note  The default long press time is 2000ms and the default debounce time is 10ms, 
+  *        repeat and double click are disabled by default.
   */
 CombiKey_handle_t CombiKeys_Init(gpio_num_t key_up, gpio_num_t key_mid, gpio_num_t key_down);
 
+/**
+  * @brief  Combination key initialization with any number of keys.
+  * @param[in]  pins  key pins, key n of the events is pins[n].
+  * @param[in]  key_num  number of keys, at most COMBI_KEYS_MAX.
+  * @retval  
+  *         successful  CombiKeys operation handle.
+  *         failed      NULL.
+  * @note  Use CombiKeys_Deinit() to release it.
+  * @note  Same defaults as CombiKeys_Init().
+  */
+CombiKey_handle_t CombiKeys_InitKeys(const gpio_num_t *pins, uint8_t key_num);
+
 /**
   * @brief  combi keys deinitialization.
   * @param[in]  combi_keys_handle  combi keys operation handle pointer.
@@ -83,14 +127,100 @@ esp_err_t CombiKeys_Deinit(CombiKey_handle_t* combi_keys_handle);
   */
 esp_err_t CombiKeys_SetLongPress(CombiKey_handle_t combi_keys_handle, uint32_t time_ms);
 
+/**
+  * @brief  combi keys Set debounce time.
+  * @param[in]  combi_keys_handle  combi keys operation handle.
+  * @param[in]  time_ms  debounce time(ms), the level must be stable this long.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note   The default debounce time is 10ms, this is also the event latency.
+  */
+esp_err_t CombiKeys_SetDebounce(CombiKey_handle_t combi_keys_handle, uint32_t time_ms);
+
+/**
+  * @brief  combi keys Set hold repeat interval.
+  * @param[in]  combi_keys_handle  combi keys operation handle.
+  * @param[in]  time_ms  repeat interval(ms), 0 disables repeat events.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note   Repeat events start after the long press event.
+  */
+esp_err_t CombiKeys_SetRepeat(CombiKey_handle_t combi_keys_handle, uint32_t time_ms);
+
+/**
+  * @brief  combi keys Set hold repeat acceleration.
+  * @param[in]  combi_keys_handle  combi keys operation handle.
+  * @param[in]  accel  percent the repeat interval shrinks after each repeat, 0 keeps it constant.
+  * @param[in]  min_time_ms  shortest repeat interval(ms).
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t CombiKeys_SetRepeatAccel(CombiKey_handle_t combi_keys_handle, uint8_t accel, uint32_t min_time_ms);
+
+/**
+  * @brief  combi keys Set double click time.
+  * @param[in]  combi_keys_handle  combi keys operation handle.
+  * @param[in]  time_ms  max time(ms) from the first release to the second press, 0 disables double click.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note   While enabled, the short press event is held back until the window has passed.
+  */
+esp_err_t CombiKeys_SetDoubleClick(CombiKey_handle_t combi_keys_handle, uint32_t time_ms);
+
+/**
+  * @brief  combi keys Set the chord table.
+  * @param[in]  combi_keys_handle  combi keys operation handle.
+  * @param[in]  table  chord table, must stay valid while in use.
+  * @param[in]  num  number of chords.
+  * @param[in]  time_ms  max time(ms) from the first to the last key of a chord.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note   The default chord time is 50ms.
+  */
+esp_err_t CombiKeys_SetChords(CombiKey_handle_t combi_keys_handle, const CombiKey_Chord_t *table, uint8_t num, 
+                              uint32_t time_ms);
+
+/**
+  * @brief  combi keys Set the sequence table.
+  * @param[in]  combi_keys_handle  combi keys operation handle.
+  * @param[in]  table  sequence table, must stay valid while in use.
+  * @param[in]  num  number of sequences.
+  * @param[in]  time_ms  max time(ms) between two steps of a sequence.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note   The default sequence time is 1000ms, long presses clear the sequence history.
+  */
+esp_err_t CombiKeys_SetSequences(CombiKey_handle_t combi_keys_handle, const CombiKey_Sequence_t *table, uint8_t num, 
+                                 uint32_t time_ms);
+
+/**
+  * @brief  Wait for the next key event.
+  * @param[in]  combi_keys_handle  combi keys operation handle.
+  * @param[out]  event  key event.
+  * @param[in]  timeout_ms  max wait time(ms), portMAX_DELAY waits forever.
+  * @retval 
+  *         - ESP_OK            successful.
+  *         - ESP_ERR_TIMEOUT   no event in time.
+  *         - ESP_FAIL          failed.
+  */
+esp_err_t CombiKeys_WaitEvent(CombiKey_handle_t combi_keys_handle, CombiKey_Event_t *event, uint32_t timeout_ms);
+
 /**
   * @brief  Get the key combination of keys
   * @param[in]  combi_keys_handle  combi keys combi keys operation handle.
   * @retval 
   *         - key value combi_Key_Value_t.
   * @note  
-  *         Only one can support the detection of one button at a time.
-  *         Support three states: press, short press and long press.
+  *         Kept for compatibility, takes one event from the queue without waiting.
+  *         Press is reported once per press, long press is reported when the long press time is reached.
+  *         Events without a key value are dropped, use CombiKeys_WaitEvent() to get all of them.
+  *         Only single key events of the first three keys have a key value.
   */
 CombiKey_Value_t CombiKeys_GetValue(CombiKey_handle_t combi_keys_handle);
 
@@ -0,0 +1,145 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           combi_keys_engine.h
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#ifndef __COMBI_KEYS_ENGINE_H_
+#define __COMBI_KEYS_ENGINE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define COMBI_KEYS_MAX          32      // Keys per engine, one bit each in CombiKey_Mask_t.
+#define COMBI_KEYS_SEQUENCE_MAX 8       // Longest sequence that can be matched.
+
+// One bit per key, bit n is key n.
+typedef uint32_t CombiKey_Mask_t;
+
+// Key event type.
+typedef enum{
+    COMBI_KEY_EVENT_PRESS,          // Debounced press of one key.
+    COMBI_KEY_EVENT_RELEASE,        // Debounced release of one key.
+    COMBI_KEY_EVENT_SHORT_PRESS,    // Keys released before the long press time.
+    COMBI_KEY_EVENT_LONG_PRESS,     // Keys held for the long press time.
+    COMBI_KEY_EVENT_REPEAT,         // Still held, repeats after the long press with a shrinking interval.
+    COMBI_KEY_EVENT_DOUBLE_CLICK,   // Second short press of the same keys within the double click time.
+    COMBI_KEY_EVENT_CHORD,          // Keys of a chord table entry pressed within the chord time.
+    COMBI_KEY_EVENT_SEQUENCE,       // Short presses matching a sequence table entry.
+    COMBI_KEY_EVENT_MAX,
+}CombiKey_EventType_t;
+
+typedef struct{
+    CombiKey_EventType_t type;
+    uint8_t key;                    // Lowest key number in mask.
+    CombiKey_Mask_t mask;           // Keys of the event, a single bit for press and release.
+    uint16_t id;                    // Chord or sequence id from the table.
+    uint16_t count;                 // Repeat number, starts at 1.
+    int64_t time_us;                // Event time.
+}CombiKey_Event_t;
+
+// Chord table entry, all keys of mask pressed together.
+typedef struct{
+    CombiKey_Mask_t mask;
+    uint16_t id;
+}CombiKey_Chord_t;
+
+// Sequence table entry, short presses of steps[0] to steps[len-1] in order, a step may be a chord.
+typedef struct{
+    const CombiKey_Mask_t *steps;
+    uint8_t len;
+    uint16_t id;
+}CombiKey_Sequence_t;
+
+typedef void (*CombiKey_EmitCallback_t)(const CombiKey_Event_t *event, void *arg);
+
+/*
+ * Gesture engine over the debounced key state, without any allocation or hardware access.
+ * A gesture starts with the first press from all keys released, keys pressed within the chord 
+ * time join it, and it ends when all of its keys are released.
+ */
+typedef struct{
+    // Timing (ms), may be changed at any time.
+    uint32_t long_press_time;
+    uint32_t repeat_time;           // First repeat interval, 0 disables repeat events.
+    uint32_t repeat_min_time;       // Shortest repeat interval.
+    uint8_t repeat_accel;           // Percent the interval shrinks after each repeat.
+    uint32_t double_click_time;     // 0 disables double click detection.
+    uint32_t chord_time;            // Window after the first press for the other chord keys.
+    uint32_t sequence_time;         // Max gap between two steps of a sequence.
+
+    // Tables, owned by the caller.
+    const CombiKey_Chord_t *chord_table;
+    uint8_t chord_num;
+    const CombiKey_Sequence_t *sequence_table;
+    uint8_t sequence_num;
+
+    CombiKey_EmitCallback_t emit;
+    void *emit_arg;
+
+    // State.
+    CombiKey_Mask_t state;          // Debounced level of every key.
+    CombiKey_Mask_t gesture;        // Keys of the current gesture, 0 while idle.
+    bool long_sent;
+    uint16_t repeat_count;
+    uint32_t repeat_interval;
+    CombiKey_Mask_t pending_click;  // Short press waiting for the double click window.
+    CombiKey_Mask_t sequence[COMBI_KEYS_SEQUENCE_MAX];
+    uint8_t sequence_len;
+    int64_t sequence_last;
+    int64_t chord_deadline;         // Deadlines (us), 0 for none.
+    int64_t hold_deadline;
+    int64_t click_deadline;
+}CombiKey_Engine_t;
+
+/**
+  * @brief  Combi keys engine initialization.
+  * @param[out]  engine  engine to initialize.
+  * @param[in]  emit  called for every event.
+  * @param[in]  arg  passed to emit.
+  * @note  Long press 2000ms, chord 50ms, sequence 1000ms, repeat and double click disabled.
+  */
+void CombiKeys_EngineInit(CombiKey_Engine_t *engine, CombiKey_EmitCallback_t emit, void *arg);
+
+/**
+  * @brief  Feed the new debounced key state.
+  * @param[in]  engine  combi keys engine.
+  * @param[in]  state  one bit per key, set while pressed.
+  * @param[in]  now  current time(us).
+  * @note  Expired deadlines are handled first.
+  */
+void CombiKeys_EngineUpdate(CombiKey_Engine_t *engine, CombiKey_Mask_t state, int64_t now);
+
+/**
+  * @brief  Handle expired deadlines.
+  * @param[in]  engine  combi keys engine.
+  * @param[in]  now  current time(us).
+  */
+void CombiKeys_EngineTick(CombiKey_Engine_t *engine, int64_t now);
+
+/**
+  * @brief  Get the next time CombiKeys_EngineTick() has work to do.
+  * @param[in]  engine  combi keys engine.
+  * @retval 
+  *         - deadline(us), 0 for none.
+  */
+int64_t CombiKeys_EngineNextDeadline(const CombiKey_Engine_t *engine);
+
+#endif /* __COMBI_KEYS_ENGINE_H_ */
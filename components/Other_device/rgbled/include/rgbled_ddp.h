@@ -0,0 +1,88 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           rgbled_ddp.h
+  * @version        1.0
+  * @date           2026-10-19
+  * @brief          DDP(Distributed Display Protocol) packet parser.
+  *                 Plain C without ESP-IDF dependencies.
+  */
+
+#ifndef _RGBLED_DDP_H_
+#define _RGBLED_DDP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RGBLED_DDP_PORT                 4048
+#define RGBLED_DDP_HEADER_LEN           10
+#define RGBLED_DDP_TIMECODE_LEN         4
+#define RGBLED_DDP_DATA_MAX             1440    // 480 RGB LEDs, fits one Ethernet frame.
+#define RGBLED_DDP_PACKET_MAX           (RGBLED_DDP_HEADER_LEN + RGBLED_DDP_TIMECODE_LEN + RGBLED_DDP_DATA_MAX)
+
+// Header byte 0.
+#define RGBLED_DDP_FLAG_VER_MASK        0xC0
+#define RGBLED_DDP_FLAG_VER1            0x40
+#define RGBLED_DDP_FLAG_TIMECODE        0x10
+#define RGBLED_DDP_FLAG_STORAGE         0x08
+#define RGBLED_DDP_FLAG_REPLY           0x04
+#define RGBLED_DDP_FLAG_QUERY           0x02
+#define RGBLED_DDP_FLAG_PUSH            0x01    // Last packet of a frame, show it.
+
+// Header byte 1, 1 ~ 15, 0: not used.
+#define RGBLED_DDP_SEQ_MASK             0x0F
+#define RGBLED_DDP_SEQ_NUM              15
+
+// Header byte 2, bit 7 custom, bits 5 ~ 3 data type, bits 2 ~ 0 bits per element.
+#define RGBLED_DDP_TYPE_RGB8            0x0B    // RGB, 8 bits per channel, the only type shown.
+
+// Header byte 3.
+#define RGBLED_DDP_ID_DISPLAY           1
+#define RGBLED_DDP_ID_CONTROL           246     // 246 and up are not pixel data.
+
+typedef struct{
+    uint8_t flags;
+    uint8_t seq;
+    uint8_t type;
+    uint8_t id;
+    uint32_t offset;                // Byte offset of the data in the frame.
+    uint16_t len;                   // Data length, unit: byte.
+    const uint8_t *data;            // Points into the packet buffer.
+}RGBled_DdpPacket_t;
+
+/**
+  * @brief  Parse a DDP packet, the data is not copied.
+  * @param[in]  buf  packet received from UDP.
+  * @param[in]  size  packet length.
+  * @param[out]  packet  parsed header and data pointer.
+  * @retval  0: RGB888 pixel data, -1: invalid, not pixel data or another data type.
+  */
+int RGBled_DdpParse(const uint8_t *buf, uint32_t size, RGBled_DdpPacket_t *packet);
+
+/**
+  * @brief  Number of packets lost between two sequence numbers.
+  * @param[in]  last  sequence number of the previous packet.
+  * @param[in]  seq  sequence number of this packet.
+  * @retval  
+  *         0 ~ RGBLED_DDP_SEQ_NUM/2  packets lost.
+  *         -1  duplicate or late packet.
+  * @note  0 is returned when either packet has no sequence number.
+  */
+int RGBled_DdpSeqLost(uint8_t last, uint8_t seq);
+
+#endif /* _RGBLED_DDP_H_ */
@@ -27,9 +27,14 @@
 #include "esp_err.h"
 #include "driver/gpio.h"
 #include "driver/rmt.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "rgbled_output.h"
 
 #define RGBLED_RMT_CLK_DIV              2
 #define RGBLED_BITS_PER_LED_CMD         24 
+#define RGBLED_BYTES_PER_LED            3       // GRB888.
+#define RGBLED_RMT_MEM_BLOCK_NUM        3       // Default RMT memory blocks of a strip.
 
 // Supported device model.
 typedef enum{
@@ -73,6 +78,15 @@ typedef struct{
     gpio_num_t io_num;
     uint32_t led_len;
     rmt_channel_t rmt_channel;
+    uint8_t mem_block_num;          // RMT memory blocks, rmt_channel ~ rmt_channel+mem_block_num-1.
+    uint8_t *front_buf;             // GRB888 frame on the wire, RGBLED_BYTES_PER_LED per LED.
+    uint8_t *back_buf;              // GRB888 frame being drawn, RGBLED_BYTES_PER_LED per LED.
+    RGBled_Output_t *output;        // Gamma, brightness and dithering, NULL: sent as drawn.
+    uint32_t dirty_start;           // LEDs changed since the last frame, dirty_start ~ dirty_end-1.
+    uint32_t dirty_end;
+    SemaphoreHandle_t tx_done;      // Given by the RMT TX end interrupt.
+    volatile int64_t tx_end_time;   // esp_timer time of the last TX end, unit: us.
+    uint32_t reset_us;              // Reset time of the device, unit: us.
 }RGBled_t;
 typedef RGBled_t *RGBled_handle_t;
 
@@ -86,10 +100,33 @@ typedef RGBled_t *RGBled_handle_t;
   *         successful  RGBled operation handle.
   *         failed      NULL.
   * @note  Use RGBled_Deinit() to release it.
+  * @note  The frame buffers are allocated here, sending a frame does not allocate memory.
+  * @note  The GRB888 data is expanded to RMT items by the RMT translator while it is sent, 
+  *        so the memory cost is 2 * RGBLED_BYTES_PER_LED bytes per LED(front and back buffer).
+  * @note  The RMT TX end callback is registered here, it is shared by all RMT channels.
+  * @note  RGBLED_RMT_MEM_BLOCK_NUM memory blocks are used, see RGBled_InitMemBlock().
   */
 RGBled_handle_t RGBled_Init(RGBled_DeviceType_t device_type, gpio_num_t io_num, 
                             uint32_t led_len, rmt_channel_t rmt_channel);
 
+/**
+  * @brief  Initialization RGB LED with a given number of RMT memory blocks.
+  * @param[in]  device_type  Supported device model. (See RGBled_DeviceType_t)
+  * @param[in]  io_num  IO port used by RGB LED.
+  * @param[in]  led_len  Number of LEDs.
+  * @param[in]  rmt_channel  rmt channel used.
+  * @param[in]  mem_block_num  RMT memory blocks used, 1 ~ RMT_CHANNEL_MAX-rmt_channel.
+  * @retval  
+  *         successful  RGBled operation handle.
+  *         failed      NULL.
+  * @note  A channel using n memory blocks also takes the blocks of the next n-1 channels, 
+  *        Init fails if any of them is used by another strip.
+  * @note  Use RGBled_Deinit() to release it.
+  */
+RGBled_handle_t RGBled_InitMemBlock(RGBled_DeviceType_t device_type, gpio_num_t io_num, 
+                                    uint32_t led_len, rmt_channel_t rmt_channel, 
+                                    uint8_t mem_block_num);
+
 /**
   * @brief  RGBled deinitialization.
   * @param[in]  rgb_handle  RGBled operation handle pointer.
@@ -109,6 +146,143 @@ esp_err_t RGBled_Deinit(RGBled_handle_t* rgb_handle);
   */
 RGBled_Color_t RGBled_GetRgb888(uint8_t red, uint8_t green, uint8_t blue);
 
+/**
+  * @brief  RGBled Draw one LED into the back buffer.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  index  LED index.
+  * @param[in]  color  RGB888 color data.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Use RGBled_Present() to show the back buffer.
+  */
+esp_err_t RGBled_SetPixel(RGBled_handle_t rgb_handle, uint32_t index, RGBled_Color_t color);
+
+/**
+  * @brief  RGBled Draw a run of LEDs in one color into the back buffer.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  start  first LED index.
+  * @param[in]  len  number of LEDs, clipped to the strip.
+  * @param[in]  color  RGB888 color data.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Use RGBled_Present() to show the back buffer.
+  */
+esp_err_t RGBled_FillPixel(RGBled_handle_t rgb_handle, uint32_t start, uint32_t len, RGBled_Color_t color);
+
+/**
+  * @brief  RGBled Draw a color array into the back buffer.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  start  first LED index.
+  * @param[in]  color_list  RGB888 color array.
+  * @param[in]  len  number of colors, clipped to the strip.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Use RGBled_Present() to show the back buffer.
+  */
+esp_err_t RGBled_CopyPixel(RGBled_handle_t rgb_handle, uint32_t start, 
+                           const RGBled_Color_t *color_list, uint32_t len);
+
+/**
+  * @brief  RGBled Write a RGB888 byte stream into the back buffer.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  offset  byte offset in the frame, LED index * 3 + color(0:red 1:green 2:blue).
+  * @param[in]  data  RGB888 bytes.
+  * @param[in]  len  number of bytes, clipped to the strip.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The offset does not have to start at a LED, used for network pixel streams.
+  * @note  Use RGBled_Present() to show the back buffer.
+  */
+esp_err_t RGBled_CopyRgbBytes(RGBled_handle_t rgb_handle, uint32_t offset, 
+                              const uint8_t *data, uint32_t len);
+
+/**
+  * @brief  RGBled Show the back buffer.
+  *         Waits for the previous frame and the device reset time, copies the back buffer 
+  *         through the output stage into the front buffer and starts the transmission 
+  *         without waiting for it.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The back buffer keeps the drawn frame, the next frame can be drawn while 
+  *        this one is on the wire.
+  * @note  Only the LEDs changed since the last frame are copied, a frame without 
+  *        changes is not sent. Use RGBled_Invalidate() to send it anyway.
+  */
+esp_err_t RGBled_Present(RGBled_handle_t rgb_handle);
+
+/**
+  * @brief  RGBled Mark the whole frame as changed, the next RGBled_Present() sends it.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Used when the LEDs lost their state, e.g. after a power cycle of the strip.
+  */
+esp_err_t RGBled_Invalidate(RGBled_handle_t rgb_handle);
+
+/**
+  * @brief  RGBled Wait for the presented frame to leave the wire.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  wait_time  maximum wait time, unit: tick.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_ERR_TIMEOUT  timeout.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_WaitPresentDone(RGBled_handle_t rgb_handle, TickType_t wait_time);
+
+/**
+  * @brief  RGBled Set the gamma of the output stage.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  gamma  output = input ^ gamma, 1.0 is linear, 2.2 ~ 2.8 for common LEDs.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The output stage LUT is allocated on first use, 
+  *        call the output stage functions from the task drawing the frames.
+  */
+esp_err_t RGBled_SetGamma(RGBled_handle_t rgb_handle, float gamma);
+
+/**
+  * @brief  RGBled Set the global brightness of the output stage.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  brightness  0 ~ 255.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_SetBrightness(RGBled_handle_t rgb_handle, uint8_t brightness);
+
+/**
+  * @brief  RGBled Set the per channel scale of the output stage, used as white balance.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  red  red scale(0~255).
+  * @param[in]  green  green scale(0~255).
+  * @param[in]  blue  blue scale(0~255).
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_SetColorScale(RGBled_handle_t rgb_handle, uint8_t red, uint8_t green, uint8_t blue);
+
+/**
+  * @brief  RGBled Enable temporal dithering of the output stage.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  enable  true: dithering on.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The levels between two output steps are reached by alternating them over 
+  *        RGBLED_OUTPUT_DITHER_FRAMES frames, RGBled_Present() has to be called continuously.
+  */
+esp_err_t RGBled_SetDither(RGBled_handle_t rgb_handle, bool enable);
+
 /**
   * @brief  RGBled Sets the color of all LEDs.
   * @param[in]  rgb_handle  RGBled operation handle.
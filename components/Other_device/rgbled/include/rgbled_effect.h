@@ -0,0 +1,257 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           rgbled_effect.h
+  * @version        1.0
+  * @date           2026-10-19
+  * @brief          RGBled effects, layers, blending and transitions.
+  *                 Plain C without ESP-IDF dependencies, integer math only.
+  */
+
+#ifndef _RGBLED_EFFECT_H_
+#define _RGBLED_EFFECT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RGBLED_HSV_HUE_MAX              1536    // 6 sectors of 256 steps.
+#define RGBLED_EFFECT_LAYER_MAX         4
+
+// Built in effects.
+typedef enum{
+    RGBLED_EFFECT_SOLID,            // color on all LEDs.
+    RGBLED_EFFECT_GRADIENT,         // all LEDs walk the hue circle.
+    RGBLED_EFFECT_RAINBOW,          // hue spread over the strip, scrolling.
+    RGBLED_EFFECT_ROLL,             // color_list scrolling along the strip.
+    RGBLED_EFFECT_FILL_IN,          // color filling the strip one LED per step.
+    RGBLED_EFFECT_BREATH,           // color fading in and out.
+    RGBLED_EFFECT_CUSTOM,           // render callback.
+    RGBLED_EFFECT_TYPE_MAX,
+}RGBled_EffectType_t;
+
+// How a layer is combined with the layers below it.
+typedef enum{
+    RGBLED_BLEND_NORMAL,            // layer covers the layers below.
+    RGBLED_BLEND_ADD,               // saturating add, black is transparent.
+    RGBLED_BLEND_MULTIPLY,          // darkens, white is transparent.
+    RGBLED_BLEND_LIGHTEN,           // per channel maximum, black is transparent.
+    RGBLED_BLEND_MODE_MAX,
+}RGBled_BlendMode_t;
+
+struct RGBled_Effect;
+
+/**
+  * @brief  Render one frame of a custom effect.
+  * @param[in,out]  effect  effect state, effect->frame is the frame number.
+  * @param[out]  pixels  RGB888 frame, led_len LEDs.
+  * @param[in]  led_len  Number of LEDs.
+  * @note  Set effect->done when a one shot effect reached its last frame.
+  */
+typedef void (*RGBled_EffectRender_t)(struct RGBled_Effect *effect, uint32_t *pixels, uint32_t led_len);
+
+// Effect state, created by the RGBled_Effect* functions and copied into a layer.
+typedef struct RGBled_Effect{
+    RGBled_EffectType_t type;
+    uint32_t color;                 // RGB888, SOLID, FILL_IN and BREATH.
+    const uint32_t *color_list;     // RGB888 array of ROLL, must stay valid while the effect runs.
+    uint32_t color_num;
+    uint16_t hue;                   // Start hue of GRADIENT and RAINBOW, 0 ~ RGBLED_HSV_HUE_MAX-1.
+    uint16_t hue_step;              // Hue change per step(GRADIENT) or per LED(RAINBOW).
+    uint16_t step_frames;           // Frames per step, or frames per period of BREATH.
+    bool once;                      // ROLL and FILL_IN stop after one pass and hold the last frame.
+    RGBled_EffectRender_t render;   // CUSTOM.
+    void *arg;                      // CUSTOM.
+    uint32_t frame;                 // Frames rendered since the effect was started.
+    bool done;                      // One shot effect reached its last frame.
+}RGBled_Effect_t;
+
+typedef struct{
+    RGBled_Effect_t effect;
+    RGBled_Effect_t prev;           // Effect faded out by a crossfade.
+    RGBled_BlendMode_t blend;
+    bool active;
+    uint8_t opacity;
+    uint8_t fade_from;              // Opacity transition.
+    uint8_t fade_to;
+    uint16_t fade_frames;
+    uint16_t fade_count;
+    bool clear_after_fade;          // Cancelled, the layer is removed when faded out.
+    uint16_t xfade_frames;          // Crossfade from prev to effect.
+    uint16_t xfade_count;
+}RGBled_EffectLayer_t;
+
+typedef struct{
+    RGBled_EffectLayer_t layer[RGBLED_EFFECT_LAYER_MAX];    // 0 is the bottom layer.
+    uint32_t led_len;
+    uint32_t *layer_buf;            // Frame of the layer being rendered.
+    uint32_t *prev_buf;             // Frame of the effect faded out by a crossfade.
+}RGBled_EffectStack_t;
+typedef RGBled_EffectStack_t *RGBled_EffectStackHandle_t;
+
+/**
+  * @brief  Fixed point HSV to RGB888.
+  * @param[in]  hue  0 ~ RGBLED_HSV_HUE_MAX-1, larger values wrap.
+  * @param[in]  sat  saturation(0~255).
+  * @param[in]  val  value(0~255).
+  * @retval  RGB888 color data.
+  */
+uint32_t RGBled_HsvToRgb(uint16_t hue, uint8_t sat, uint8_t val);
+
+/**
+  * @brief  Mix two RGB888 colors.
+  * @param[in]  from  RGB888 color at t = 0.
+  * @param[in]  to  RGB888 color at t = 255.
+  * @param[in]  t  0 ~ 255.
+  * @retval  RGB888 color data.
+  */
+uint32_t RGBled_ColorMix(uint32_t from, uint32_t to, uint8_t t);
+
+/**
+  * @brief  Scale a RGB888 color.
+  * @param[in]  color  RGB888 color data.
+  * @param[in]  level  0 ~ 255.
+  * @retval  RGB888 color data.
+  */
+uint32_t RGBled_ColorScale(uint32_t color, uint8_t level);
+
+/**
+  * @brief  All LEDs in one color.
+  * @param[in]  color  RGB888 color data.
+  */
+RGBled_Effect_t RGBled_EffectSolid(uint32_t color);
+
+/**
+  * @brief  All LEDs walk the hue circle.
+  * @param[in]  hue_step  hue change per step, RGBLED_HSV_HUE_MAX is a full circle.
+  * @param[in]  step_frames  frames per step.
+  */
+RGBled_Effect_t RGBled_EffectGradient(uint16_t hue_step, uint16_t step_frames);
+
+/**
+  * @brief  Hue spread over the strip, scrolling one LED per step.
+  * @param[in]  hue_step  hue change per LED.
+  * @param[in]  step_frames  frames per step.
+  */
+RGBled_Effect_t RGBled_EffectRainbow(uint16_t hue_step, uint16_t step_frames);
+
+/**
+  * @brief  A color array scrolling along the strip, one LED per step.
+  * @param[in]  color_list  RGB888 color array, repeated along the strip.
+  * @param[in]  color_num  number of colors.
+  * @param[in]  step_frames  frames per step.
+  * @param[in]  once  stop after one pass, holding step color_num-1, the last frame before it repeats.
+  */
+RGBled_Effect_t RGBled_EffectRoll(const uint32_t *color_list, uint32_t color_num, uint16_t step_frames, bool once);
+
+/**
+  * @brief  A color filling the strip, one LED per step.
+  * @param[in]  color  RGB888 color data.
+  * @param[in]  step_frames  frames per step.
+  * @param[in]  once  stop when the strip is full, otherwise start again.
+  */
+RGBled_Effect_t RGBled_EffectFillIn(uint32_t color, uint16_t step_frames, bool once);
+
+/**
+  * @brief  A color fading in and out.
+  * @param[in]  color  RGB888 color data.
+  * @param[in]  period_frames  frames of one breath.
+  */
+RGBled_Effect_t RGBled_EffectBreath(uint32_t color, uint16_t period_frames);
+
+/**
+  * @brief  Effect drawn by a callback.
+  * @param[in]  render  render callback.
+  * @param[in]  arg  user argument, effect->arg in the callback.
+  */
+RGBled_Effect_t RGBled_EffectCustom(RGBled_EffectRender_t render, void *arg);
+
+/**
+  * @brief  Render the next frame of an effect.
+  * @param[in,out]  effect  effect state, advanced by one frame.
+  * @param[out]  pixels  RGB888 frame.
+  * @param[in]  led_len  Number of LEDs.
+  */
+void RGBled_EffectRender(RGBled_Effect_t *effect, uint32_t *pixels, uint32_t led_len);
+
+/**
+  * @brief  Create an effect stack.
+  * @param[in]  led_len  Number of LEDs.
+  * @retval  
+  *         successful  effect stack handle.
+  *         failed      NULL.
+  * @note  Use RGBled_EffectStackDeinit() to release it.
+  */
+RGBled_EffectStackHandle_t RGBled_EffectStackInit(uint32_t led_len);
+
+/**
+  * @brief  Delete an effect stack.
+  * @param[in]  stack  effect stack handle pointer.
+  */
+void RGBled_EffectStackDeinit(RGBled_EffectStackHandle_t *stack);
+
+/**
+  * @brief  Start an effect on a layer.
+  * @param[in]  stack  effect stack handle.
+  * @param[in]  index  layer index, 0 ~ RGBLED_EFFECT_LAYER_MAX-1, 0 is the bottom layer.
+  * @param[in]  effect  effect, copied into the layer and started from frame 0.
+  * @param[in]  blend  blend mode of the layer.
+  * @param[in]  fade_frames  transition length, 0 switches at once.
+  * @retval  0: successful, -1: invalid argument.
+  * @note  A running effect on the layer is crossfaded into the new one, 
+  *        an empty layer fades in from transparent.
+  */
+int RGBled_EffectStackSetLayer(RGBled_EffectStackHandle_t stack, uint8_t index, 
+                               const RGBled_Effect_t *effect, RGBled_BlendMode_t blend, 
+                               uint16_t fade_frames);
+
+/**
+  * @brief  Fade the opacity of a layer.
+  * @param[in]  stack  effect stack handle.
+  * @param[in]  index  layer index.
+  * @param[in]  opacity  target opacity(0~255).
+  * @param[in]  fade_frames  transition length, 0 switches at once.
+  * @retval  0: successful, -1: invalid argument or empty layer.
+  */
+int RGBled_EffectStackFadeLayer(RGBled_EffectStackHandle_t stack, uint8_t index, 
+                                uint8_t opacity, uint16_t fade_frames);
+
+/**
+  * @brief  Cancel the effect of a layer.
+  * @param[in]  stack  effect stack handle.
+  * @param[in]  index  layer index.
+  * @param[in]  fade_frames  fade out length, 0 removes the layer at once.
+  * @retval  0: successful, -1: invalid argument.
+  */
+int RGBled_EffectStackClearLayer(RGBled_EffectStackHandle_t stack, uint8_t index, uint16_t fade_frames);
+
+/**
+  * @brief  Whether a layer holds an effect, including one that is fading out.
+  * @param[in]  stack  effect stack handle.
+  * @param[in]  index  layer index.
+  * @retval  true: active.
+  */
+bool RGBled_EffectStackIsLayerActive(RGBled_EffectStackHandle_t stack, uint8_t index);
+
+/**
+  * @brief  Render the next frame of all layers and advance the transitions.
+  * @param[in]  stack  effect stack handle.
+  * @param[out]  pixels  RGB888 frame, led_len LEDs.
+  */
+void RGBled_EffectStackRender(RGBled_EffectStackHandle_t stack, uint32_t *pixels);
+
+#endif /* _RGBLED_EFFECT_H_ */
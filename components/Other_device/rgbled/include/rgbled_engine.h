@@ -0,0 +1,120 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           rgbled_engine.h
+  * @version        1.0
+  * @date           2026-10-19
+  * @brief          RGBled effects engine, an esp_timer frame clock rendering 
+  *                 the layers of an effect stack into a strip.
+  */
+
+#ifndef _RGBLED_ENGINE_H_
+#define _RGBLED_ENGINE_H_
+
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "rgbled_driver.h"
+#include "rgbled_effect.h"
+
+#define RGBLED_ENGINE_TASK_STACK_SIZE   (3072)  // Render task stack size.
+#define RGBLED_ENGINE_FPS_MAX           200
+
+typedef struct{
+    RGBled_handle_t rgb_handle;
+    RGBled_EffectStackHandle_t stack;
+    RGBled_Color_t *pixels;         // Frame rendered by the stack.
+    SemaphoreHandle_t lock;         // Protects the stack.
+    esp_timer_handle_t timer;       // Frame clock.
+    TaskHandle_t task;
+    volatile bool task_exit;
+}RGBled_Engine_t;
+typedef RGBled_Engine_t *RGBled_EngineHandle_t;
+
+/**
+  * @brief  Start an effects engine on a strip.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  fps  frame rate, 1 ~ RGBLED_ENGINE_FPS_MAX.
+  * @param[in]  task_priority  render task priority.
+  * @retval  
+  *         successful  RGBled engine handle.
+  *         failed      NULL.
+  * @note  The engine owns the back buffer of the strip until RGBled_EngineDeinit().
+  * @note  A frame that is not rendered in time is dropped, 
+  *        the frame rate is also bounded by the frame time of the strip.
+  */
+RGBled_EngineHandle_t RGBled_EngineInit(RGBled_handle_t rgb_handle, uint32_t fps, UBaseType_t task_priority);
+
+/**
+  * @brief  Stop an effects engine.
+  * @param[in]  engine  RGBled engine handle pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_EngineDeinit(RGBled_EngineHandle_t *engine);
+
+/**
+  * @brief  Start an effect on a layer, see RGBled_EffectStackSetLayer().
+  * @param[in]  engine  RGBled engine handle.
+  * @param[in]  index  layer index, 0 ~ RGBLED_EFFECT_LAYER_MAX-1, 0 is the bottom layer.
+  * @param[in]  effect  effect, copied into the layer.
+  * @param[in]  blend  blend mode of the layer.
+  * @param[in]  fade_frames  transition length, 0 switches at once.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_EngineSetLayer(RGBled_EngineHandle_t engine, uint8_t index, const RGBled_Effect_t *effect, 
+                                RGBled_BlendMode_t blend, uint16_t fade_frames);
+
+/**
+  * @brief  Fade the opacity of a layer, see RGBled_EffectStackFadeLayer().
+  * @param[in]  engine  RGBled engine handle.
+  * @param[in]  index  layer index.
+  * @param[in]  opacity  target opacity(0~255).
+  * @param[in]  fade_frames  transition length, 0 switches at once.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_EngineFadeLayer(RGBled_EngineHandle_t engine, uint8_t index, 
+                                 uint8_t opacity, uint16_t fade_frames);
+
+/**
+  * @brief  Cancel the effect of a layer, see RGBled_EffectStackClearLayer().
+  * @param[in]  engine  RGBled engine handle.
+  * @param[in]  index  layer index.
+  * @param[in]  fade_frames  fade out length, 0 removes the layer at once.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_EngineClearLayer(RGBled_EngineHandle_t engine, uint8_t index, uint16_t fade_frames);
+
+/**
+  * @brief  Whether a layer holds an effect, including one that is fading out.
+  * @param[in]  engine  RGBled engine handle.
+  * @param[in]  index  layer index.
+  * @retval  true: active.
+  */
+bool RGBled_EngineIsLayerActive(RGBled_EngineHandle_t engine, uint8_t index);
+
+#endif /* _RGBLED_ENGINE_H_ */
@@ -0,0 +1,99 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           rgbled_multi.h
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#ifndef _RGBLED_MULTI_H_
+#define _RGBLED_MULTI_H_
+
+#include "esp_err.h"
+#include "rgbled_driver.h"
+
+#define RGBLED_MULTI_STRIP_MAX          RMT_CHANNEL_MAX
+
+// Configuration of one strip.
+typedef struct{
+    RGBled_DeviceType_t device_type;
+    gpio_num_t io_num;
+    uint32_t led_len;
+    rmt_channel_t rmt_channel;
+    uint8_t mem_block_num;          // RMT memory blocks, rmt_channel ~ rmt_channel+mem_block_num-1.
+}RGBled_StripConfig_t;
+
+typedef struct{
+    RGBled_handle_t strip[RGBLED_MULTI_STRIP_MAX];
+    uint8_t strip_num;
+}RGBled_Multi_t;
+typedef RGBled_Multi_t *RGBled_MultiHandle_t;
+
+/**
+  * @brief  Initialization of a group of strips, each on its own RMT channel.
+  * @param[in]  config  strip configuration array.
+  * @param[in]  strip_num  number of strips, 1 ~ RGBLED_MULTI_STRIP_MAX.
+  * @retval  
+  *         successful  RGBled multi strip operation handle.
+  *         failed      NULL.
+  * @note  The RMT channels and memory blocks of the strips must not overlap, 
+  *        the whole configuration is checked before any strip is initialized.
+  * @note  Use RGBled_MultiDeinit() to release it.
+  */
+RGBled_MultiHandle_t RGBled_MultiInit(const RGBled_StripConfig_t *config, uint8_t strip_num);
+
+/**
+  * @brief  RGBled multi strip deinitialization.
+  * @param[in]  multi_handle  RGBled multi strip operation handle pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_MultiDeinit(RGBled_MultiHandle_t *multi_handle);
+
+/**
+  * @brief  Get the handle of one strip, used to draw into its back buffer.
+  * @param[in]  multi_handle  RGBled multi strip operation handle.
+  * @param[in]  index  strip index, the order of the configuration array.
+  * @retval  RGBled operation handle, NULL if the index is out of range.
+  */
+RGBled_handle_t RGBled_MultiGetStrip(RGBled_MultiHandle_t multi_handle, uint8_t index);
+
+/**
+  * @brief  Show the back buffers of all strips.
+  *         All transmissions are started together, the function does not wait for them.
+  * @param[in]  multi_handle  RGBled multi strip operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The frame time is the one of the longest strip, not the sum of all strips.
+  */
+esp_err_t RGBled_MultiPresent(RGBled_MultiHandle_t multi_handle);
+
+/**
+  * @brief  Wait for the frames of all strips to leave the wire.
+  * @param[in]  multi_handle  RGBled multi strip operation handle.
+  * @param[in]  wait_time  maximum wait time of the group, unit: tick.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_ERR_TIMEOUT  timeout.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_MultiWaitPresentDone(RGBled_MultiHandle_t multi_handle, TickType_t wait_time);
+
+#endif /* _RGBLED_MULTI_H_ */
@@ -0,0 +1,69 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           rgbled_output.h
+  * @version        1.0
+  * @date           2026-10-19
+  * @brief          RGBled output stage, gamma, brightness and temporal dithering.
+  *                 Plain C without ESP-IDF dependencies.
+  */
+
+#ifndef _RGBLED_OUTPUT_H_
+#define _RGBLED_OUTPUT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RGBLED_OUTPUT_CHANNEL_NUM       3       // GRB888.
+#define RGBLED_OUTPUT_LEVEL_NUM         256
+#define RGBLED_OUTPUT_DITHER_FRAMES     16      // Period of the temporal dithering pattern.
+
+typedef struct{
+    uint16_t lut[RGBLED_OUTPUT_CHANNEL_NUM][RGBLED_OUTPUT_LEVEL_NUM];  // 8.8 fixed point output level.
+    float gamma;
+    uint8_t brightness;
+    uint8_t scale[RGBLED_OUTPUT_CHANNEL_NUM];   // Per channel white balance, GRB order.
+    bool dither;
+    uint8_t frame;                              // Dithering frame counter.
+}RGBled_Output_t;
+
+/**
+  * @brief  Initialize an output stage, gamma 1.0, full brightness, no dithering.
+  * @param[out]  output  output stage.
+  */
+void RGBled_OutputInit(RGBled_Output_t *output);
+
+/**
+  * @brief  Rebuild the LUT from the gamma, brightness and scale fields.
+  * @param[in,out]  output  output stage.
+  * @note  The only floating point math of the stage, called when a setting changes.
+  */
+void RGBled_OutputBuildLut(RGBled_Output_t *output);
+
+/**
+  * @brief  Pass a GRB888 frame through the output stage.
+  * @param[in,out]  output  output stage, the dithering frame counter is advanced.
+  * @param[in]  src  GRB888 frame drawn by the application.
+  * @param[out]  dst  GRB888 frame sent to the LEDs.
+  * @param[in]  led_len  Number of LEDs.
+  * @note  With dithering the fractional part of each level is spread over 
+  *        RGBLED_OUTPUT_DITHER_FRAMES frames, so the frame has to be sent continuously.
+  */
+void RGBled_OutputEncode(RGBled_Output_t *output, const uint8_t *src, uint8_t *dst, uint32_t led_len);
+
+#endif /* _RGBLED_OUTPUT_H_ */
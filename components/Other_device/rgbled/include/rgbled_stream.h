@@ -0,0 +1,90 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           rgbled_stream.h
+  * @version        1.0
+  * @date           2026-10-19
+  * @brief          RGBled UDP pixel stream, DDP packets decoded into the frame buffer.
+  */
+
+#ifndef _RGBLED_STREAM_H_
+#define _RGBLED_STREAM_H_
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "rgbled_driver.h"
+#include "rgbled_ddp.h"
+
+#define RGBLED_STREAM_TASK_STACK_SIZE   (3072)  // Receive task stack size.
+#define RGBLED_STREAM_RECV_TIMEOUT_MS   100     // Receive timeout, bounds the time to stop the task.
+
+typedef struct{
+    uint32_t packets;               // Pixel data packets received.
+    uint32_t frames;                // Frames presented.
+    uint32_t lost_packets;          // Packets missing in the sequence numbers.
+    uint32_t late_packets;          // Duplicate or out of order packets, dropped.
+    uint32_t invalid_packets;       // Not DDP RGB888 pixel data.
+}RGBled_StreamStats_t;
+
+typedef struct{
+    RGBled_handle_t rgb_handle;
+    int sock;
+    uint8_t *packet_buf;            // One UDP packet, RGBLED_DDP_PACKET_MAX bytes.
+    uint8_t last_seq;
+    RGBled_StreamStats_t stats;
+    TaskHandle_t task;
+    volatile bool task_exit;
+}RGBled_Stream_t;
+typedef RGBled_Stream_t *RGBled_StreamHandle_t;
+
+/**
+  * @brief  Start receiving a DDP pixel stream on a UDP port.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  port  UDP port, RGBLED_DDP_PORT is the DDP default.
+  * @param[in]  task_priority  receive task priority.
+  * @retval  
+  *         successful  RGBled stream handle.
+  *         failed      NULL.
+  * @note  The pixel data is written into the back buffer of the strip straight from 
+  *        the packet buffer, a frame is presented on the DDP push flag or when a packet 
+  *        reaches the end of the strip. Nothing is allocated per packet.
+  * @note  The network interface must be up. Use RGBled_StreamDeinit() to release it.
+  */
+RGBled_StreamHandle_t RGBled_StreamInit(RGBled_handle_t rgb_handle, uint16_t port, UBaseType_t task_priority);
+
+/**
+  * @brief  Stop receiving a DDP pixel stream.
+  * @param[in]  stream  RGBled stream handle pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_StreamDeinit(RGBled_StreamHandle_t *stream);
+
+/**
+  * @brief  Get the receive statistics.
+  * @param[in]  stream  RGBled stream handle.
+  * @param[out]  stats  statistics since the stream was started.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_StreamGetStats(RGBled_StreamHandle_t stream, RGBled_StreamStats_t *stats);
+
+#endif /* _RGBLED_STREAM_H_ */
@@ -0,0 +1,93 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           rgbled_ddp.c
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#include "rgbled_ddp.h"
+#include <stddef.h>
+
+/**
+  * @brief  Parse a DDP packet, the data is not copied.
+  * @param[in]  buf  packet received from UDP.
+  * @param[in]  size  packet length.
+  * @param[out]  packet  parsed header and data pointer.
+  * @retval  0: RGB888 pixel data, -1: invalid, not pixel data or another data type.
+  */
+int RGBled_DdpParse(const uint8_t *buf, uint32_t size, RGBled_DdpPacket_t *packet)
+{
+    uint32_t header_len = RGBLED_DDP_HEADER_LEN;
+
+    if (NULL == buf || NULL == packet || size < RGBLED_DDP_HEADER_LEN) {
+        return -1;
+    }
+    packet->flags = buf[0];
+    if (RGBLED_DDP_FLAG_VER1 != (packet->flags & RGBLED_DDP_FLAG_VER_MASK)) {
+        return -1;
+    }
+    // Queries, replies and stored frames are not handled.
+    if (packet->flags & (RGBLED_DDP_FLAG_QUERY | RGBLED_DDP_FLAG_REPLY | RGBLED_DDP_FLAG_STORAGE)) {
+        return -1;
+    }
+    if (packet->flags & RGBLED_DDP_FLAG_TIMECODE) {
+        header_len += RGBLED_DDP_TIMECODE_LEN;
+    }
+    packet->seq = buf[1] & RGBLED_DDP_SEQ_MASK;
+    packet->type = buf[2];
+    packet->id = buf[3];
+    if (packet->id >= RGBLED_DDP_ID_CONTROL) {
+        return -1;
+    }
+    // The data is copied as RGB888, RGBW, HSL, grayscale or other depths would be garbled.
+    if (RGBLED_DDP_TYPE_RGB8 != packet->type) {
+        return -1;
+    }
+    packet->offset = (uint32_t)buf[4] << 24 | (uint32_t)buf[5] << 16 | (uint32_t)buf[6] << 8 | buf[7];
+    packet->len = (uint16_t)(buf[8] << 8 | buf[9]);
+    if (size < header_len || packet->len > size - header_len) {
+        return -1;
+    }
+    packet->data = &buf[header_len];
+    return 0;
+}
+
+/**
+  * @brief  Number of packets lost between two sequence numbers.
+  * @param[in]  last  sequence number of the previous packet.
+  * @param[in]  seq  sequence number of this packet.
+  * @retval  
+  *         0 ~ RGBLED_DDP_SEQ_NUM/2  packets lost.
+  *         -1  duplicate or late packet.
+  * @note  0 is returned when either packet has no sequence number.
+  */
+int RGBled_DdpSeqLost(uint8_t last, uint8_t seq)
+{
+    int lost = 0;
+
+    if (0 == last || 0 == seq) {
+        return 0;
+    }
+    // 1 ~ 15 wraps to 1, a step of more than half the range is taken as going backwards.
+    lost = (seq - last - 1 + RGBLED_DDP_SEQ_NUM) % RGBLED_DDP_SEQ_NUM;
+    if (lost > RGBLED_DDP_SEQ_NUM / 2) {
+        return -1;
+    }
+    return lost;
+}
@@ -22,9 +22,12 @@
   */
 
 #include "rgbled_driver.h"
+#include <string.h>
 #include "driver/gpio.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
 #include "esp_log.h"
 #include "esp_err.h"
 #include "driver/gpio.h"
@@ -40,6 +43,86 @@ const char TAG[] = "rgbled";
 static RGBled_DeviceSeq_t sk6812_device_seq = RGBLED_DEVICE_SK6812_SEQ_CONFIG;
 static RGBled_DeviceSeq_t ws2812_device_seq = RGBLED_DEVICE_WS2812_SEQ_CONFIG;
 
+// Handle of each RMT channel, for the shared TX end callback.
+static RGBled_handle_t rgbled_channel_handle[RMT_CHANNEL_MAX];
+// RMT memory blocks used by the strips, bit n is the block of channel n.
+static uint32_t rgbled_mem_block_used = 0;
+
+// RMT items of the 0 and 1 codes of each device, read by the translators in the RMT ISR.
+static DRAM_ATTR rmt_item32_t rgbled_bit_item[RGBLED_DEVICE_TYPE_MAX][2];
+
+/**
+  * @brief  Expand GRB888 data into RMT items, 8 items per byte.
+  * @param[in]  src  GRB888 data.
+  * @param[out]  dest  RMT items.
+  * @param[in]  src_size  bytes left in src.
+  * @param[in]  wanted_num  number of items wanted.
+  * @param[out]  translated_size  bytes translated.
+  * @param[out]  item_num  items written.
+  * @param[in]  bit  RMT items of the 0 and 1 codes.
+  */
+static inline void IRAM_ATTR rgbled_translate(const void *src, rmt_item32_t *dest, size_t src_size, 
+                                              size_t wanted_num, size_t *translated_size, size_t *item_num, 
+                                              const rmt_item32_t *bit)
+{
+    const uint8_t *psrc = (const uint8_t *)src;
+    const uint32_t bit0 = bit[0].val;
+    const uint32_t bit1 = bit[1].val;
+    size_t size = 0;
+    size_t num = 0;
+
+    while (size < src_size && num + 8 <= wanted_num) {
+        uint8_t bits_to_send = psrc[size];
+        for (uint8_t mask=0x80; mask!=0; mask>>=1) {
+            (dest++)->val = (bits_to_send & mask) ? bit1 : bit0;
+        }
+        num += 8;
+        size++;
+    }
+    *translated_size = size;
+    *item_num = num;
+}
+
+/**
+  * @brief  SK6812 RMT translator, called from the RMT ISR. (See sample_to_rmt_t)
+  */
+static void IRAM_ATTR rgbled_sk6812_translator(const void *src, rmt_item32_t *dest, size_t src_size, 
+                                               size_t wanted_num, size_t *translated_size, size_t *item_num)
+{
+    rgbled_translate(src, dest, src_size, wanted_num, translated_size, item_num, 
+                     rgbled_bit_item[RGBLED_DEVICE_TYPE_SK6812]);
+}
+
+/**
+  * @brief  WS2812 RMT translator, called from the RMT ISR. (See sample_to_rmt_t)
+  */
+static void IRAM_ATTR rgbled_ws2812_translator(const void *src, rmt_item32_t *dest, size_t src_size, 
+                                               size_t wanted_num, size_t *translated_size, size_t *item_num)
+{
+    rgbled_translate(src, dest, src_size, wanted_num, translated_size, item_num, 
+                     rgbled_bit_item[RGBLED_DEVICE_TYPE_WS2812]);
+}
+
+/**
+  * @brief  RMT TX end callback, shared by all RMT channels, called from the RMT ISR.
+  * @param[in]  channel  RMT channel.
+  * @param[in]  arg  not used.
+  */
+static void IRAM_ATTR rgbled_tx_end_callback(rmt_channel_t channel, void *arg)
+{
+    RGBled_handle_t rgb_handle = rgbled_channel_handle[channel];
+    BaseType_t task_woken = pdFALSE;
+
+    if (NULL == rgb_handle) {
+        return;
+    }
+    rgb_handle->tx_end_time = esp_timer_get_time();
+    xSemaphoreGiveFromISR(rgb_handle->tx_done, &task_woken);
+    if (pdTRUE == task_woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
 /**
   * @brief  Initialization RGB LED.
   * @param[in]  device_type  Supported device model. (See RGBled_DeviceType_t)
@@ -50,28 +133,81 @@ static RGBled_DeviceSeq_t ws2812_device_seq = RGBLED_DEVICE_WS2812_SEQ_CONFIG;
   *         successful  RGBled operation handle.
   *         failed      NULL.
   * @note  Use RGBled_Deinit() to release it.
+  * @note  The frame buffers are allocated here, sending a frame does not allocate memory.
+  * @note  The GRB888 data is expanded to RMT items by the RMT translator while it is sent, 
+  *        so the memory cost is 2 * RGBLED_BYTES_PER_LED bytes per LED(front and back buffer).
+  * @note  The RMT TX end callback is registered here, it is shared by all RMT channels.
+  * @note  RGBLED_RMT_MEM_BLOCK_NUM memory blocks are used, see RGBled_InitMemBlock().
   */
 RGBled_handle_t RGBled_Init(RGBled_DeviceType_t device_type, gpio_num_t io_num, 
                             uint32_t led_len, rmt_channel_t rmt_channel)
+{
+    return RGBled_InitMemBlock(device_type, io_num, led_len, rmt_channel, RGBLED_RMT_MEM_BLOCK_NUM);
+}
+
+/**
+  * @brief  Initialization RGB LED with a given number of RMT memory blocks.
+  * @param[in]  device_type  Supported device model. (See RGBled_DeviceType_t)
+  * @param[in]  io_num  IO port used by RGB LED.
+  * @param[in]  led_len  Number of LEDs.
+  * @param[in]  rmt_channel  rmt channel used.
+  * @param[in]  mem_block_num  RMT memory blocks used, 1 ~ RMT_CHANNEL_MAX-rmt_channel.
+  * @retval  
+  *         successful  RGBled operation handle.
+  *         failed      NULL.
+  * @note  A channel using n memory blocks also takes the blocks of the next n-1 channels, 
+  *        Init fails if any of them is used by another strip.
+  * @note  Use RGBled_Deinit() to release it.
+  */
+RGBled_handle_t RGBled_InitMemBlock(RGBled_DeviceType_t device_type, gpio_num_t io_num, 
+                                    uint32_t led_len, rmt_channel_t rmt_channel, 
+                                    uint8_t mem_block_num)
 {
     esp_err_t err = ESP_OK;
+    uint32_t block_mask = 0;
 
     if (device_type < 0 || device_type >= RGBLED_DEVICE_TYPE_MAX) {
         ESP_LOGE(TAG, "%s (%d) device not supported.", __FUNCTION__, __LINE__);
         return NULL;
     }
+    if (0 == led_len) {
+        ESP_LOGE(TAG, "%s (%d) led_len is 0.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+    if (rmt_channel < 0 || rmt_channel >= RMT_CHANNEL_MAX || 
+        0 == mem_block_num || mem_block_num > RMT_CHANNEL_MAX - rmt_channel) {
+        ESP_LOGE(TAG, "%s (%d) rmt channel or mem_block_num out of range.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+    block_mask = ((1UL << mem_block_num) - 1) << rmt_channel;
+    if (rgbled_mem_block_used & block_mask) {
+        ESP_LOGE(TAG, "%s (%d) rmt memory blocks used by another strip.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
 
-    RGBled_handle_t rgb_handle = malloc(sizeof(RGBled_t));
+    RGBled_handle_t rgb_handle = calloc(1, sizeof(RGBled_t));
     if (NULL == rgb_handle) {
         ESP_LOGE(TAG, "%s (%d) driver handle malloc failed.", __FUNCTION__, __LINE__);
         return NULL;
     }
+    rgb_handle->front_buf = calloc(led_len, RGBLED_BYTES_PER_LED);
+    rgb_handle->back_buf = calloc(led_len, RGBLED_BYTES_PER_LED);
+    if (NULL == rgb_handle->front_buf || NULL == rgb_handle->back_buf) {
+        ESP_LOGE(TAG, "%s (%d) frame buffer malloc failed.", __FUNCTION__, __LINE__);
+        goto RGBLED_INIT_FAILED;
+    }
+    // Given while no frame is on the wire.
+    rgb_handle->tx_done = xSemaphoreCreateBinary();
+    if (NULL == rgb_handle->tx_done) {
+        goto RGBLED_INIT_FAILED;
+    }
+    xSemaphoreGive(rgb_handle->tx_done);
 
     rmt_config_t config = {
         .rmt_mode = RMT_MODE_TX,		
         .channel = rmt_channel,	
         .gpio_num = io_num,			
-        .mem_block_num = 3,				
+        .mem_block_num = mem_block_num,				
         .tx_config.loop_en = false,
         .tx_config.carrier_en = false,
         .tx_config.idle_output_en = true,
@@ -81,16 +217,52 @@ RGBled_handle_t RGBled_Init(RGBled_DeviceType_t device_type, gpio_num_t io_num,
     ESP_ERROR_CHECK(rmt_config(&config));
     err = rmt_driver_install(config.channel, 0, 0);
     if (ESP_OK != err) {
-        free(rgb_handle);
-        return NULL;
+        goto RGBLED_INIT_FAILED;
+    }
+
+    // Select different timing Settings depending on the device.
+    RGBled_DeviceSeq_t* rgb_seq;
+    sample_to_rmt_t translator;
+    if (device_type == RGBLED_DEVICE_TYPE_SK6812) {
+        rgb_seq = &sk6812_device_seq;
+        translator = rgbled_sk6812_translator;
+    } else {
+        rgb_seq = &ws2812_device_seq;
+        translator = rgbled_ws2812_translator;
+    }
+    rgbled_bit_item[device_type][0] = (rmt_item32_t){{{rgb_seq->T0H, 1, rgb_seq->T0L, 0}}};
+    rgbled_bit_item[device_type][1] = (rmt_item32_t){{{rgb_seq->T1H, 1, rgb_seq->T1L, 0}}};
+    err = rmt_translator_init(config.channel, translator);
+    if (ESP_OK != err) {
+        rmt_driver_uninstall(config.channel);
+        goto RGBLED_INIT_FAILED;
     }
 
     rgb_handle->device_type = device_type;
     rgb_handle->io_num = io_num;
     rgb_handle->led_len = led_len;
     rgb_handle->rmt_channel = rmt_channel;
+    rgb_handle->mem_block_num = mem_block_num;
+    // 80MHz APB clock divided by RGBLED_RMT_CLK_DIV.
+    rgb_handle->reset_us = (rgb_seq->TRES * RGBLED_RMT_CLK_DIV + 79) / 80;
+    rgb_handle->tx_end_time = esp_timer_get_time();
+    // The LEDs are in an unknown state, the first frame is always sent.
+    rgb_handle->dirty_start = 0;
+    rgb_handle->dirty_end = led_len;
+    rgbled_channel_handle[rmt_channel] = rgb_handle;
+    rgbled_mem_block_used |= block_mask;
+    rmt_register_tx_end_callback(rgbled_tx_end_callback, NULL);
     ESP_LOGI(TAG, "%s (%d) rgbled init ok.", __FUNCTION__, __LINE__);
     return rgb_handle;
+
+RGBLED_INIT_FAILED:
+    if (NULL != rgb_handle->tx_done) {
+        vSemaphoreDelete(rgb_handle->tx_done);
+    }
+    free(rgb_handle->back_buf);
+    free(rgb_handle->front_buf);
+    free(rgb_handle);
+    return NULL;
 }
 
 /**
@@ -106,11 +278,19 @@ esp_err_t RGBled_Deinit(RGBled_handle_t* rgb_handle)
     esp_err_t err = ESP_OK;
     RGBLED_HANDLE_CHECK(*rgb_handle, ESP_FAIL);
 
+    // The frame on the wire still reads the front buffer.
+    RGBled_WaitPresentDone(*rgb_handle, portMAX_DELAY);
     err = rmt_driver_uninstall((*rgb_handle)->rmt_channel);
     if (ESP_OK != err) {
         return ESP_FAIL;
     }
 
+    rgbled_channel_handle[(*rgb_handle)->rmt_channel] = NULL;
+    rgbled_mem_block_used &= ~(((1UL << (*rgb_handle)->mem_block_num) - 1) << (*rgb_handle)->rmt_channel);
+    vSemaphoreDelete((*rgb_handle)->tx_done);
+    free((*rgb_handle)->output);
+    free((*rgb_handle)->back_buf);
+    free((*rgb_handle)->front_buf);
     free(*rgb_handle);
     *rgb_handle = NULL;
     ESP_LOGI(TAG, "%s (%d) rgbled deinit ok.", __FUNCTION__, __LINE__);
@@ -130,57 +310,411 @@ RGBled_Color_t RGBled_GetRgb888(uint8_t red, uint8_t green, uint8_t blue)
 }
 
 /**
-  * @brief  Convert RGB888 to GRB888.
-  * @param[in]  rgb  RGB88 format data.
-  * @retval  GRB888 format data.
+  * @brief  Mark the whole frame as changed.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  */
+static inline void rgbled_mark_all_dirty(RGBled_handle_t rgb_handle)
+{
+    rgb_handle->dirty_start = 0;
+    rgb_handle->dirty_end = rgb_handle->led_len;
+}
+
+/**
+  * @brief  Store one LED color in the back buffer, RGB888 to GRB888.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  index  LED index.
+  * @param[in]  rgb  RGB888 format data.
   * @note   The data format used by SK6812 and WS2812 is GRB 24bit.
   */
-static inline uint32_t rgb_to_grb(RGBled_Color_t rgb)
+static inline void rgbled_set_pixel(RGBled_handle_t rgb_handle, uint32_t index, RGBled_Color_t rgb)
 {
-    uint8_t red = rgb>>16 & 0xFF; 
+    uint8_t *p = &rgb_handle->back_buf[index * RGBLED_BYTES_PER_LED];
     uint8_t green = rgb>>8 & 0xFF;
+    uint8_t red = rgb>>16 & 0xFF;
     uint8_t blue = rgb & 0xFF;
-    return (uint32_t)((green << 16) + (red << 8) + (blue));
+
+    // Only a changed LED makes the frame dirty.
+    if (p[0] == green && p[1] == red && p[2] == blue) {
+        return;
+    }
+    p[0] = green;
+    p[1] = red;
+    p[2] = blue;
+    if (index < rgb_handle->dirty_start) {
+        rgb_handle->dirty_start = index;
+    }
+    if (index >= rgb_handle->dirty_end) {
+        rgb_handle->dirty_end = index + 1;
+    }
 }
 
 /**
-  * @brief  RGBled send color data.
+  * @brief  RGBled Draw one LED into the back buffer.
   * @param[in]  rgb_handle  RGBled operation handle.
-  * @param[in]  led_color  GRB888 format color data.
-  * @retval void 
-  * @note   The data length depends on the led_len.
+  * @param[in]  index  LED index.
+  * @param[in]  color  RGB888 color data.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Use RGBled_Present() to show the back buffer.
   */
-static void RGBled_SendColorData(RGBled_handle_t rgb_handle, int* led_color)
-{   
-    uint32_t item_num = rgb_handle->led_len * RGBLED_BITS_PER_LED_CMD;
+esp_err_t RGBled_SetPixel(RGBled_handle_t rgb_handle, uint32_t index, RGBled_Color_t color)
+{
+    RGBLED_HANDLE_CHECK(rgb_handle, ESP_FAIL);
+    if (index >= rgb_handle->led_len) {
+        return ESP_FAIL;
+    }
 
-    rmt_item32_t* led_data_buffer = malloc(item_num * sizeof(rmt_item32_t)); 
-    if(NULL == led_data_buffer) {
-        return;
+    rgbled_set_pixel(rgb_handle, index, color);
+    return ESP_OK;
+}
+
+/**
+  * @brief  RGBled Draw a run of LEDs in one color into the back buffer.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  start  first LED index.
+  * @param[in]  len  number of LEDs, clipped to the strip.
+  * @param[in]  color  RGB888 color data.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Use RGBled_Present() to show the back buffer.
+  */
+esp_err_t RGBled_FillPixel(RGBled_handle_t rgb_handle, uint32_t start, uint32_t len, RGBled_Color_t color)
+{
+    RGBLED_HANDLE_CHECK(rgb_handle, ESP_FAIL);
+    if (start >= rgb_handle->led_len) {
+        return ESP_FAIL;
     }
 
-    // Select different timing Settings depending on the device.
-    RGBled_DeviceSeq_t* rgb_seq;
-    if (rgb_handle->device_type == RGBLED_DEVICE_TYPE_SK6812) {
-        rgb_seq = &sk6812_device_seq;
+    if (len > rgb_handle->led_len - start) {
+        len = rgb_handle->led_len - start;
+    }
+    for (uint32_t i=start; i<start+len; i++) {
+        rgbled_set_pixel(rgb_handle, i, color);
+    }
+    return ESP_OK;
+}
+
+/**
+  * @brief  RGBled Draw a color array into the back buffer.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  start  first LED index.
+  * @param[in]  color_list  RGB888 color array.
+  * @param[in]  len  number of colors, clipped to the strip.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Use RGBled_Present() to show the back buffer.
+  */
+esp_err_t RGBled_CopyPixel(RGBled_handle_t rgb_handle, uint32_t start, 
+                           const RGBled_Color_t *color_list, uint32_t len)
+{
+    RGBLED_HANDLE_CHECK(rgb_handle, ESP_FAIL);
+    if (NULL == color_list || start >= rgb_handle->led_len) {
+        return ESP_FAIL;
+    }
+
+    if (len > rgb_handle->led_len - start) {
+        len = rgb_handle->led_len - start;
+    }
+    for (uint32_t i=0; i<len; i++) {
+        rgbled_set_pixel(rgb_handle, start+i, color_list[i]);
+    }
+    return ESP_OK;
+}
+
+/**
+  * @brief  RGBled Write a RGB888 byte stream into the back buffer.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  offset  byte offset in the frame, LED index * 3 + color(0:red 1:green 2:blue).
+  * @param[in]  data  RGB888 bytes.
+  * @param[in]  len  number of bytes, clipped to the strip.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The offset does not have to start at a LED, used for network pixel streams.
+  * @note  Use RGBled_Present() to show the back buffer.
+  */
+esp_err_t RGBled_CopyRgbBytes(RGBled_handle_t rgb_handle, uint32_t offset, 
+                              const uint8_t *data, uint32_t len)
+{
+    // Position of red, green and blue in GRB888.
+    static const uint8_t grb_pos[RGBLED_BYTES_PER_LED] = {1, 0, 2};
+    uint32_t size = 0;
+    uint32_t led = 0;
+    uint32_t color = 0;
+    uint32_t first_changed = 0;
+    uint32_t last_changed = 0;
+    bool changed = false;
+
+    RGBLED_HANDLE_CHECK(rgb_handle, ESP_FAIL);
+    size = rgb_handle->led_len * RGBLED_BYTES_PER_LED;
+    if (NULL == data || offset >= size) {
+        return ESP_FAIL;
+    }
+
+    if (len > size - offset) {
+        len = size - offset;
+    }
+    led = offset / RGBLED_BYTES_PER_LED;
+    color = offset % RGBLED_BYTES_PER_LED;
+    for (uint32_t i=0; i<len; i++) {
+        uint8_t *p = &rgb_handle->back_buf[led * RGBLED_BYTES_PER_LED + grb_pos[color]];
+        if (*p != data[i]) {
+            *p = data[i];
+            if (!changed) {
+                first_changed = led;
+                changed = true;
+            }
+            last_changed = led;
+        }
+        if (++color == RGBLED_BYTES_PER_LED) {
+            color = 0;
+            led++;
+        }
+    }
+    if (changed) {
+        if (first_changed < rgb_handle->dirty_start) {
+            rgb_handle->dirty_start = first_changed;
+        }
+        if (last_changed >= rgb_handle->dirty_end) {
+            rgb_handle->dirty_end = last_changed + 1;
+        }
+    }
+    return ESP_OK;
+}
+
+/**
+  * @brief  RGBled Show the back buffer.
+  *         Waits for the previous frame and the device reset time, copies the back buffer 
+  *         through the output stage into the front buffer and starts the transmission 
+  *         without waiting for it.
+  *         The translator expands the GRB888 data into RMT items in the TX threshold ISR.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The back buffer keeps the drawn frame, the next frame can be drawn while 
+  *        this one is on the wire.
+  * @note  Only the LEDs changed since the last frame are copied, a frame without 
+  *        changes is not sent. Use RGBled_Invalidate() to send it anyway.
+  */
+esp_err_t RGBled_Present(RGBled_handle_t rgb_handle)
+{
+    esp_err_t err = ESP_OK;
+    uint32_t start = 0;
+    uint32_t len = 0;
+
+    RGBLED_HANDLE_CHECK(rgb_handle, ESP_FAIL);
+
+    // Dithering changes the output of every frame.
+    if (NULL != rgb_handle->output && rgb_handle->output->dither) {
+        rgbled_mark_all_dirty(rgb_handle);
+    }
+    if (rgb_handle->dirty_start >= rgb_handle->dirty_end) {
+        return ESP_OK;
+    }
+
+    xSemaphoreTake(rgb_handle->tx_done, portMAX_DELAY);
+    // The strip latches the frame after the line has been low for the reset time.
+    while (esp_timer_get_time() - rgb_handle->tx_end_time < rgb_handle->reset_us) {
+        ;
+    }
+
+    // Outside the dirty range the front buffer already holds the output of the last frame.
+    start = rgb_handle->dirty_start * RGBLED_BYTES_PER_LED;
+    len = rgb_handle->dirty_end - rgb_handle->dirty_start;
+    if (NULL != rgb_handle->output) {
+        RGBled_OutputEncode(rgb_handle->output, &rgb_handle->back_buf[start], 
+                            &rgb_handle->front_buf[start], len);
     } else {
-        rgb_seq = &ws2812_device_seq;
+        memcpy(&rgb_handle->front_buf[start], &rgb_handle->back_buf[start], len * RGBLED_BYTES_PER_LED);
+    }
+    // Each LED keeps the first 24 bits and passes the rest on, the LEDs after the 
+    // last changed one receive nothing and keep their color.
+    err = rmt_write_sample(rgb_handle->rmt_channel, rgb_handle->front_buf, 
+                           rgb_handle->dirty_end * RGBLED_BYTES_PER_LED, false);
+    if (ESP_OK != err) {
+        xSemaphoreGive(rgb_handle->tx_done);
+        return ESP_FAIL;
     }
+    rgb_handle->dirty_start = rgb_handle->led_len;
+    rgb_handle->dirty_end = 0;
+    return ESP_OK;
+}
+
+/**
+  * @brief  RGBled Mark the whole frame as changed, the next RGBled_Present() sends it.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  Used when the LEDs lost their state, e.g. after a power cycle of the strip.
+  */
+esp_err_t RGBled_Invalidate(RGBled_handle_t rgb_handle)
+{
+    RGBLED_HANDLE_CHECK(rgb_handle, ESP_FAIL);
+    rgbled_mark_all_dirty(rgb_handle);
+    return ESP_OK;
+}
 
-    rmt_item32_t bit0 = {{{rgb_seq->T0H, 1, rgb_seq->T0L, 0}}};  
-    rmt_item32_t bit1 = {{{rgb_seq->T1H, 1, rgb_seq->T1L, 0}}};
-    for (uint32_t led=0; led<rgb_handle->led_len; led++) {
-        uint32_t bits_to_send = led_color[led];
-        uint32_t mask = 1 << (RGBLED_BITS_PER_LED_CMD - 1);
-        for (uint32_t bit=0; bit<RGBLED_BITS_PER_LED_CMD; bit++) {
-            uint32_t bit_is_set = bits_to_send & mask;
-            led_data_buffer[led*RGBLED_BITS_PER_LED_CMD+bit] = bit_is_set ? bit1 : bit0;
-            mask >>= 1;
+/**
+  * @brief  RGBled Wait for the presented frame to leave the wire.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  wait_time  maximum wait time, unit: tick.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_ERR_TIMEOUT  timeout.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_WaitPresentDone(RGBled_handle_t rgb_handle, TickType_t wait_time)
+{
+    RGBLED_HANDLE_CHECK(rgb_handle, ESP_FAIL);
+
+    if (pdTRUE != xSemaphoreTake(rgb_handle->tx_done, wait_time)) {
+        return ESP_ERR_TIMEOUT;
+    }
+    xSemaphoreGive(rgb_handle->tx_done);
+    return ESP_OK;
+}
+
+/**
+  * @brief  Get the output stage of a handle, allocated on first use.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @retval  output stage, NULL if the allocation failed.
+  */
+static RGBled_Output_t *rgbled_get_output(RGBled_handle_t rgb_handle)
+{
+    if (NULL == rgb_handle->output) {
+        rgb_handle->output = malloc(sizeof(RGBled_Output_t));
+        if (NULL == rgb_handle->output) {
+            ESP_LOGE(TAG, "%s (%d) output stage malloc failed.", __FUNCTION__, __LINE__);
+            return NULL;
         }
+        RGBled_OutputInit(rgb_handle->output);
+    }
+    return rgb_handle->output;
+}
+
+/**
+  * @brief  RGBled Set the gamma of the output stage.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  gamma  output = input ^ gamma, 1.0 is linear, 2.2 ~ 2.8 for common LEDs.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The output stage LUT is allocated on first use, 
+  *        call the output stage functions from the task drawing the frames.
+  */
+esp_err_t RGBled_SetGamma(RGBled_handle_t rgb_handle, float gamma)
+{
+    RGBled_Output_t *output = NULL;
+
+    RGBLED_HANDLE_CHECK(rgb_handle, ESP_FAIL);
+    if (gamma <= 0.0f) {
+        return ESP_FAIL;
+    }
+    output = rgbled_get_output(rgb_handle);
+    if (NULL == output) {
+        return ESP_FAIL;
+    }
+
+    output->gamma = gamma;
+    RGBled_OutputBuildLut(output);
+    rgbled_mark_all_dirty(rgb_handle);
+    return ESP_OK;
+}
+
+/**
+  * @brief  RGBled Set the global brightness of the output stage.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  brightness  0 ~ 255.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_SetBrightness(RGBled_handle_t rgb_handle, uint8_t brightness)
+{
+    RGBled_Output_t *output = NULL;
+
+    RGBLED_HANDLE_CHECK(rgb_handle, ESP_FAIL);
+    output = rgbled_get_output(rgb_handle);
+    if (NULL == output) {
+        return ESP_FAIL;
+    }
+
+    output->brightness = brightness;
+    RGBled_OutputBuildLut(output);
+    rgbled_mark_all_dirty(rgb_handle);
+    return ESP_OK;
+}
+
+/**
+  * @brief  RGBled Set the per channel scale of the output stage, used as white balance.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  red  red scale(0~255).
+  * @param[in]  green  green scale(0~255).
+  * @param[in]  blue  blue scale(0~255).
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_SetColorScale(RGBled_handle_t rgb_handle, uint8_t red, uint8_t green, uint8_t blue)
+{
+    RGBled_Output_t *output = NULL;
+
+    RGBLED_HANDLE_CHECK(rgb_handle, ESP_FAIL);
+    output = rgbled_get_output(rgb_handle);
+    if (NULL == output) {
+        return ESP_FAIL;
     }
-    ESP_ERROR_CHECK(rmt_write_items(rgb_handle->rmt_channel, led_data_buffer, item_num, false));
-    ESP_ERROR_CHECK(rmt_wait_tx_done(rgb_handle->rmt_channel, portMAX_DELAY));
-    free(led_data_buffer);
+
+    // GRB order, the same as the frame buffer.
+    output->scale[0] = green;
+    output->scale[1] = red;
+    output->scale[2] = blue;
+    RGBled_OutputBuildLut(output);
+    rgbled_mark_all_dirty(rgb_handle);
+    return ESP_OK;
+}
+
+/**
+  * @brief  RGBled Enable temporal dithering of the output stage.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  enable  true: dithering on.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The levels between two output steps are reached by alternating them over 
+  *        RGBLED_OUTPUT_DITHER_FRAMES frames, RGBled_Present() has to be called continuously.
+  */
+esp_err_t RGBled_SetDither(RGBled_handle_t rgb_handle, bool enable)
+{
+    RGBled_Output_t *output = NULL;
+
+    RGBLED_HANDLE_CHECK(rgb_handle, ESP_FAIL);
+    output = rgbled_get_output(rgb_handle);
+    if (NULL == output) {
+        return ESP_FAIL;
+    }
+
+    output->dither = enable;
+    rgbled_mark_all_dirty(rgb_handle);
+    return ESP_OK;
+}
+
+/**
+  * @brief  RGBled Show the back buffer and wait for the transmission.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @retval  reference esp_err_t.
+  */
+static esp_err_t RGBled_SendColorData(RGBled_handle_t rgb_handle)
+{   
+    if (ESP_OK != RGBled_Present(rgb_handle)) {
+        return ESP_FAIL;
+    }
+    return RGBled_WaitPresentDone(rgb_handle, portMAX_DELAY);
 }
 
 /**
@@ -199,17 +733,12 @@ esp_err_t RGBled_SetAllColor(RGBled_handle_t rgb_handle, RGBled_Color_t *color_l
         return ESP_FAIL;
     }
 
-    int* pixels = malloc(sizeof(int) * rgb_handle->led_len);
-    if (NULL == pixels) {
-        return ESP_FAIL;
-    }
-        
-    // Convert RGB888 to GRB888.
     for (uint32_t i=0; i<rgb_handle->led_len; i++) {
-        pixels[i] = rgb_to_grb(color_list[i]);
+        rgbled_set_pixel(rgb_handle, i, color_list[i]);
+    }
+    if (ESP_OK != RGBled_SendColorData(rgb_handle)) {
+        return ESP_FAIL;
     }
-    RGBled_SendColorData(rgb_handle, pixels);
-    free(pixels);
     return ESP_OK;
 }
 
@@ -226,22 +755,12 @@ esp_err_t RGBled_SetLenColor(RGBled_handle_t rgb_handle, RGBled_Color_t color, u
 {
     RGBLED_HANDLE_CHECK(rgb_handle, ESP_FAIL);
 
-    RGBled_Color_t color_val = color;
-
-    int* pixels = malloc(sizeof(int) * rgb_handle->led_len);
-    if (NULL == pixels) {
-        return ESP_FAIL;
-    }
-        
-    // Convert RGB888 to GRB888.
     for (uint32_t i=0; i<rgb_handle->led_len; i++) {
-        if(i < led_len)
-            pixels[i] = rgb_to_grb(color_val);
-        else
-            pixels[i] = rgb_to_grb(0x00);
+        rgbled_set_pixel(rgb_handle, i, (i < led_len) ? color : 0x00);
+    }
+    if (ESP_OK != RGBled_SendColorData(rgb_handle)) {
+        return ESP_FAIL;
     }
-    RGBled_SendColorData(rgb_handle, pixels);
-    free(pixels);
     return ESP_OK;
 }
 
@@ -256,27 +775,22 @@ esp_err_t RGBled_SetLenColor(RGBled_handle_t rgb_handle, RGBled_Color_t color, u
   */
 esp_err_t RGBled_SetLenColorMid(RGBled_handle_t rgb_handle, RGBled_Color_t color, uint32_t led_len)
 {
-    RGBled_Color_t color_val = color;
+    RGBLED_HANDLE_CHECK(rgb_handle, ESP_FAIL);
+
     uint32_t mid_num = (rgb_handle->led_len)/2;
     uint32_t led_half = led_len/2;
 
-    int* pixels = malloc(sizeof(int) * rgb_handle->led_len);
-    if (NULL == pixels) {
-        return ESP_FAIL;
-    }
-        
-    // Convert RGB888 to GRB888.
     for (uint32_t i=0; i<mid_num; i++) {
-        if(i < led_half){
-            pixels[mid_num+i] = rgb_to_grb(color_val);
-            pixels[mid_num-i-1] = rgb_to_grb(color_val);
-        }else{
-            pixels[mid_num+i] = rgb_to_grb(0x00);
-            pixels[mid_num-i-1] = rgb_to_grb(0x00);
-        }
+        rgbled_set_pixel(rgb_handle, mid_num+i, (i < led_half) ? color : 0x00);
+        rgbled_set_pixel(rgb_handle, mid_num-i-1, (i < led_half) ? color : 0x00);
+    }
+    // The last LED of an odd length strip is outside both halves.
+    if (rgb_handle->led_len & 0x01) {
+        rgbled_set_pixel(rgb_handle, rgb_handle->led_len-1, 0x00);
+    }
+    if (ESP_OK != RGBled_SendColorData(rgb_handle)) {
+        return ESP_FAIL;
     }
-    RGBled_SendColorData(rgb_handle, pixels);
-    free(pixels);
     return ESP_OK;
 }
 
@@ -292,17 +806,12 @@ esp_err_t RGBled_SetAllOneColor(RGBled_handle_t rgb_handle, RGBled_Color_t color
 {
     RGBLED_HANDLE_CHECK(rgb_handle, ESP_FAIL);
 
-    int* pixels = malloc(sizeof(int) * rgb_handle->led_len);
-    if (NULL == pixels) {
-        return ESP_FAIL;
-    }
-        
-    // Convert RGB888 to GRB888.
     for (uint32_t i=0; i<rgb_handle->led_len; i++) {
-        pixels[i] = rgb_to_grb(color_data);
+        rgbled_set_pixel(rgb_handle, i, color_data);
+    }
+    if (ESP_OK != RGBled_SendColorData(rgb_handle)) {
+        return ESP_FAIL;
     }
-    RGBled_SendColorData(rgb_handle, pixels);
-    free(pixels);
     return ESP_OK;
 }
 
@@ -316,6 +825,5 @@ esp_err_t RGBled_SetAllOneColor(RGBled_handle_t rgb_handle, RGBled_Color_t color
 esp_err_t RGBled_SetAllOff(RGBled_handle_t rgb_handle)
 {
     RGBLED_HANDLE_CHECK(rgb_handle, ESP_FAIL);
-    RGBled_SetAllOneColor(rgb_handle, 0x00);
-    return ESP_OK;
+    return RGBled_SetAllOneColor(rgb_handle, 0x00);
 }
@@ -0,0 +1,515 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           rgbled_effect.c
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#include "rgbled_effect.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define RGBLED_RED(c)       ((c) >> 16 & 0xFF)
+#define RGBLED_GREEN(c)     ((c) >> 8 & 0xFF)
+#define RGBLED_BLUE(c)      ((c) & 0xFF)
+#define RGBLED_RGB(r, g, b) ((uint32_t)(r) << 16 | (uint32_t)(g) << 8 | (uint32_t)(b))
+
+/**
+  * @brief  x / 255 rounded, exact for 0 ~ 65535.
+  */
+static inline uint32_t rgbled_div255(uint32_t x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+/**
+  * @brief  Fixed point HSV to RGB888.
+  * @param[in]  hue  0 ~ RGBLED_HSV_HUE_MAX-1, larger values wrap.
+  * @param[in]  sat  saturation(0~255).
+  * @param[in]  val  value(0~255).
+  * @retval  RGB888 color data.
+  */
+uint32_t RGBled_HsvToRgb(uint16_t hue, uint8_t sat, uint8_t val)
+{
+    hue %= RGBLED_HSV_HUE_MAX;
+    uint8_t sector = hue >> 8;
+    uint8_t frac = hue & 0xFF;
+    uint8_t p = rgbled_div255(val * (255 - sat));
+    uint8_t q = rgbled_div255(val * (255 - rgbled_div255(sat * frac)));
+    uint8_t t = rgbled_div255(val * (255 - rgbled_div255(sat * (255 - frac))));
+
+    switch (sector) {
+    case 0:  return RGBLED_RGB(val, t, p);
+    case 1:  return RGBLED_RGB(q, val, p);
+    case 2:  return RGBLED_RGB(p, val, t);
+    case 3:  return RGBLED_RGB(p, q, val);
+    case 4:  return RGBLED_RGB(t, p, val);
+    default: return RGBLED_RGB(val, p, q);
+    }
+}
+
+/**
+  * @brief  Mix two RGB888 colors.
+  * @param[in]  from  RGB888 color at t = 0.
+  * @param[in]  to  RGB888 color at t = 255.
+  * @param[in]  t  0 ~ 255.
+  * @retval  RGB888 color data.
+  */
+uint32_t RGBled_ColorMix(uint32_t from, uint32_t to, uint8_t t)
+{
+    uint32_t s = 255 - t;
+
+    return RGBLED_RGB(rgbled_div255(RGBLED_RED(from) * s + RGBLED_RED(to) * t), 
+                      rgbled_div255(RGBLED_GREEN(from) * s + RGBLED_GREEN(to) * t), 
+                      rgbled_div255(RGBLED_BLUE(from) * s + RGBLED_BLUE(to) * t));
+}
+
+/**
+  * @brief  Scale a RGB888 color.
+  * @param[in]  color  RGB888 color data.
+  * @param[in]  level  0 ~ 255.
+  * @retval  RGB888 color data.
+  */
+uint32_t RGBled_ColorScale(uint32_t color, uint8_t level)
+{
+    return RGBLED_RGB(rgbled_div255(RGBLED_RED(color) * level), 
+                      rgbled_div255(RGBLED_GREEN(color) * level), 
+                      rgbled_div255(RGBLED_BLUE(color) * level));
+}
+
+/**
+  * @brief  Combine a layer color with the color below it.
+  * @param[in]  dst  RGB888 color below.
+  * @param[in]  src  RGB888 color of the layer.
+  * @param[in]  blend  blend mode.
+  * @param[in]  opacity  opacity of the layer.
+  * @retval  RGB888 color data.
+  */
+static inline uint32_t rgbled_blend(uint32_t dst, uint32_t src, RGBled_BlendMode_t blend, uint8_t opacity)
+{
+    uint32_t r = RGBLED_RED(src), g = RGBLED_GREEN(src), b = RGBLED_BLUE(src);
+
+    switch (blend) {
+    case RGBLED_BLEND_ADD:
+        r += RGBLED_RED(dst);
+        g += RGBLED_GREEN(dst);
+        b += RGBLED_BLUE(dst);
+        src = RGBLED_RGB(r > 255 ? 255 : r, g > 255 ? 255 : g, b > 255 ? 255 : b);
+        break;
+    case RGBLED_BLEND_MULTIPLY:
+        src = RGBLED_RGB(rgbled_div255(r * RGBLED_RED(dst)), rgbled_div255(g * RGBLED_GREEN(dst)), 
+                         rgbled_div255(b * RGBLED_BLUE(dst)));
+        break;
+    case RGBLED_BLEND_LIGHTEN:
+        src = RGBLED_RGB(r > RGBLED_RED(dst) ? r : RGBLED_RED(dst), 
+                         g > RGBLED_GREEN(dst) ? g : RGBLED_GREEN(dst), 
+                         b > RGBLED_BLUE(dst) ? b : RGBLED_BLUE(dst));
+        break;
+    default:
+        break;
+    }
+    if (255 == opacity) {
+        return src;
+    }
+    return RGBled_ColorMix(dst, src, opacity);
+}
+
+/**
+  * @brief  Effect with all fields cleared.
+  */
+static RGBled_Effect_t rgbled_effect_new(RGBled_EffectType_t type, uint16_t step_frames)
+{
+    RGBled_Effect_t effect;
+
+    memset(&effect, 0, sizeof(effect));
+    effect.type = type;
+    effect.step_frames = (0 == step_frames) ? 1 : step_frames;
+    return effect;
+}
+
+/**
+  * @brief  All LEDs in one color.
+  * @param[in]  color  RGB888 color data.
+  */
+RGBled_Effect_t RGBled_EffectSolid(uint32_t color)
+{
+    RGBled_Effect_t effect = rgbled_effect_new(RGBLED_EFFECT_SOLID, 1);
+
+    effect.color = color;
+    return effect;
+}
+
+/**
+  * @brief  All LEDs walk the hue circle.
+  * @param[in]  hue_step  hue change per step, RGBLED_HSV_HUE_MAX is a full circle.
+  * @param[in]  step_frames  frames per step.
+  */
+RGBled_Effect_t RGBled_EffectGradient(uint16_t hue_step, uint16_t step_frames)
+{
+    RGBled_Effect_t effect = rgbled_effect_new(RGBLED_EFFECT_GRADIENT, step_frames);
+
+    effect.hue_step = hue_step;
+    return effect;
+}
+
+/**
+  * @brief  Hue spread over the strip, scrolling one LED per step.
+  * @param[in]  hue_step  hue change per LED.
+  * @param[in]  step_frames  frames per step.
+  */
+RGBled_Effect_t RGBled_EffectRainbow(uint16_t hue_step, uint16_t step_frames)
+{
+    RGBled_Effect_t effect = rgbled_effect_new(RGBLED_EFFECT_RAINBOW, step_frames);
+
+    effect.hue_step = hue_step;
+    return effect;
+}
+
+/**
+  * @brief  A color array scrolling along the strip, one LED per step.
+  * @param[in]  color_list  RGB888 color array, repeated along the strip.
+  * @param[in]  color_num  number of colors.
+  * @param[in]  step_frames  frames per step.
+  * @param[in]  once  stop after one pass, holding step color_num-1, the last frame before it repeats.
+  */
+RGBled_Effect_t RGBled_EffectRoll(const uint32_t *color_list, uint32_t color_num, uint16_t step_frames, bool once)
+{
+    RGBled_Effect_t effect = rgbled_effect_new(RGBLED_EFFECT_ROLL, step_frames);
+
+    effect.color_list = color_list;
+    effect.color_num = color_num;
+    effect.once = once;
+    return effect;
+}
+
+/**
+  * @brief  A color filling the strip, one LED per step.
+  * @param[in]  color  RGB888 color data.
+  * @param[in]  step_frames  frames per step.
+  * @param[in]  once  stop when the strip is full, otherwise start again.
+  */
+RGBled_Effect_t RGBled_EffectFillIn(uint32_t color, uint16_t step_frames, bool once)
+{
+    RGBled_Effect_t effect = rgbled_effect_new(RGBLED_EFFECT_FILL_IN, step_frames);
+
+    effect.color = color;
+    effect.once = once;
+    return effect;
+}
+
+/**
+  * @brief  A color fading in and out.
+  * @param[in]  color  RGB888 color data.
+  * @param[in]  period_frames  frames of one breath.
+  */
+RGBled_Effect_t RGBled_EffectBreath(uint32_t color, uint16_t period_frames)
+{
+    RGBled_Effect_t effect = rgbled_effect_new(RGBLED_EFFECT_BREATH, (period_frames < 2) ? 2 : period_frames);
+
+    effect.color = color;
+    return effect;
+}
+
+/**
+  * @brief  Effect drawn by a callback.
+  * @param[in]  render  render callback.
+  * @param[in]  arg  user argument, effect->arg in the callback.
+  */
+RGBled_Effect_t RGBled_EffectCustom(RGBled_EffectRender_t render, void *arg)
+{
+    RGBled_Effect_t effect = rgbled_effect_new(RGBLED_EFFECT_CUSTOM, 1);
+
+    effect.render = render;
+    effect.arg = arg;
+    return effect;
+}
+
+/**
+  * @brief  Render the next frame of an effect.
+  * @param[in,out]  effect  effect state, advanced by one frame.
+  * @param[out]  pixels  RGB888 frame.
+  * @param[in]  led_len  Number of LEDs.
+  */
+void RGBled_EffectRender(RGBled_Effect_t *effect, uint32_t *pixels, uint32_t led_len)
+{
+    uint32_t step = effect->frame / effect->step_frames;
+    uint32_t color = 0;
+
+    switch (effect->type) {
+    case RGBLED_EFFECT_SOLID:
+        for (uint32_t i=0; i<led_len; i++) {
+            pixels[i] = effect->color;
+        }
+        break;
+    case RGBLED_EFFECT_GRADIENT:
+        color = RGBled_HsvToRgb((effect->hue + step * effect->hue_step) % RGBLED_HSV_HUE_MAX, 255, 255);
+        for (uint32_t i=0; i<led_len; i++) {
+            pixels[i] = color;
+        }
+        break;
+    case RGBLED_EFFECT_RAINBOW:
+        for (uint32_t i=0; i<led_len; i++) {
+            pixels[i] = RGBled_HsvToRgb((effect->hue + (i + step) * effect->hue_step) % RGBLED_HSV_HUE_MAX, 
+                                        255, 255);
+        }
+        break;
+    case RGBLED_EFFECT_ROLL:
+        if (NULL == effect->color_list || 0 == effect->color_num) {
+            break;
+        }
+        if (effect->once && step >= effect->color_num - 1) {
+            step = effect->color_num - 1;
+            effect->done = true;
+        }
+        for (uint32_t i=0; i<led_len; i++) {
+            pixels[i] = effect->color_list[(i + step) % effect->color_num];
+        }
+        break;
+    case RGBLED_EFFECT_FILL_IN:
+        if (0 == led_len) {
+            break;
+        }
+        if (effect->once && step >= led_len - 1) {
+            step = led_len - 1;
+            effect->done = true;
+        }
+        step %= led_len;
+        for (uint32_t i=0; i<led_len; i++) {
+            pixels[i] = (i <= step) ? effect->color : 0;
+        }
+        break;
+    case RGBLED_EFFECT_BREATH: {
+        uint32_t half = effect->step_frames / 2;
+        uint32_t phase = effect->frame % effect->step_frames;
+        uint32_t level = (phase < half) ? (phase * 255 / half) 
+                                        : ((effect->step_frames - phase) * 255 / (effect->step_frames - half));
+        color = RGBled_ColorScale(effect->color, level);
+        for (uint32_t i=0; i<led_len; i++) {
+            pixels[i] = color;
+        }
+        break;
+    }
+    case RGBLED_EFFECT_CUSTOM:
+        if (NULL != effect->render) {
+            effect->render(effect, pixels, led_len);
+        }
+        break;
+    default:
+        break;
+    }
+    effect->frame++;
+}
+
+/**
+  * @brief  Create an effect stack.
+  * @param[in]  led_len  Number of LEDs.
+  * @retval  
+  *         successful  effect stack handle.
+  *         failed      NULL.
+  * @note  Use RGBled_EffectStackDeinit() to release it.
+  */
+RGBled_EffectStackHandle_t RGBled_EffectStackInit(uint32_t led_len)
+{
+    if (0 == led_len) {
+        return NULL;
+    }
+    RGBled_EffectStackHandle_t stack = calloc(1, sizeof(RGBled_EffectStack_t));
+    if (NULL == stack) {
+        return NULL;
+    }
+    stack->layer_buf = calloc(led_len, sizeof(uint32_t));
+    stack->prev_buf = calloc(led_len, sizeof(uint32_t));
+    if (NULL == stack->layer_buf || NULL == stack->prev_buf) {
+        RGBled_EffectStackDeinit(&stack);
+        return NULL;
+    }
+    stack->led_len = led_len;
+    return stack;
+}
+
+/**
+  * @brief  Delete an effect stack.
+  * @param[in]  stack  effect stack handle pointer.
+  */
+void RGBled_EffectStackDeinit(RGBled_EffectStackHandle_t *stack)
+{
+    if (NULL == *stack) {
+        return;
+    }
+    free((*stack)->prev_buf);
+    free((*stack)->layer_buf);
+    free(*stack);
+    *stack = NULL;
+}
+
+/**
+  * @brief  Start an opacity transition of a layer.
+  */
+static void rgbled_layer_fade(RGBled_EffectLayer_t *layer, uint8_t opacity, uint16_t fade_frames)
+{
+    layer->fade_from = layer->opacity;
+    layer->fade_to = opacity;
+    layer->fade_frames = fade_frames;
+    layer->fade_count = 0;
+    if (0 == fade_frames) {
+        layer->opacity = opacity;
+    }
+}
+
+/**
+  * @brief  Start an effect on a layer.
+  * @param[in]  stack  effect stack handle.
+  * @param[in]  index  layer index, 0 ~ RGBLED_EFFECT_LAYER_MAX-1, 0 is the bottom layer.
+  * @param[in]  effect  effect, copied into the layer and started from frame 0.
+  * @param[in]  blend  blend mode of the layer.
+  * @param[in]  fade_frames  transition length, 0 switches at once.
+  * @retval  0: successful, -1: invalid argument.
+  * @note  A running effect on the layer is crossfaded into the new one, 
+  *        an empty layer fades in from transparent.
+  */
+int RGBled_EffectStackSetLayer(RGBled_EffectStackHandle_t stack, uint8_t index, 
+                               const RGBled_Effect_t *effect, RGBled_BlendMode_t blend, 
+                               uint16_t fade_frames)
+{
+    if (NULL == stack || index >= RGBLED_EFFECT_LAYER_MAX || NULL == effect || 
+        effect->type >= RGBLED_EFFECT_TYPE_MAX || blend >= RGBLED_BLEND_MODE_MAX) {
+        return -1;
+    }
+    RGBled_EffectLayer_t *layer = &stack->layer[index];
+
+    if (layer->active && fade_frames > 0) {
+        layer->prev = layer->effect;
+        layer->xfade_frames = fade_frames;
+        layer->xfade_count = 0;
+    } else {
+        layer->xfade_frames = 0;
+        if (!layer->active) {
+            layer->opacity = (0 == fade_frames) ? 255 : 0;
+        }
+    }
+    layer->effect = *effect;
+    layer->effect.frame = 0;
+    layer->effect.done = false;
+    layer->blend = blend;
+    layer->active = true;
+    layer->clear_after_fade = false;
+    rgbled_layer_fade(layer, 255, (layer->opacity == 255) ? 0 : fade_frames);
+    return 0;
+}
+
+/**
+  * @brief  Fade the opacity of a layer.
+  * @param[in]  stack  effect stack handle.
+  * @param[in]  index  layer index.
+  * @param[in]  opacity  target opacity(0~255).
+  * @param[in]  fade_frames  transition length, 0 switches at once.
+  * @retval  0: successful, -1: invalid argument or empty layer.
+  */
+int RGBled_EffectStackFadeLayer(RGBled_EffectStackHandle_t stack, uint8_t index, 
+                                uint8_t opacity, uint16_t fade_frames)
+{
+    if (NULL == stack || index >= RGBLED_EFFECT_LAYER_MAX || !stack->layer[index].active) {
+        return -1;
+    }
+
+    stack->layer[index].clear_after_fade = false;
+    rgbled_layer_fade(&stack->layer[index], opacity, fade_frames);
+    return 0;
+}
+
+/**
+  * @brief  Cancel the effect of a layer.
+  * @param[in]  stack  effect stack handle.
+  * @param[in]  index  layer index.
+  * @param[in]  fade_frames  fade out length, 0 removes the layer at once.
+  * @retval  0: successful, -1: invalid argument.
+  */
+int RGBled_EffectStackClearLayer(RGBled_EffectStackHandle_t stack, uint8_t index, uint16_t fade_frames)
+{
+    if (NULL == stack || index >= RGBLED_EFFECT_LAYER_MAX) {
+        return -1;
+    }
+    RGBled_EffectLayer_t *layer = &stack->layer[index];
+
+    if (0 == fade_frames || !layer->active) {
+        layer->active = false;
+        return 0;
+    }
+    layer->clear_after_fade = true;
+    rgbled_layer_fade(layer, 0, fade_frames);
+    return 0;
+}
+
+/**
+  * @brief  Whether a layer holds an effect, including one that is fading out.
+  * @param[in]  stack  effect stack handle.
+  * @param[in]  index  layer index.
+  * @retval  true: active.
+  */
+bool RGBled_EffectStackIsLayerActive(RGBled_EffectStackHandle_t stack, uint8_t index)
+{
+    if (NULL == stack || index >= RGBLED_EFFECT_LAYER_MAX) {
+        return false;
+    }
+    return stack->layer[index].active;
+}
+
+/**
+  * @brief  Render the next frame of all layers and advance the transitions.
+  * @param[in]  stack  effect stack handle.
+  * @param[out]  pixels  RGB888 frame, led_len LEDs.
+  */
+void RGBled_EffectStackRender(RGBled_EffectStackHandle_t stack, uint32_t *pixels)
+{
+    uint32_t led_len = stack->led_len;
+
+    for (uint32_t i=0; i<led_len; i++) {
+        pixels[i] = 0;
+    }
+    for (uint8_t n=0; n<RGBLED_EFFECT_LAYER_MAX; n++) {
+        RGBled_EffectLayer_t *layer = &stack->layer[n];
+        if (!layer->active) {
+            continue;
+        }
+
+        RGBled_EffectRender(&layer->effect, stack->layer_buf, led_len);
+        if (layer->xfade_count < layer->xfade_frames) {
+            uint8_t t = (layer->xfade_count + 1) * 255 / layer->xfade_frames;
+            RGBled_EffectRender(&layer->prev, stack->prev_buf, led_len);
+            for (uint32_t i=0; i<led_len; i++) {
+                stack->layer_buf[i] = RGBled_ColorMix(stack->prev_buf[i], stack->layer_buf[i], t);
+            }
+            layer->xfade_count++;
+        }
+        if (layer->fade_count < layer->fade_frames) {
+            layer->fade_count++;
+            layer->opacity = layer->fade_from + 
+                             ((int32_t)layer->fade_to - layer->fade_from) * layer->fade_count / layer->fade_frames;
+        }
+        if (0 != layer->opacity) {
+            for (uint32_t i=0; i<led_len; i++) {
+                pixels[i] = rgbled_blend(pixels[i], stack->layer_buf[i], layer->blend, layer->opacity);
+            }
+        }
+        if (layer->clear_after_fade && layer->fade_count >= layer->fade_frames) {
+            layer->active = false;
+        }
+    }
+}
@@ -0,0 +1,244 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           rgbled_engine.c
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#include "rgbled_engine.h"
+#include "esp_log.h"
+
+static const char *TAG = "rgbled_engine";
+
+#define RGBLED_ENGINE_HANDLE_CHECK(a, ret)  if (NULL == a) {                     \
+        ESP_LOGE(TAG, "%s (%d) driver handle is NULL.", __FUNCTION__, __LINE__); \
+        return (ret);                                                            \
+        }
+
+/**
+  * @brief  Frame clock, runs in the esp_timer task.
+  * @param[in]  arg  RGBled engine handle.
+  */
+static void rgbled_engine_timer_callback(void *arg)
+{
+    RGBled_EngineHandle_t engine = (RGBled_EngineHandle_t)arg;
+
+    xTaskNotifyGive(engine->task);
+}
+
+/**
+  * @brief  Render task, one frame per frame clock tick.
+  * @param[in]  arg  RGBled engine handle.
+  * @note  Ticks received while a frame is rendered are merged, the frame is dropped.
+  */
+static void rgbled_engine_task(void *arg)
+{
+    RGBled_EngineHandle_t engine = (RGBled_EngineHandle_t)arg;
+
+    while (false == engine->task_exit) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (true == engine->task_exit) {
+            break;
+        }
+
+        xSemaphoreTake(engine->lock, portMAX_DELAY);
+        RGBled_EffectStackRender(engine->stack, engine->pixels);
+        xSemaphoreGive(engine->lock);
+        RGBled_CopyPixel(engine->rgb_handle, 0, engine->pixels, engine->rgb_handle->led_len);
+        RGBled_Present(engine->rgb_handle);
+    }
+    engine->task = NULL;
+    vTaskDelete(NULL);
+}
+
+/**
+  * @brief  Start an effects engine on a strip.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  fps  frame rate, 1 ~ RGBLED_ENGINE_FPS_MAX.
+  * @param[in]  task_priority  render task priority.
+  * @retval  
+  *         successful  RGBled engine handle.
+  *         failed      NULL.
+  * @note  The engine owns the back buffer of the strip until RGBled_EngineDeinit().
+  * @note  A frame that is not rendered in time is dropped, 
+  *        the frame rate is also bounded by the frame time of the strip.
+  */
+RGBled_EngineHandle_t RGBled_EngineInit(RGBled_handle_t rgb_handle, uint32_t fps, UBaseType_t task_priority)
+{
+    RGBLED_ENGINE_HANDLE_CHECK(rgb_handle, NULL);
+    if (0 == fps || fps > RGBLED_ENGINE_FPS_MAX) {
+        ESP_LOGE(TAG, "%s (%d) fps out of range.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+
+    RGBled_EngineHandle_t engine = calloc(1, sizeof(RGBled_Engine_t));
+    if (NULL == engine) {
+        ESP_LOGE(TAG, "%s (%d) driver handle malloc failed.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+    engine->rgb_handle = rgb_handle;
+    engine->stack = RGBled_EffectStackInit(rgb_handle->led_len);
+    engine->pixels = calloc(rgb_handle->led_len, sizeof(RGBled_Color_t));
+    engine->lock = xSemaphoreCreateMutex();
+    if (NULL == engine->stack || NULL == engine->pixels || NULL == engine->lock) {
+        ESP_LOGE(TAG, "%s (%d) engine malloc failed.", __FUNCTION__, __LINE__);
+        goto RGBLED_ENGINE_INIT_FAILED;
+    }
+
+    engine->task_exit = false;
+    if (pdPASS != xTaskCreate(rgbled_engine_task, "rgbled_engine", RGBLED_ENGINE_TASK_STACK_SIZE, 
+                              engine, task_priority, &engine->task)) {
+        ESP_LOGE(TAG, "%s (%d) render task create failed.", __FUNCTION__, __LINE__);
+        engine->task = NULL;
+        goto RGBLED_ENGINE_INIT_FAILED;
+    }
+    esp_timer_create_args_t timer_args = {
+        .callback = rgbled_engine_timer_callback,
+        .arg = engine,
+        .name = "rgbled_engine",
+    };
+    if (ESP_OK != esp_timer_create(&timer_args, &engine->timer)) {
+        engine->timer = NULL;
+        goto RGBLED_ENGINE_INIT_FAILED;
+    }
+    if (ESP_OK != esp_timer_start_periodic(engine->timer, 1000000 / fps)) {
+        goto RGBLED_ENGINE_INIT_FAILED;
+    }
+    ESP_LOGI(TAG, "%s (%d) rgbled engine init ok.", __FUNCTION__, __LINE__);
+    return engine;
+
+RGBLED_ENGINE_INIT_FAILED:
+    RGBled_EngineDeinit(&engine);
+    return NULL;
+}
+
+/**
+  * @brief  Stop an effects engine.
+  * @param[in]  engine  RGBled engine handle pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_EngineDeinit(RGBled_EngineHandle_t *engine)
+{
+    RGBLED_ENGINE_HANDLE_CHECK(*engine, ESP_FAIL);
+
+    if (NULL != (*engine)->timer) {
+        esp_timer_stop((*engine)->timer);
+        esp_timer_delete((*engine)->timer);
+    }
+    // Let the task finish the current frame and delete itself.
+    if (NULL != (*engine)->task) {
+        (*engine)->task_exit = true;
+        xTaskNotifyGive((*engine)->task);
+        while (NULL != (*engine)->task) {
+            vTaskDelay(1);
+        }
+    }
+    if (NULL != (*engine)->lock) {
+        vSemaphoreDelete((*engine)->lock);
+    }
+    free((*engine)->pixels);
+    RGBled_EffectStackDeinit(&(*engine)->stack);
+    free(*engine);
+    *engine = NULL;
+    return ESP_OK;
+}
+
+/**
+  * @brief  Start an effect on a layer, see RGBled_EffectStackSetLayer().
+  * @param[in]  engine  RGBled engine handle.
+  * @param[in]  index  layer index, 0 ~ RGBLED_EFFECT_LAYER_MAX-1, 0 is the bottom layer.
+  * @param[in]  effect  effect, copied into the layer.
+  * @param[in]  blend  blend mode of the layer.
+  * @param[in]  fade_frames  transition length, 0 switches at once.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_EngineSetLayer(RGBled_EngineHandle_t engine, uint8_t index, const RGBled_Effect_t *effect, 
+                                RGBled_BlendMode_t blend, uint16_t fade_frames)
+{
+    int ret = 0;
+    RGBLED_ENGINE_HANDLE_CHECK(engine, ESP_FAIL);
+
+    xSemaphoreTake(engine->lock, portMAX_DELAY);
+    ret = RGBled_EffectStackSetLayer(engine->stack, index, effect, blend, fade_frames);
+    xSemaphoreGive(engine->lock);
+    return (0 == ret) ? ESP_OK : ESP_FAIL;
+}
+
+/**
+  * @brief  Fade the opacity of a layer, see RGBled_EffectStackFadeLayer().
+  * @param[in]  engine  RGBled engine handle.
+  * @param[in]  index  layer index.
+  * @param[in]  opacity  target opacity(0~255).
+  * @param[in]  fade_frames  transition length, 0 switches at once.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_EngineFadeLayer(RGBled_EngineHandle_t engine, uint8_t index, 
+                                 uint8_t opacity, uint16_t fade_frames)
+{
+    int ret = 0;
+    RGBLED_ENGINE_HANDLE_CHECK(engine, ESP_FAIL);
+
+    xSemaphoreTake(engine->lock, portMAX_DELAY);
+    ret = RGBled_EffectStackFadeLayer(engine->stack, index, opacity, fade_frames);
+    xSemaphoreGive(engine->lock);
+    return (0 == ret) ? ESP_OK : ESP_FAIL;
+}
+
+/**
+  * @brief  Cancel the effect of a layer, see RGBled_EffectStackClearLayer().
+  * @param[in]  engine  RGBled engine handle.
+  * @param[in]  index  layer index.
+  * @param[in]  fade_frames  fade out length, 0 removes the layer at once.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_EngineClearLayer(RGBled_EngineHandle_t engine, uint8_t index, uint16_t fade_frames)
+{
+    int ret = 0;
+    RGBLED_ENGINE_HANDLE_CHECK(engine, ESP_FAIL);
+
+    xSemaphoreTake(engine->lock, portMAX_DELAY);
+    ret = RGBled_EffectStackClearLayer(engine->stack, index, fade_frames);
+    xSemaphoreGive(engine->lock);
+    return (0 == ret) ? ESP_OK : ESP_FAIL;
+}
+
+/**
+  * @brief  Whether a layer holds an effect, including one that is fading out.
+  * @param[in]  engine  RGBled engine handle.
+  * @param[in]  index  layer index.
+  * @retval  true: active.
+  */
+bool RGBled_EngineIsLayerActive(RGBled_EngineHandle_t engine, uint8_t index)
+{
+    bool active = false;
+    RGBLED_ENGINE_HANDLE_CHECK(engine, false);
+
+    xSemaphoreTake(engine->lock, portMAX_DELAY);
+    active = RGBled_EffectStackIsLayerActive(engine->stack, index);
+    xSemaphoreGive(engine->lock);
+    return active;
+}
@@ -0,0 +1,203 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           rgbled_multi.c
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#include "rgbled_multi.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_err.h"
+
+static const char *TAG = "rgbled_multi";
+
+#define RGBLED_MULTI_HANDLE_CHECK(a, ret)  if (NULL == a) {                      \
+        ESP_LOGE(TAG, "%s (%d) driver handle is NULL.", __FUNCTION__, __LINE__); \
+        return (ret);                                                            \
+        }
+
+/**
+  * @brief  Check the RMT channels and memory blocks of a strip configuration.
+  * @param[in]  config  strip configuration array.
+  * @param[in]  strip_num  number of strips.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_ERR_INVALID_ARG  out of range or overlapping.
+  */
+static esp_err_t rgbled_multi_check_config(const RGBled_StripConfig_t *config, uint8_t strip_num)
+{
+    uint32_t used_mask = 0;
+    uint32_t block_mask = 0;
+
+    for (uint8_t i=0; i<strip_num; i++) {
+        if (config[i].rmt_channel < 0 || config[i].rmt_channel >= RMT_CHANNEL_MAX || 
+            0 == config[i].mem_block_num || 
+            config[i].mem_block_num > RMT_CHANNEL_MAX - config[i].rmt_channel) {
+            ESP_LOGE(TAG, "%s (%d) strip %d rmt channel or mem_block_num out of range.", 
+                     __FUNCTION__, __LINE__, i);
+            return ESP_ERR_INVALID_ARG;
+        }
+        // A channel using n blocks also takes the blocks of the next n-1 channels.
+        block_mask = ((1UL << config[i].mem_block_num) - 1) << config[i].rmt_channel;
+        if (used_mask & block_mask) {
+            ESP_LOGE(TAG, "%s (%d) strip %d rmt memory blocks overlap.", __FUNCTION__, __LINE__, i);
+            return ESP_ERR_INVALID_ARG;
+        }
+        used_mask |= block_mask;
+    }
+    return ESP_OK;
+}
+
+/**
+  * @brief  Initialization of a group of strips, each on its own RMT channel.
+  * @param[in]  config  strip configuration array.
+  * @param[in]  strip_num  number of strips, 1 ~ RGBLED_MULTI_STRIP_MAX.
+  * @retval  
+  *         successful  RGBled multi strip operation handle.
+  *         failed      NULL.
+  * @note  The RMT channels and memory blocks of the strips must not overlap, 
+  *        the whole configuration is checked before any strip is initialized.
+  * @note  Use RGBled_MultiDeinit() to release it.
+  */
+RGBled_MultiHandle_t RGBled_MultiInit(const RGBled_StripConfig_t *config, uint8_t strip_num)
+{
+    if (NULL == config || 0 == strip_num || strip_num > RGBLED_MULTI_STRIP_MAX) {
+        ESP_LOGE(TAG, "%s (%d) invalid strip configuration.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+    if (ESP_OK != rgbled_multi_check_config(config, strip_num)) {
+        return NULL;
+    }
+
+    RGBled_MultiHandle_t multi_handle = calloc(1, sizeof(RGBled_Multi_t));
+    if (NULL == multi_handle) {
+        ESP_LOGE(TAG, "%s (%d) driver handle malloc failed.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+    for (uint8_t i=0; i<strip_num; i++) {
+        multi_handle->strip[i] = RGBled_InitMemBlock(config[i].device_type, config[i].io_num, 
+                                                     config[i].led_len, config[i].rmt_channel, 
+                                                     config[i].mem_block_num);
+        if (NULL == multi_handle->strip[i]) {
+            ESP_LOGE(TAG, "%s (%d) strip %d init failed.", __FUNCTION__, __LINE__, i);
+            goto RGBLED_MULTI_INIT_FAILED;
+        }
+        multi_handle->strip_num++;
+    }
+    ESP_LOGI(TAG, "%s (%d) rgbled multi init ok, %d strips.", __FUNCTION__, __LINE__, strip_num);
+    return multi_handle;
+
+RGBLED_MULTI_INIT_FAILED:
+    RGBled_MultiDeinit(&multi_handle);
+    return NULL;
+}
+
+/**
+  * @brief  RGBled multi strip deinitialization.
+  * @param[in]  multi_handle  RGBled multi strip operation handle pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_MultiDeinit(RGBled_MultiHandle_t *multi_handle)
+{
+    esp_err_t err = ESP_OK;
+    RGBLED_MULTI_HANDLE_CHECK(*multi_handle, ESP_FAIL);
+
+    for (uint8_t i=0; i<(*multi_handle)->strip_num; i++) {
+        if (ESP_OK != RGBled_Deinit(&(*multi_handle)->strip[i])) {
+            err = ESP_FAIL;
+        }
+    }
+    free(*multi_handle);
+    *multi_handle = NULL;
+    return err;
+}
+
+/**
+  * @brief  Get the handle of one strip, used to draw into its back buffer.
+  * @param[in]  multi_handle  RGBled multi strip operation handle.
+  * @param[in]  index  strip index, the order of the configuration array.
+  * @retval  RGBled operation handle, NULL if the index is out of range.
+  */
+RGBled_handle_t RGBled_MultiGetStrip(RGBled_MultiHandle_t multi_handle, uint8_t index)
+{
+    RGBLED_MULTI_HANDLE_CHECK(multi_handle, NULL);
+    if (index >= multi_handle->strip_num) {
+        return NULL;
+    }
+    return multi_handle->strip[index];
+}
+
+/**
+  * @brief  Show the back buffers of all strips.
+  *         All transmissions are started together, the function does not wait for them.
+  * @param[in]  multi_handle  RGBled multi strip operation handle.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note  The frame time is the one of the longest strip, not the sum of all strips.
+  */
+esp_err_t RGBled_MultiPresent(RGBled_MultiHandle_t multi_handle)
+{
+    esp_err_t err = ESP_OK;
+    RGBLED_MULTI_HANDLE_CHECK(multi_handle, ESP_FAIL);
+
+    // The previous frames were started together, waiting for the first strip 
+    // covers most of the others, each Present then starts without delay.
+    for (uint8_t i=0; i<multi_handle->strip_num; i++) {
+        if (ESP_OK != RGBled_Present(multi_handle->strip[i])) {
+            err = ESP_FAIL;
+        }
+    }
+    return err;
+}
+
+/**
+  * @brief  Wait for the frames of all strips to leave the wire.
+  * @param[in]  multi_handle  RGBled multi strip operation handle.
+  * @param[in]  wait_time  maximum wait time of the group, unit: tick.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_ERR_TIMEOUT  timeout.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_MultiWaitPresentDone(RGBled_MultiHandle_t multi_handle, TickType_t wait_time)
+{
+    esp_err_t err = ESP_OK;
+    TickType_t start_tick = xTaskGetTickCount();
+    TickType_t elapsed = 0;
+
+    RGBLED_MULTI_HANDLE_CHECK(multi_handle, ESP_FAIL);
+
+    for (uint8_t i=0; i<multi_handle->strip_num; i++) {
+        if (portMAX_DELAY != wait_time) {
+            elapsed = xTaskGetTickCount() - start_tick;
+            wait_time = (elapsed < wait_time) ? (wait_time - elapsed) : 0;
+            start_tick += elapsed;
+        }
+        err = RGBled_WaitPresentDone(multi_handle->strip[i], wait_time);
+        if (ESP_OK != err) {
+            return err;
+        }
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,99 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           rgbled_output.c
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#include "rgbled_output.h"
+#include <math.h>
+
+// Bit reversed thresholds, neighbouring LEDs are offset by one frame so a fade does not flicker in step.
+static const uint8_t rgbled_dither_threshold[RGBLED_OUTPUT_DITHER_FRAMES] = {
+    8, 136, 72, 200, 40, 168, 104, 232, 24, 152, 88, 216, 56, 184, 120, 248
+};
+
+/**
+  * @brief  Initialize an output stage, gamma 1.0, full brightness, no dithering.
+  * @param[out]  output  output stage.
+  */
+void RGBled_OutputInit(RGBled_Output_t *output)
+{
+    output->gamma = 1.0f;
+    output->brightness = 255;
+    for (uint8_t c=0; c<RGBLED_OUTPUT_CHANNEL_NUM; c++) {
+        output->scale[c] = 255;
+    }
+    output->dither = false;
+    output->frame = 0;
+    RGBled_OutputBuildLut(output);
+}
+
+/**
+  * @brief  Rebuild the LUT from the gamma, brightness and scale fields.
+  * @param[in,out]  output  output stage.
+  * @note  The only floating point math of the stage, called when a setting changes.
+  */
+void RGBled_OutputBuildLut(RGBled_Output_t *output)
+{
+    for (uint8_t c=0; c<RGBLED_OUTPUT_CHANNEL_NUM; c++) {
+        // 255 * 256 is the largest 8.8 level, adding a threshold below 256 never exceeds 255.
+        float gain = 255.0f * 256.0f * output->brightness * output->scale[c] / (255.0f * 255.0f);
+        for (uint32_t v=0; v<RGBLED_OUTPUT_LEVEL_NUM; v++) {
+            output->lut[c][v] = (uint16_t)(powf(v / 255.0f, output->gamma) * gain + 0.5f);
+        }
+    }
+}
+
+/**
+  * @brief  Pass a GRB888 frame through the output stage.
+  * @param[in,out]  output  output stage, the dithering frame counter is advanced.
+  * @param[in]  src  GRB888 frame drawn by the application.
+  * @param[out]  dst  GRB888 frame sent to the LEDs.
+  * @param[in]  led_len  Number of LEDs.
+  * @note  With dithering the fractional part of each level is spread over 
+  *        RGBLED_OUTPUT_DITHER_FRAMES frames, so the frame has to be sent continuously.
+  */
+void RGBled_OutputEncode(RGBled_Output_t *output, const uint8_t *src, uint8_t *dst, uint32_t led_len)
+{
+    const uint16_t *lut_g = output->lut[0];
+    const uint16_t *lut_r = output->lut[1];
+    const uint16_t *lut_b = output->lut[2];
+
+    if (!output->dither) {
+        for (uint32_t i=0; i<led_len; i++) {
+            dst[0] = (lut_g[src[0]] + 128) >> 8;
+            dst[1] = (lut_r[src[1]] + 128) >> 8;
+            dst[2] = (lut_b[src[2]] + 128) >> 8;
+            src += RGBLED_OUTPUT_CHANNEL_NUM;
+            dst += RGBLED_OUTPUT_CHANNEL_NUM;
+        }
+        return;
+    }
+
+    uint8_t frame = output->frame++;
+    for (uint32_t i=0; i<led_len; i++) {
+        uint16_t t = rgbled_dither_threshold[(frame + i) & (RGBLED_OUTPUT_DITHER_FRAMES - 1)];
+        dst[0] = (lut_g[src[0]] + t) >> 8;
+        dst[1] = (lut_r[src[1]] + t) >> 8;
+        dst[2] = (lut_b[src[2]] + t) >> 8;
+        src += RGBLED_OUTPUT_CHANNEL_NUM;
+        dst += RGBLED_OUTPUT_CHANNEL_NUM;
+    }
+}
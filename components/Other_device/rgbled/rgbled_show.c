@@ -37,26 +37,31 @@
   *         In order to be compatible with task scheduling, it is not recommended 
   *         to set a too low gradient time, which may affect the operation of 
   *         other tasks.
+  * @note   The next frame is drawn while the current one is on the wire.
   */
 void RGBled_ShowGradient(RGBled_handle_t rgb_handle, uint32_t time)
 {
     uint8_t i=0;
     uint8_t j=0;
     uint8_t k=255;
+    uint32_t led_len = rgb_handle->led_len;
 
     for (i=0; i<255; i++) {
         k--;
-        RGBled_SetAllOneColor(rgb_handle, RGBled_GetRgb888(i, j, k));
+        RGBled_FillPixel(rgb_handle, 0, led_len, RGBled_GetRgb888(i, j, k));
+        RGBled_Present(rgb_handle);
         vTaskDelay(time / portTICK_PERIOD_MS);
     }
     for (j=0; j<255; j++) {
         i--;
-        RGBled_SetAllOneColor(rgb_handle, RGBled_GetRgb888(i, j, k));
+        RGBled_FillPixel(rgb_handle, 0, led_len, RGBled_GetRgb888(i, j, k));
+        RGBled_Present(rgb_handle);
         vTaskDelay(time / portTICK_PERIOD_MS);
     }
     for (k=0; k<255; k++) {
         j--;
-        RGBled_SetAllOneColor(rgb_handle, RGBled_GetRgb888(i, j, k));
+        RGBled_FillPixel(rgb_handle, 0, led_len, RGBled_GetRgb888(i, j, k));
+        RGBled_Present(rgb_handle);
         vTaskDelay(time / portTICK_PERIOD_MS);
     }
 }
@@ -71,22 +76,14 @@ void RGBled_ShowGradient(RGBled_handle_t rgb_handle, uint32_t time)
 void RGBled_ShowColorRoll(RGBled_handle_t rgb_handle, RGBled_Color_t* color_list, uint32_t delay_time)
 {
     uint32_t led_len = rgb_handle->led_len;
-    uint32_t color_num = 0;
 
-    RGBled_Color_t* color_buf = malloc(sizeof(RGBled_Color_t) * rgb_handle->led_len);
-    if (NULL == color_buf) {
-        return;
-    }
-        
     for (uint32_t i=0; i<led_len; i++) {
         for (uint32_t j=0; j<led_len; j++) {
-            color_buf[j] = color_list[(j+color_num) % led_len];
+            RGBled_SetPixel(rgb_handle, j, color_list[(j+i) % led_len]);
         }
-        RGBled_SetAllColor(rgb_handle, color_buf);
-        color_num++;
+        RGBled_Present(rgb_handle);
         vTaskDelay(delay_time / portTICK_PERIOD_MS);
     }
-    free(color_buf);
 }
 
 /**
@@ -100,17 +97,11 @@ void RGBled_ShowFillIn(RGBled_handle_t rgb_handle, RGBled_Color_t color, uint32_
 {
     uint32_t led_len = rgb_handle->led_len;
 
-    RGBled_Color_t* color_buf = malloc(sizeof(RGBled_Color_t) * rgb_handle->led_len);
-    if (NULL == color_buf) {
-        return;
-    }
-    
+    // The back buffer holds the last presented frame, only the new LED is drawn each step.
+    RGBled_FillPixel(rgb_handle, 0, led_len, 0x00);
     for (uint32_t i=0; i<led_len; i++) {
-        for (uint32_t j=0; j<(i+1); j++) {
-            color_buf[j] = color;
-        }
-        RGBled_SetAllColor(rgb_handle, color_buf);
+        RGBled_SetPixel(rgb_handle, i, color);
+        RGBled_Present(rgb_handle);
         vTaskDelay(delay_time / portTICK_PERIOD_MS);
     }
-    free(color_buf);
-}
\ No newline at end of file
+}
@@ -0,0 +1,206 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           rgbled_stream.c
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#include "rgbled_stream.h"
+#include <string.h>
+#include "lwip/sockets.h"
+#include "esp_log.h"
+
+static const char *TAG = "rgbled_stream";
+
+#define RGBLED_STREAM_HANDLE_CHECK(a, ret)  if (NULL == a) {                     \
+        ESP_LOGE(TAG, "%s (%d) driver handle is NULL.", __FUNCTION__, __LINE__); \
+        return (ret);                                                            \
+        }
+
+/**
+  * @brief  Handle one received packet.
+  * @param[in]  stream  RGBled stream handle.
+  * @param[in]  size  packet length.
+  */
+static void rgbled_stream_packet(RGBled_StreamHandle_t stream, uint32_t size)
+{
+    RGBled_DdpPacket_t packet;
+    int lost = 0;
+    uint32_t frame_size = stream->rgb_handle->led_len * RGBLED_BYTES_PER_LED;
+
+    if (0 != RGBled_DdpParse(stream->packet_buf, size, &packet)) {
+        stream->stats.invalid_packets++;
+        return;
+    }
+    lost = RGBled_DdpSeqLost(stream->last_seq, packet.seq);
+    if (lost < 0) {
+        stream->stats.late_packets++;
+        return;
+    }
+    stream->stats.lost_packets += lost;
+    stream->stats.packets++;
+    if (0 != packet.seq) {
+        stream->last_seq = packet.seq;
+    }
+
+    if (packet.len > 0 && packet.offset < frame_size) {
+        RGBled_CopyRgbBytes(stream->rgb_handle, packet.offset, packet.data, packet.len);
+    }
+    // Senders without the push flag end a frame at the end of the strip.
+    if ((packet.flags & RGBLED_DDP_FLAG_PUSH) || packet.offset + packet.len >= frame_size) {
+        RGBled_Present(stream->rgb_handle);
+        stream->stats.frames++;
+    }
+}
+
+/**
+  * @brief  Receive task.
+  * @param[in]  arg  RGBled stream handle.
+  */
+static void rgbled_stream_task(void *arg)
+{
+    RGBled_StreamHandle_t stream = (RGBled_StreamHandle_t)arg;
+    int len = 0;
+
+    while (false == stream->task_exit) {
+        len = recv(stream->sock, stream->packet_buf, RGBLED_DDP_PACKET_MAX, 0);
+        if (len < 0) {
+            // Timeout, check the exit flag.
+            if (EAGAIN != errno && EWOULDBLOCK != errno) {
+                ESP_LOGE(TAG, "%s (%d) socket recv errno %d.", __FUNCTION__, __LINE__, errno);
+                vTaskDelay(RGBLED_STREAM_RECV_TIMEOUT_MS / portTICK_PERIOD_MS);
+            }
+            continue;
+        }
+        rgbled_stream_packet(stream, len);
+    }
+    stream->task = NULL;
+    vTaskDelete(NULL);
+}
+
+/**
+  * @brief  Start receiving a DDP pixel stream on a UDP port.
+  * @param[in]  rgb_handle  RGBled operation handle.
+  * @param[in]  port  UDP port, RGBLED_DDP_PORT is the DDP default.
+  * @param[in]  task_priority  receive task priority.
+  * @retval  
+  *         successful  RGBled stream handle.
+  *         failed      NULL.
+  * @note  The pixel data is written into the back buffer of the strip straight from 
+  *        the packet buffer, a frame is presented on the DDP push flag or when a packet 
+  *        reaches the end of the strip. Nothing is allocated per packet.
+  * @note  The network interface must be up. Use RGBled_StreamDeinit() to release it.
+  */
+RGBled_StreamHandle_t RGBled_StreamInit(RGBled_handle_t rgb_handle, uint16_t port, UBaseType_t task_priority)
+{
+    RGBLED_STREAM_HANDLE_CHECK(rgb_handle, NULL);
+
+    RGBled_StreamHandle_t stream = calloc(1, sizeof(RGBled_Stream_t));
+    if (NULL == stream) {
+        ESP_LOGE(TAG, "%s (%d) driver handle malloc failed.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+    stream->rgb_handle = rgb_handle;
+    stream->sock = -1;
+    stream->packet_buf = malloc(RGBLED_DDP_PACKET_MAX);
+    if (NULL == stream->packet_buf) {
+        ESP_LOGE(TAG, "%s (%d) packet buffer malloc failed.", __FUNCTION__, __LINE__);
+        goto RGBLED_STREAM_INIT_FAILED;
+    }
+
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    stream->sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (stream->sock < 0) {
+        ESP_LOGE(TAG, "%s (%d) unable to create socket: errno %d.", __FUNCTION__, __LINE__, errno);
+        goto RGBLED_STREAM_INIT_FAILED;
+    }
+    if (0 != bind(stream->sock, (struct sockaddr *)&addr, sizeof(addr))) {
+        ESP_LOGE(TAG, "%s (%d) unable to bind port %d: errno %d.", __FUNCTION__, __LINE__, port, errno);
+        goto RGBLED_STREAM_INIT_FAILED;
+    }
+    struct timeval timeout = {
+        .tv_sec = 0,
+        .tv_usec = RGBLED_STREAM_RECV_TIMEOUT_MS * 1000,
+    };
+    setsockopt(stream->sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    stream->task_exit = false;
+    if (pdPASS != xTaskCreate(rgbled_stream_task, "rgbled_stream", RGBLED_STREAM_TASK_STACK_SIZE, 
+                              stream, task_priority, &stream->task)) {
+        ESP_LOGE(TAG, "%s (%d) receive task create failed.", __FUNCTION__, __LINE__);
+        stream->task = NULL;
+        goto RGBLED_STREAM_INIT_FAILED;
+    }
+    ESP_LOGI(TAG, "%s (%d) rgbled stream listening on udp port %d.", __FUNCTION__, __LINE__, port);
+    return stream;
+
+RGBLED_STREAM_INIT_FAILED:
+    RGBled_StreamDeinit(&stream);
+    return NULL;
+}
+
+/**
+  * @brief  Stop receiving a DDP pixel stream.
+  * @param[in]  stream  RGBled stream handle pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_StreamDeinit(RGBled_StreamHandle_t *stream)
+{
+    RGBLED_STREAM_HANDLE_CHECK(*stream, ESP_FAIL);
+
+    // The task leaves within one receive timeout.
+    if (NULL != (*stream)->task) {
+        (*stream)->task_exit = true;
+        while (NULL != (*stream)->task) {
+            vTaskDelay(1);
+        }
+    }
+    if ((*stream)->sock >= 0) {
+        close((*stream)->sock);
+    }
+    free((*stream)->packet_buf);
+    free(*stream);
+    *stream = NULL;
+    return ESP_OK;
+}
+
+/**
+  * @brief  Get the receive statistics.
+  * @param[in]  stream  RGBled stream handle.
+  * @param[out]  stats  statistics since the stream was started.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t RGBled_StreamGetStats(RGBled_StreamHandle_t stream, RGBled_StreamStats_t *stats)
+{
+    RGBLED_STREAM_HANDLE_CHECK(stream, ESP_FAIL);
+    if (NULL == stats) {
+        return ESP_FAIL;
+    }
+
+    memcpy(stats, &stream->stats, sizeof(RGBled_StreamStats_t));
+    return ESP_OK;
+}
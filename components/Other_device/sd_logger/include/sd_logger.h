@@ -0,0 +1,132 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           sd_logger.h
+  * @version        1.0
+  * @date           2026-10-19
+  * @brief          Write-behind data logger for a mounted SD card.
+  */
+
+#ifndef __SD_LOGGER_H_
+#define __SD_LOGGER_H_
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "sd_logger_core.h"
+
+#define SD_LOGGER_TASK_STACK_SIZE   (3072)  // Flush task stack size.
+
+typedef struct{
+    const char *path;               // Log file path on a mounted file system, truncated when it exists.
+    uint32_t ring_size;             // Record buffer, power of two, taken from PSRAM when present.
+    uint32_t chunk_size;            // Bytes per card write, power of two, best a multiple of the cluster size.
+    uint32_t prealloc_size;         // File growth step, 0 disables preallocation.
+    uint32_t sync_interval;         // ms, max age of data not yet synced to the card.
+    UBaseType_t task_priority;      // Flush task priority, keep it below the producers.
+    BaseType_t core_id;             // Flush task core, tskNO_AFFINITY for any.
+}SD_LoggerConfig_t;
+
+#define SD_LOGGER_CONFIG_DEFAULT(file_path) {   \
+        .path = file_path,                      \
+        .ring_size = 64 * 1024,                 \
+        .chunk_size = 16 * 1024,                \
+        .prealloc_size = 1024 * 1024,           \
+        .sync_interval = 1000,                  \
+        .task_priority = 1,                     \
+        .core_id = tskNO_AFFINITY,              \
+    }
+
+typedef struct{
+    uint64_t bytes_written;         // Bytes in full chunks on the card.
+    uint32_t bytes_lost;            // Bytes dropped because the buffer was full.
+    uint32_t max_fill;              // Highest buffer fill.
+    uint32_t sync_count;
+    uint32_t write_error;
+}SD_LoggerStats_t;
+
+typedef struct{
+    SD_LoggerCore_t core;
+    uint32_t sync_interval;         // ms
+    SemaphoreHandle_t push_lock;    // Serializes producers, the flush task never takes it.
+    SemaphoreHandle_t sync_done;
+    volatile bool sync_request;
+    volatile esp_err_t sync_result;
+    TaskHandle_t task;
+    volatile bool task_exit;
+}SD_Logger_t;
+typedef SD_Logger_t *SD_Logger_handle_t;
+
+/**
+  * @brief  Create the log file and start the flush task.
+  * @param[in]  config  logger configuration.
+  * @retval  
+  *         successful  SD logger handle.
+  *         failed      NULL.
+  * @note  Records are copied into a RAM ring and written by a low priority task in chunk 
+  *        sized, chunk aligned writes. Data older than sync_interval is synced to the card, 
+  *        a power loss loses at most sync_interval of records.
+  * @note  The file system must be mounted. Use SD_Logger_Deinit() to release it.
+  */
+SD_Logger_handle_t SD_Logger_Init(const SD_LoggerConfig_t *config);
+
+/**
+  * @brief  Write everything, close the file and stop the flush task.
+  * @param[in]  logger  SD logger handle pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed, some data may not be on the card.
+  */
+esp_err_t SD_Logger_Deinit(SD_Logger_handle_t *logger);
+
+/**
+  * @brief  Add a record.
+  * @param[in]  logger  SD logger handle.
+  * @param[in]  data  record data.
+  * @param[in]  len  record length.
+  * @retval 
+  *         - ESP_OK         successful.
+  *         - ESP_ERR_NO_MEM the buffer is full, the record is dropped.
+  *         - ESP_FAIL       failed.
+  * @note  Only copies into RAM, never waits for the card. Safe to call from several tasks.
+  */
+esp_err_t SD_Logger_Write(SD_Logger_handle_t logger, const void *data, uint32_t len);
+
+/**
+  * @brief  Write all records added so far to the card and wait for the sync.
+  * @param[in]  logger  SD logger handle.
+  * @param[in]  timeout_ms  max wait time(ms).
+  * @retval 
+  *         - ESP_OK            successful.
+  *         - ESP_ERR_TIMEOUT   the sync did not finish in time.
+  *         - ESP_FAIL          failed.
+  */
+esp_err_t SD_Logger_Sync(SD_Logger_handle_t logger, uint32_t timeout_ms);
+
+/**
+  * @brief  Get the logger counters.
+  * @param[in]  logger  SD logger handle.
+  * @param[out]  stats  logger counters.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t SD_Logger_GetStats(SD_Logger_handle_t logger, SD_LoggerStats_t *stats);
+
+#endif /* __SD_LOGGER_H_ */
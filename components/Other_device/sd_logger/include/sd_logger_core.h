@@ -0,0 +1,126 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           sd_logger_core.h
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#ifndef __SD_LOGGER_CORE_H_
+#define __SD_LOGGER_CORE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SD_LOGGER_SECTOR_SIZE   512
+
+/*
+ * Write-behind core of the SD logger, plain C over POSIX file calls so it also runs on a host.
+ * Producers copy records into the ring (serialized by the caller), one flush side writes 
+ * whole chunks from the ring to the file at chunk aligned offsets without any lock.
+ * A sync writes the unfinished chunk at its final offset and fsyncs, the next flush rewrites 
+ * that chunk in place once it is full, so every write starts on a chunk boundary.
+ */
+typedef struct{
+    uint8_t *ring;
+    uint32_t ring_size;             // Power of two, at least chunk_size.
+    uint32_t chunk_size;            // Bytes per write, power of two, at least SD_LOGGER_SECTOR_SIZE.
+    uint8_t *stage;                 // Optional DMA capable copy buffer of chunk_size, NULL writes from the ring.
+    uint32_t head;                  // Free running, only written by producers.
+    uint32_t tail;                  // Free running, only written by the flush side.
+
+    int fd;
+    char path[64];
+    uint64_t file_pos;              // File offset of the chunk at tail, equal to the fd offset.
+    uint32_t partial;               // Bytes of the chunk at file_pos already written by a sync.
+    uint64_t prealloc_size;         // File growth step, 0 disables preallocation.
+    uint64_t prealloc_end;          // Current preallocated file size.
+
+    uint64_t bytes_written;         // Bytes in full chunks on the card.
+    uint32_t bytes_lost;            // Bytes dropped because the ring was full.
+    uint32_t max_fill;              // Highest ring fill seen by a producer.
+    uint32_t sync_count;
+    uint32_t write_error;
+}SD_LoggerCore_t;
+
+/**
+  * @brief  Logger core initialization.
+  * @param[out]  core  logger core.
+  * @param[in]  ring  ring buffer memory.
+  * @param[in]  ring_size  ring size, a power of two, at least chunk_size.
+  * @param[in]  chunk_size  bytes per write, a power of two, at least SD_LOGGER_SECTOR_SIZE.
+  * @param[in]  stage  optional copy buffer of chunk_size bytes for each write, NULL for none.
+  * @retval 
+  *         - 0   successful.
+  *         - -1  invalid sizes.
+  */
+int SD_LoggerCore_Init(SD_LoggerCore_t *core, uint8_t *ring, uint32_t ring_size, uint32_t chunk_size, uint8_t *stage);
+
+/**
+  * @brief  Create the log file.
+  * @param[in]  core  logger core.
+  * @param[in]  path  file path, an existing file is truncated.
+  * @param[in]  prealloc_size  the file is grown in steps of this size, 0 disables preallocation.
+  * @retval 
+  *         - 0   successful.
+  *         - -1  failed.
+  * @note  A preallocated file is longer than its data until SD_LoggerCore_Close() trims it.
+  */
+int SD_LoggerCore_Open(SD_LoggerCore_t *core, const char *path, uint64_t prealloc_size);
+
+/**
+  * @brief  Copy a record into the ring.
+  * @param[in]  core  logger core.
+  * @param[in]  data  record.
+  * @param[in]  len  record length.
+  * @retval 
+  *         - len  successful.
+  *         - 0    the ring is full, the record is dropped and counted in bytes_lost.
+  * @note  Producers must be serialized by the caller, the flush side may run at the same time.
+  */
+uint32_t SD_LoggerCore_Push(SD_LoggerCore_t *core, const void *data, uint32_t len);
+
+/**
+  * @brief  Bytes in the ring not yet consumed by full chunk writes.
+  * @param[in]  core  logger core.
+  * @retval 
+  *         - fill bytes.
+  */
+uint32_t SD_LoggerCore_Fill(const SD_LoggerCore_t *core);
+
+/**
+  * @brief  Write every full chunk, and with sync also the unfinished chunk followed by fsync.
+  * @param[in]  core  logger core.
+  * @param[in]  sync  make all data pushed so far durable.
+  * @retval 
+  *         - 0   successful.
+  *         - -1  write failed, the data stays in the ring.
+  * @note  Only one flush side may call this.
+  */
+int SD_LoggerCore_Flush(SD_LoggerCore_t *core, bool sync);
+
+/**
+  * @brief  Write everything, trim the preallocated space and close the file.
+  * @param[in]  core  logger core.
+  * @retval 
+  *         - 0   successful.
+  *         - -1  failed.
+  */
+int SD_LoggerCore_Close(SD_LoggerCore_t *core);
+
+#endif /* __SD_LOGGER_CORE_H_ */
@@ -0,0 +1,272 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           sd_logger.c
+  * @version        1.0
+  * @date           2026-10-19
+  * @brief          Write-behind data logger for a mounted SD card.
+  */
+
+#include "sd_logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+static const char *TAG = "SD logger";
+
+#define SD_LOGGER_HANDLE_CHECK(a, ret)  if (NULL == a) {                         \
+        ESP_LOGE(TAG, "%s (%d) driver handle is NULL.", __FUNCTION__, __LINE__); \
+        return (ret);                                                            \
+        }
+
+/**
+  * @brief  Flush task, writes full chunks when woken and syncs every sync interval.
+  * @param[in]  arg  SD logger handle.
+  */
+static void sd_logger_task(void *arg)
+{
+    SD_Logger_handle_t logger = (SD_Logger_handle_t)arg;
+    TickType_t interval = pdMS_TO_TICKS(logger->sync_interval);
+    TickType_t last_sync = xTaskGetTickCount();
+
+    while (!logger->task_exit) {
+        // Wait at most until the next sync is due, chunk wakes must not push it back.
+        TickType_t elapsed = xTaskGetTickCount() - last_sync;
+        ulTaskNotifyTake(pdTRUE, (elapsed >= interval) ? 0 : (interval - elapsed));
+        if (logger->task_exit) {
+            break;
+        }
+        TickType_t now = xTaskGetTickCount();
+        bool request = logger->sync_request;
+        bool sync = request || (now - last_sync >= interval);
+        int ret = SD_LoggerCore_Flush(&logger->core, sync);
+        if (0 != ret) {
+            ESP_LOGE(TAG, "%s (%d) write failed.", __FUNCTION__, __LINE__);
+        }
+        if (sync) {
+            last_sync = now;
+        }
+        if (request) {
+            logger->sync_result = (0 == ret) ? ESP_OK : ESP_FAIL;
+            logger->sync_request = false;
+            xSemaphoreGive(logger->sync_done);
+        }
+    }
+
+    logger->task = NULL;
+    vTaskDelete(NULL);
+}
+
+/**
+  * @brief  Free the logger memory, the file must be closed.
+  * @param[in]  logger  SD logger handle.
+  */
+static void sd_logger_free(SD_Logger_handle_t logger)
+{
+    if (NULL != logger->push_lock) {
+        vSemaphoreDelete(logger->push_lock);
+    }
+    if (NULL != logger->sync_done) {
+        vSemaphoreDelete(logger->sync_done);
+    }
+    heap_caps_free(logger->core.ring);
+    heap_caps_free(logger->core.stage);
+    free(logger);
+}
+
+/**
+  * @brief  Create the log file and start the flush task.
+  * @param[in]  config  logger configuration.
+  * @retval  
+  *         successful  SD logger handle.
+  *         failed      NULL.
+  * @note  Records are copied into a RAM ring and written by a low priority task in chunk 
+  *        sized, chunk aligned writes. Data older than sync_interval is synced to the card, 
+  *        a power loss loses at most sync_interval of records.
+  * @note  The file system must be mounted. Use SD_Logger_Deinit() to release it.
+  */
+SD_Logger_handle_t SD_Logger_Init(const SD_LoggerConfig_t *config)
+{
+    uint8_t *ring = NULL;
+    uint8_t *stage = NULL;
+
+    if ((NULL == config) || (NULL == config->path) || (0 == config->sync_interval)) {
+        ESP_LOGE(TAG, "%s (%d) invalid config.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+    SD_Logger_handle_t logger = calloc(1, sizeof(SD_Logger_t));
+    if (NULL == logger) {
+        ESP_LOGE(TAG, "%s (%d) driver handle malloc failed.", __FUNCTION__, __LINE__);
+        return NULL;
+    }
+    // The ring goes to PSRAM when there is some. The SD driver splits writes from memory 
+    // it cannot DMA into single sectors, so each chunk is then copied to an internal buffer first.
+    ring = heap_caps_malloc(config->ring_size, MALLOC_CAP_SPIRAM);
+    if (NULL != ring) {
+        stage = heap_caps_malloc(config->chunk_size, MALLOC_CAP_DMA);
+        if (NULL == stage) {
+            goto SD_LOGGER_INIT_FAILED;
+        }
+    } else {
+        ring = heap_caps_malloc(config->ring_size, MALLOC_CAP_DMA);
+    }
+    if (NULL == ring) {
+        ESP_LOGE(TAG, "%s (%d) ring buffer malloc failed.", __FUNCTION__, __LINE__);
+        goto SD_LOGGER_INIT_FAILED;
+    }
+    if (0 != SD_LoggerCore_Init(&logger->core, ring, config->ring_size, config->chunk_size, stage)) {
+        ESP_LOGE(TAG, "%s (%d) ring %u and chunk %u must be powers of two, chunk at least %d.", __FUNCTION__, 
+                 __LINE__, (unsigned)config->ring_size, (unsigned)config->chunk_size, SD_LOGGER_SECTOR_SIZE);
+        goto SD_LOGGER_INIT_FAILED;
+    }
+    logger->sync_interval = config->sync_interval;
+    logger->push_lock = xSemaphoreCreateMutex();
+    logger->sync_done = xSemaphoreCreateBinary();
+    if ((NULL == logger->push_lock) || (NULL == logger->sync_done)) {
+        goto SD_LOGGER_INIT_FAILED;
+    }
+    if (0 != SD_LoggerCore_Open(&logger->core, config->path, config->prealloc_size)) {
+        ESP_LOGE(TAG, "%s (%d) create %s failed.", __FUNCTION__, __LINE__, config->path);
+        goto SD_LOGGER_INIT_FAILED;
+    }
+    if (pdPASS != xTaskCreatePinnedToCore(sd_logger_task, "sd_logger", SD_LOGGER_TASK_STACK_SIZE, logger, 
+                                          config->task_priority, &logger->task, config->core_id)) {
+        logger->task = NULL;
+        SD_LoggerCore_Close(&logger->core);
+        goto SD_LOGGER_INIT_FAILED;
+    }
+    ESP_LOGI(TAG, "%s (%d) sd logger init ok, ring %u bytes in %s.", __FUNCTION__, __LINE__, 
+             (unsigned)config->ring_size, (NULL != stage) ? "PSRAM" : "internal RAM");
+    return logger;
+
+SD_LOGGER_INIT_FAILED:
+    ESP_LOGE(TAG, "%s (%d) sd logger init failed.", __FUNCTION__, __LINE__);
+    logger->core.ring = ring;
+    logger->core.stage = stage;
+    sd_logger_free(logger);
+    return NULL;
+}
+
+/**
+  * @brief  Write everything, close the file and stop the flush task.
+  * @param[in]  logger  SD logger handle pointer.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed, some data may not be on the card.
+  */
+esp_err_t SD_Logger_Deinit(SD_Logger_handle_t *logger)
+{
+    SD_LOGGER_HANDLE_CHECK(*logger, ESP_FAIL);
+
+    // Let the task finish the current write and delete itself.
+    (*logger)->task_exit = true;
+    xTaskNotifyGive((*logger)->task);
+    while (NULL != (*logger)->task) {
+        vTaskDelay(1);
+    }
+    int ret = SD_LoggerCore_Close(&(*logger)->core);
+
+    sd_logger_free(*logger);
+    *logger = NULL;
+    ESP_LOGI(TAG, "%s (%d) sd logger deinit ok.", __FUNCTION__, __LINE__);
+    return (0 == ret) ? ESP_OK : ESP_FAIL;
+}
+
+/**
+  * @brief  Add a record.
+  * @param[in]  logger  SD logger handle.
+  * @param[in]  data  record data.
+  * @param[in]  len  record length.
+  * @retval 
+  *         - ESP_OK         successful.
+  *         - ESP_ERR_NO_MEM the buffer is full, the record is dropped.
+  *         - ESP_FAIL       failed.
+  * @note  Only copies into RAM, never waits for the card. Safe to call from several tasks.
+  */
+esp_err_t SD_Logger_Write(SD_Logger_handle_t logger, const void *data, uint32_t len)
+{
+    SD_LOGGER_HANDLE_CHECK(logger, ESP_FAIL);
+    if ((NULL == data) || (0 == len)) {
+        return ESP_FAIL;
+    }
+
+    xSemaphoreTake(logger->push_lock, portMAX_DELAY);
+    uint32_t fill = SD_LoggerCore_Fill(&logger->core);
+    uint32_t ret = SD_LoggerCore_Push(&logger->core, data, len);
+    xSemaphoreGive(logger->push_lock);
+    if (0 == ret) {
+        return ESP_ERR_NO_MEM;
+    }
+    // Wake the task once per completed chunk.
+    if ((fill / logger->core.chunk_size) != ((fill + len) / logger->core.chunk_size)) {
+        xTaskNotifyGive(logger->task);
+    }
+    return ESP_OK;
+}
+
+/**
+  * @brief  Write all records added so far to the card and wait for the sync.
+  * @param[in]  logger  SD logger handle.
+  * @param[in]  timeout_ms  max wait time(ms).
+  * @retval 
+  *         - ESP_OK            successful.
+  *         - ESP_ERR_TIMEOUT   the sync did not finish in time.
+  *         - ESP_FAIL          failed.
+  */
+esp_err_t SD_Logger_Sync(SD_Logger_handle_t logger, uint32_t timeout_ms)
+{
+    SD_LOGGER_HANDLE_CHECK(logger, ESP_FAIL);
+
+    // Drop a stale completion of an earlier sync that timed out.
+    xSemaphoreTake(logger->sync_done, 0);
+    logger->sync_request = true;
+    xTaskNotifyGive(logger->task);
+    if (pdTRUE != xSemaphoreTake(logger->sync_done, pdMS_TO_TICKS(timeout_ms))) {
+        return ESP_ERR_TIMEOUT;
+    }
+    return logger->sync_result;
+}
+
+/**
+  * @brief  Get the logger counters.
+  * @param[in]  logger  SD logger handle.
+  * @param[out]  stats  logger counters.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  */
+esp_err_t SD_Logger_GetStats(SD_Logger_handle_t logger, SD_LoggerStats_t *stats)
+{
+    SD_LOGGER_HANDLE_CHECK(logger, ESP_FAIL);
+    if (NULL == stats) {
+        return ESP_FAIL;
+    }
+
+    stats->bytes_written = logger->core.bytes_written;
+    stats->bytes_lost = logger->core.bytes_lost;
+    stats->max_fill = logger->core.max_fill;
+    stats->sync_count = logger->core.sync_count;
+    stats->write_error = logger->core.write_error;
+    return ESP_OK;
+}
@@ -0,0 +1,301 @@
+/*****************************************************************************
+ *                                                                           *
+ *  Copyright 2021 upahead PTE LTD                                           *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *                                                                           *
+ *****************************************************************************/
+/**
+  * @file           sd_logger_core.c
+  * @version        1.0
+  * @date           2026-10-19
+  */
+
+#include "sd_logger_core.h"
+#include <string.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define SD_LOGGER_IS_POW2(x)    ((0 != (x)) && (0 == ((x) & ((x) - 1))))
+
+/**
+  * @brief  Write the whole buffer.
+  * @param[in]  fd  file descriptor.
+  * @param[in]  data  data to write.
+  * @param[in]  len  data length.
+  * @retval 
+  *         - 0   successful.
+  *         - -1  failed.
+  */
+static int sd_logger_write_all(int fd, const uint8_t *data, uint32_t len)
+{
+    while (len > 0) {
+        ssize_t ret = write(fd, data, len);
+        if (ret <= 0) {
+            return -1;
+        }
+        data += ret;
+        len -= ret;
+    }
+    return 0;
+}
+
+/**
+  * @brief  Make sure the file is preallocated up to end, the fd offset is left at file_pos.
+  * @param[in]  core  logger core.
+  * @param[in]  end  file size needed.
+  * @retval 
+  *         - 0   successful.
+  *         - -1  failed.
+  */
+static int sd_logger_grow(SD_LoggerCore_t *core, uint64_t end)
+{
+    uint64_t new_end = core->prealloc_end;
+
+    if ((0 == core->prealloc_size) || (end <= new_end)) {
+        return 0;
+    }
+    while (new_end < end) {
+        new_end += core->prealloc_size;
+    }
+    // Writing the last byte lets FAT allocate the whole cluster chain at once, 
+    // instead of one FAT and directory update per cluster while logging.
+    if ((lseek(core->fd, (off_t)(new_end - 1), SEEK_SET) < 0) || (1 != write(core->fd, "", 1))) {
+        lseek(core->fd, (off_t)core->file_pos, SEEK_SET);
+        return -1;
+    }
+    if (lseek(core->fd, (off_t)core->file_pos, SEEK_SET) < 0) {
+        return -1;
+    }
+    core->prealloc_end = new_end;
+    return 0;
+}
+
+/**
+  * @brief  Write part of the chunk at tail to its place in the file, the fd offset is left at file_pos.
+  * @param[in]  core  logger core.
+  * @param[in]  offset  offset in the chunk, a sector multiple.
+  * @param[in]  len  bytes to write.
+  * @retval 
+  *         - 0   successful.
+  *         - -1  failed.
+  */
+static int sd_logger_write_chunk(SD_LoggerCore_t *core, uint32_t offset, uint32_t len)
+{
+    const uint8_t *data = core->ring + ((core->tail + offset) & (core->ring_size - 1));
+    int ret = 0;
+
+    if (0 != sd_logger_grow(core, core->file_pos + core->chunk_size)) {
+        return -1;
+    }
+    if (NULL != core->stage) {
+        memcpy(core->stage, data, len);
+        data = core->stage;
+    }
+    if (0 != offset) {
+        ret = (lseek(core->fd, (off_t)(core->file_pos + offset), SEEK_SET) < 0) ? -1 : 0;
+    }
+    if (0 == ret) {
+        ret = sd_logger_write_all(core->fd, data, len);
+    }
+    if ((0 != ret) || (offset + len < core->chunk_size)) {
+        // Unfinished chunk or failed write, the next write starts at the chunk again.
+        if (lseek(core->fd, (off_t)core->file_pos, SEEK_SET) < 0) {
+            ret = -1;
+        }
+    }
+    return ret;
+}
+
+/**
+  * @brief  Logger core initialization.
+  * @param[out]  core  logger core.
+  * @param[in]  ring  ring buffer memory.
+  * @param[in]  ring_size  ring size, a power of two, at least chunk_size.
+  * @param[in]  chunk_size  bytes per write, a power of two, at least SD_LOGGER_SECTOR_SIZE.
+  * @param[in]  stage  optional copy buffer of chunk_size bytes for each write, NULL for none.
+  * @retval 
+  *         - 0   successful.
+  *         - -1  invalid sizes.
+  */
+int SD_LoggerCore_Init(SD_LoggerCore_t *core, uint8_t *ring, uint32_t ring_size, uint32_t chunk_size, uint8_t *stage)
+{
+    if ((NULL == ring) || !SD_LOGGER_IS_POW2(ring_size) || !SD_LOGGER_IS_POW2(chunk_size) || 
+        (chunk_size < SD_LOGGER_SECTOR_SIZE) || (chunk_size > ring_size)) {
+        return -1;
+    }
+    memset(core, 0, sizeof(SD_LoggerCore_t));
+    core->ring = ring;
+    core->ring_size = ring_size;
+    core->chunk_size = chunk_size;
+    core->stage = stage;
+    core->fd = -1;
+    return 0;
+}
+
+/**
+  * @brief  Create the log file.
+  * @param[in]  core  logger core.
+  * @param[in]  path  file path, an existing file is truncated.
+  * @param[in]  prealloc_size  the file is grown in steps of this size, 0 disables preallocation.
+  * @retval 
+  *         - 0   successful.
+  *         - -1  failed.
+  * @note  A preallocated file is longer than its data until SD_LoggerCore_Close() trims it.
+  */
+int SD_LoggerCore_Open(SD_LoggerCore_t *core, const char *path, uint64_t prealloc_size)
+{
+    if ((NULL == path) || (strlen(path) >= sizeof(core->path)) || (core->fd >= 0)) {
+        return -1;
+    }
+    core->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (core->fd < 0) {
+        return -1;
+    }
+    strcpy(core->path, path);
+    core->file_pos = 0;
+    core->partial = 0;
+    core->prealloc_end = 0;
+    // Keep the file growth a chunk multiple.
+    core->prealloc_size = (prealloc_size + core->chunk_size - 1) & ~(uint64_t)(core->chunk_size - 1);
+    if (0 != sd_logger_grow(core, core->chunk_size)) {
+        close(core->fd);
+        core->fd = -1;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+  * @brief  Copy a record into the ring.
+  * @param[in]  core  logger core.
+  * @param[in]  data  record.
+  * @param[in]  len  record length.
+  * @retval 
+  *         - len  successful.
+  *         - 0    the ring is full, the record is dropped and counted in bytes_lost.
+  * @note  Producers must be serialized by the caller, the flush side may run at the same time.
+  */
+uint32_t SD_LoggerCore_Push(SD_LoggerCore_t *core, const void *data, uint32_t len)
+{
+    uint32_t head = core->head;
+    uint32_t fill = head - __atomic_load_n(&core->tail, __ATOMIC_ACQUIRE);
+    uint32_t offset = head & (core->ring_size - 1);
+
+    if (len > core->ring_size - fill) {
+        core->bytes_lost += len;
+        return 0;
+    }
+    uint32_t first = core->ring_size - offset;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(core->ring + offset, data, first);
+    memcpy(core->ring, (const uint8_t *)data + first, len - first);
+    fill += len;
+    if (fill > core->max_fill) {
+        core->max_fill = fill;
+    }
+    // Publish the data before the new head.
+    __atomic_store_n(&core->head, head + len, __ATOMIC_RELEASE);
+    return len;
+}
+
+/**
+  * @brief  Bytes in the ring not yet consumed by full chunk writes.
+  * @param[in]  core  logger core.
+  * @retval 
+  *         - fill bytes.
+  */
+uint32_t SD_LoggerCore_Fill(const SD_LoggerCore_t *core)
+{
+    return __atomic_load_n(&core->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&core->tail, __ATOMIC_ACQUIRE);
+}
+
+/**
+  * @brief  Write every full chunk, and with sync also the unfinished chunk followed by fsync.
+  * @param[in]  core  logger core.
+  * @param[in]  sync  make all data pushed so far durable.
+  * @retval 
+  *         - 0   successful.
+  *         - -1  write failed, the data stays in the ring.
+  * @note  Only one flush side may call this.
+  */
+int SD_LoggerCore_Flush(SD_LoggerCore_t *core, bool sync)
+{
+    uint32_t head = __atomic_load_n(&core->head, __ATOMIC_ACQUIRE);
+
+    if (core->fd < 0) {
+        return -1;
+    }
+    while (head - core->tail >= core->chunk_size) {
+        // Sectors already written by a sync are written again with the rest of the chunk, 
+        // this keeps the chunk a single multi block write.
+        if (0 != sd_logger_write_chunk(core, 0, core->chunk_size)) {
+            core->write_error++;
+            return -1;
+        }
+        core->file_pos += core->chunk_size;
+        core->partial = 0;
+        core->bytes_written += core->chunk_size;
+        // Hand the chunk back to the producers.
+        __atomic_store_n(&core->tail, core->tail + core->chunk_size, __ATOMIC_RELEASE);
+    }
+    if (!sync) {
+        return 0;
+    }
+
+    uint32_t pending = head - core->tail;
+    if (pending > core->partial) {
+        // Start at the sector holding the first new byte.
+        uint32_t offset = core->partial & ~(uint32_t)(SD_LOGGER_SECTOR_SIZE - 1);
+        if (0 != sd_logger_write_chunk(core, offset, pending - offset)) {
+            core->write_error++;
+            return -1;
+        }
+        core->partial = pending;
+    }
+    if (0 != fsync(core->fd)) {
+        core->write_error++;
+        return -1;
+    }
+    core->sync_count++;
+    return 0;
+}
+
+/**
+  * @brief  Write everything, trim the preallocated space and close the file.
+  * @param[in]  core  logger core.
+  * @retval 
+  *         - 0   successful.
+  *         - -1  failed.
+  */
+int SD_LoggerCore_Close(SD_LoggerCore_t *core)
+{
+    int ret = 0;
+
+    if (core->fd < 0) {
+        return -1;
+    }
+    ret = SD_LoggerCore_Flush(core, true);
+    uint64_t length = core->file_pos + core->partial;
+    if (0 != close(core->fd)) {
+        ret = -1;
+    }
+    core->fd = -1;
+    if ((0 != core->prealloc_end) && (0 != truncate(core->path, (off_t)length))) {
+        ret = -1;
+    }
+    return ret;
+}
@@ -15,14 +15,72 @@
 #include "sdmmc_cmd.h"
 #include "driver/gpio.h"
 
+#define SD_VFS_BENCH_FILE_NAME  "/sd_bench.bin"
+
+// SD SPI bus and mount configuration.
+typedef struct{
+    gpio_num_t miso;
+    gpio_num_t mosi;
+    gpio_num_t clk;
+    gpio_num_t cs;
+    spi_host_device_t host;         // SPI peripheral.
+    int dma_chan;                   // 1, 2 or SPI_DMA_CH_AUTO where supported.
+    int max_transfer_sz;            // Bytes per SPI DMA transfer.
+    int freq_khz;                   // Start clock, lowered step by step while the card shows CRC errors.
+    size_t allocation_unit_size;    // FAT cluster size used when formatting.
+    int max_files;                  // Files open at the same time.
+    bool format_if_mount_failed;
+}SD_Spi_Vfs_Config_t;
+
+#define SD_SPI_VFS_CONFIG_DEFAULT(miso_num, mosi_num, clk_num, cs_num) {    \
+        .miso = miso_num,                                                   \
+        .mosi = mosi_num,                                                   \
+        .clk = clk_num,                                                     \
+        .cs = cs_num,                                                       \
+        .host = SDSPI_DEFAULT_HOST,                                         \
+        .dma_chan = 1,                                                      \
+        .max_transfer_sz = 16 * 1024,                                       \
+        .freq_khz = SDMMC_FREQ_HIGHSPEED,                                   \
+        .allocation_unit_size = 32 * 1024,                                  \
+        .max_files = 5,                                                     \
+        .format_if_mount_failed = false,                                    \
+    }
+
+// SDMMC host mount configuration, for boards that route the SD bus pins.
+typedef struct{
+    uint8_t width;                  // Bus width, 1 or 4.
+    bool internal_pullup;           // Weak internal pull ups, external 10k resistors are still advised.
+    int freq_khz;                   // Start clock, lowered step by step while the card shows CRC errors.
+    size_t allocation_unit_size;
+    int max_files;
+    bool format_if_mount_failed;
+}SD_Mmc_Vfs_Config_t;
+
+#define SD_MMC_VFS_CONFIG_DEFAULT() {                                       \
+        .width = 4,                                                         \
+        .internal_pullup = true,                                            \
+        .freq_khz = SDMMC_FREQ_HIGHSPEED,                                   \
+        .allocation_unit_size = 32 * 1024,                                  \
+        .max_files = 5,                                                     \
+        .format_if_mount_failed = false,                                    \
+    }
+
 // sd spi驱动句柄
 typedef struct{
     char sd_mount_path[20];
     sdmmc_card_t* sd_card;
     spi_host_device_t sd_host;
+    bool sdmmc;                     // Mounted through the SDMMC host, no SPI bus to free.
+    int freq_khz;                   // Clock the card was mounted at.
 }SD_Spi_Vfs_t;
 typedef SD_Spi_Vfs_t *SD_Spi_Vfs_handle_t;
 
+// Throughput of one benchmark run.
+typedef struct{
+    float write_mbps;               // MB/s, including fsync.
+    float read_mbps;                // MB/s.
+}SD_Vfs_BenchResult_t;
+
 /**
   * @brief  SD卡使用SPI初始化，挂载vfs/fat文件系统
   * @param  sd_miso_num：SPI miso端口
@@ -44,4 +102,44 @@ SD_Spi_Vfs_handle_t SD_Spi_Vfs_Init(gpio_num_t sd_miso_num, gpio_num_t sd_mosi_n
   */                              
 esp_err_t SD_Spi_Vfs_Deinit(SD_Spi_Vfs_handle_t* sd);
 
+/**
+  * @brief  Mount the SD card over SPI with the given bus and file system settings.
+  * @param[in]  config  SPI and mount configuration, see SD_SPI_VFS_CONFIG_DEFAULT().
+  * @param[in]  mount_path  Mount path name, add'/' in front.
+  * @retval  
+  *         successful  SD operation handle.
+  *         failed      NULL.
+  * @note   When the card fails to initialize or reading it shows CRC errors, the card is mounted 
+  *         again at the next lower clock, freq_khz in the handle holds the clock in use.
+  * @note   Use SD_Spi_Vfs_Deinit() to release it.
+  */
+SD_Spi_Vfs_handle_t SD_Spi_Vfs_InitConfig(const SD_Spi_Vfs_Config_t *config, const char *mount_path);
+
+/**
+  * @brief  Mount the SD card over the SDMMC host in 1 or 4 bit mode.
+  * @param[in]  config  SDMMC and mount configuration, see SD_MMC_VFS_CONFIG_DEFAULT().
+  * @param[in]  mount_path  Mount path name, add'/' in front.
+  * @retval  
+  *         successful  SD operation handle.
+  *         failed      NULL.
+  * @note   On the ESP32 the slot 1 pins are fixed: CLK 14, CMD 15, D0 2, D1 4, D2 12, D3 13.
+  *         GPIO12 is a strapping pin, a pull up on D2 needs the flash voltage set by eFuse.
+  * @note   Same clock fallback as SD_Spi_Vfs_InitConfig(). Use SD_Spi_Vfs_Deinit() to release it.
+  */
+SD_Spi_Vfs_handle_t SD_Mmc_Vfs_Init(const SD_Mmc_Vfs_Config_t *config, const char *mount_path);
+
+/**
+  * @brief  Measure sequential write and read throughput through the file system.
+  * @param[in]  sd  SD operation handle.
+  * @param[in]  file_size  bytes written and read back.
+  * @param[in]  block_size  bytes per write and read call.
+  * @param[out]  result  throughput.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note   Uses SD_VFS_BENCH_FILE_NAME in the mount path and deletes it afterwards.
+  */
+esp_err_t SD_Vfs_Benchmark(SD_Spi_Vfs_handle_t sd, uint32_t file_size, uint32_t block_size, 
+                           SD_Vfs_BenchResult_t *result);
+
 #endif /* __SD_SPI_VFS_H */
\ No newline at end of file
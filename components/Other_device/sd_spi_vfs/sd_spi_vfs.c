@@ -12,10 +12,132 @@
 #include "sdmmc_cmd.h"
 #include "sdkconfig.h"
 #include "driver/gpio.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include <fcntl.h>
 #include "sd_spi_vfs.h"
 
 static const char *TAG = "SD_SPI_VFS";
 
+#define SD_VFS_PROBE_SECTORS    32      // Sectors read to check the link after mounting.
+
+// Clock steps (kHz) tried when the card shows errors.
+static const int sd_vfs_freq_steps[] = {SDMMC_FREQ_HIGHSPEED, 26000, SDMMC_FREQ_DEFAULT, 10000, 5000};
+
+/**
+  * @brief  Next lower clock step.
+  * @param[in]  freq_khz  current clock(kHz).
+  * @retval 
+  *         - next clock(kHz), 0 when there is none.
+  */
+static int sd_vfs_next_freq(int freq_khz)
+{
+    for (uint8_t i = 0; i < sizeof(sd_vfs_freq_steps) / sizeof(sd_vfs_freq_steps[0]); i++) {
+        if (sd_vfs_freq_steps[i] < freq_khz) {
+            return sd_vfs_freq_steps[i];
+        }
+    }
+    return 0;
+}
+
+/**
+  * @brief  Read the first sectors, CRC errors here mean the clock is too high for the wiring.
+  * @param[in]  card  mounted card.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - others    read error.
+  */
+static esp_err_t sd_vfs_probe(sdmmc_card_t *card)
+{
+    uint8_t *buf = heap_caps_malloc(SD_VFS_PROBE_SECTORS * card->csd.sector_size, MALLOC_CAP_DMA);
+    if (NULL == buf) {
+        return ESP_ERR_NO_MEM;
+    }
+    esp_err_t err = sdmmc_read_sectors(card, buf, 0, SD_VFS_PROBE_SECTORS);
+    free(buf);
+    return err;
+}
+
+/**
+  * @brief  Mount the card, retrying at lower clocks while it shows link errors.
+  * @param[in]  sd  sd driver handle, sd_mount_path and sdmmc are set.
+  * @param[in]  host  host description, max_freq_khz is overwritten.
+  * @param[in]  slot_config  sdspi_device_config_t or sdmmc_slot_config_t.
+  * @param[in]  mount_config  file system mount options.
+  * @param[in]  freq_khz  first clock(kHz) to try.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - others    mount error at the last clock tried.
+  */
+static esp_err_t sd_vfs_mount(SD_Spi_Vfs_handle_t sd, sdmmc_host_t *host, const void *slot_config, 
+                              const esp_vfs_fat_sdmmc_mount_config_t *mount_config, int freq_khz)
+{
+    esp_err_t err;
+
+    while (1) {
+        host->max_freq_khz = freq_khz;
+        if (sd->sdmmc) {
+            err = esp_vfs_fat_sdmmc_mount(sd->sd_mount_path, host, slot_config, mount_config, &sd->sd_card);
+        } else {
+            err = esp_vfs_fat_sdspi_mount(sd->sd_mount_path, host, slot_config, mount_config, &sd->sd_card);
+        }
+        if (ESP_OK == err) {
+            err = sd_vfs_probe(sd->sd_card);
+            if (ESP_OK == err) {
+                sd->freq_khz = freq_khz;
+                return ESP_OK;
+            }
+            esp_vfs_fat_sdcard_unmount(sd->sd_mount_path, sd->sd_card);
+        }
+        // Only link errors get better at a lower clock.
+        int next_freq = sd_vfs_next_freq(freq_khz);
+        if (((ESP_ERR_INVALID_CRC != err) && (ESP_ERR_TIMEOUT != err) && (ESP_ERR_INVALID_RESPONSE != err)) || 
+            (0 == next_freq)) {
+            return err;
+        }
+        ESP_LOGW(TAG, "%s (%d) card error (%s) at %d kHz, retry at %d kHz.", __FUNCTION__, __LINE__, 
+                 esp_err_to_name(err), freq_khz, next_freq);
+        freq_khz = next_freq;
+    }
+}
+
+/**
+  * @brief  Log a mount error.
+  * @param[in]  err  mount error.
+  */
+static void sd_vfs_mount_error(esp_err_t err)
+{
+    if (err == ESP_FAIL) {
+        ESP_LOGE(TAG, "Failed to mount filesystem. "
+            "If you want the card to be formatted, set format_if_mount_failed.");
+    } else {
+        ESP_LOGE(TAG, "Failed to initialize the card (%s). "
+            "Make sure SD card lines have pull-up resistors in place.", esp_err_to_name(err));
+    }
+}
+
+/**
+  * @brief  Allocate the driver handle.
+  * @param[in]  mount_path  Mount path name.
+  * @retval 
+  *         successful  sd driver handle.
+  *         failed      NULL.
+  */
+static SD_Spi_Vfs_handle_t sd_vfs_new(const char *mount_path)
+{
+    if ((NULL == mount_path) || (strlen(mount_path) >= sizeof(((SD_Spi_Vfs_t *)0)->sd_mount_path))) {
+        ESP_LOGE(TAG, "Invalid mount path.");
+        return NULL;
+    }
+    SD_Spi_Vfs_handle_t sd = calloc(1, sizeof(SD_Spi_Vfs_t));
+    if (NULL == sd) {
+        ESP_LOGE(TAG, "Driver info malloc memory failed.\n");
+        return NULL;
+    }
+    strcpy(sd->sd_mount_path, mount_path);
+    return sd;
+}
+
 /**
   * @brief  The SD card uses SPI to initialize and mount the vfs/fat file system.
   * @param[in]  sd_miso_num  SPI miso port.
@@ -31,40 +153,63 @@ static const char *TAG = "SD_SPI_VFS";
   */
 SD_Spi_Vfs_handle_t SD_Spi_Vfs_Init(gpio_num_t sd_miso_num, gpio_num_t sd_mosi_num, gpio_num_t sd_clk_num, 
                               gpio_num_t sd_cs_num, const char* mount_path, bool card_formatted)
+{
+    // The settings this function always used.
+    SD_Spi_Vfs_Config_t config = SD_SPI_VFS_CONFIG_DEFAULT(sd_miso_num, sd_mosi_num, sd_clk_num, sd_cs_num);
+    config.max_transfer_sz = 4000;
+    config.freq_khz = SDMMC_FREQ_DEFAULT;
+    config.allocation_unit_size = 16 * 1024;
+    config.format_if_mount_failed = card_formatted;
+
+    return SD_Spi_Vfs_InitConfig(&config, mount_path);
+}
+
+/**
+  * @brief  Mount the SD card over SPI with the given bus and file system settings.
+  * @param[in]  config  SPI and mount configuration, see SD_SPI_VFS_CONFIG_DEFAULT().
+  * @param[in]  mount_path  Mount path name, add'/' in front.
+  * @retval  
+  *         successful  SD operation handle.
+  *         failed      NULL.
+  * @note   When the card fails to initialize or reading it shows CRC errors, the card is mounted 
+  *         again at the next lower clock, freq_khz in the handle holds the clock in use.
+  * @note   Use SD_Spi_Vfs_Deinit() to release it.
+  */
+SD_Spi_Vfs_handle_t SD_Spi_Vfs_InitConfig(const SD_Spi_Vfs_Config_t *config, const char *mount_path)
 {
     esp_err_t err;
 
     ESP_LOGI(TAG, "Initializing SD card");
 
-    SD_Spi_Vfs_handle_t sd = malloc(sizeof(SD_Spi_Vfs_t));
-    if(NULL == sd){
-        ESP_LOGE(TAG, "Driver info malloc memory failed.\n");
+    if (NULL == config) {
+        return NULL;
+    }
+    SD_Spi_Vfs_handle_t sd = sd_vfs_new(mount_path);
+    if (NULL == sd) {
         return NULL;
     }
-
-    // Mount path.
-    strncpy(sd->sd_mount_path, mount_path, strlen(mount_path));
 
     // Options for mounting the filesystem.
     // If format_if_mount_failed is set to true, SD card will be partitioned and
     // formatted in case when mounting fails.
     esp_vfs_fat_sdmmc_mount_config_t mount_config = {
-        .format_if_mount_failed = card_formatted,
-        .max_files = 5,
-        .allocation_unit_size = 16 * 1024
+        .format_if_mount_failed = config->format_if_mount_failed,
+        .max_files = config->max_files,
+        .allocation_unit_size = config->allocation_unit_size,
     };
 
     sdmmc_host_t host = SDSPI_HOST_DEFAULT();
+    host.slot = config->host;
     sd->sd_host = host.slot;
     spi_bus_config_t bus_cfg = {
-        .mosi_io_num = sd_mosi_num,
-        .miso_io_num = sd_miso_num,
-        .sclk_io_num = sd_clk_num,
+        .mosi_io_num = config->mosi,
+        .miso_io_num = config->miso,
+        .sclk_io_num = config->clk,
         .quadwp_io_num = -1,
         .quadhd_io_num = -1,
-        .max_transfer_sz = 4000,
+        .max_transfer_sz = config->max_transfer_sz,
     };
-    err = spi_bus_initialize(host.slot, &bus_cfg, 1);
+    err = spi_bus_initialize(host.slot, &bus_cfg, config->dma_chan);
     if(err != ESP_OK){
         ESP_LOGE(TAG, "Failed to initialize sd spi bus.");
         free(sd);
@@ -73,17 +218,12 @@ SD_Spi_Vfs_handle_t SD_Spi_Vfs_Init(gpio_num_t sd_miso_num, gpio_num_t sd_mosi_n
     // This initializes the slot without card detect (CD) and write protect (WP) signals.
     // Modify slot_config.gpio_cd and slot_config.gpio_wp if your board has these signals.
     sdspi_device_config_t slot_config = SDSPI_DEVICE_CONFIG_DEFAULT();
-    slot_config.gpio_cs = sd_cs_num;
+    slot_config.gpio_cs = config->cs;
     slot_config.host_id = host.slot;
-    err = esp_vfs_fat_sdspi_mount(mount_path, &host, &slot_config, &mount_config, &sd->sd_card);
+    err = sd_vfs_mount(sd, &host, &slot_config, &mount_config, config->freq_khz);
     if (err != ESP_OK) {
-        if (err == ESP_FAIL) {
-            ESP_LOGE(TAG, "Failed to mount filesystem. "
-                "If you want the card to be formatted, set the EXAMPLE_FORMAT_IF_MOUNT_FAILED menuconfig option.");
-        } else {
-            ESP_LOGE(TAG, "Failed to initialize the card (%s). "
-                "Make sure SD card lines have pull-up resistors in place.", esp_err_to_name(err));
-        }
+        sd_vfs_mount_error(err);
+        spi_bus_free(host.slot);
         free(sd);
         return NULL;
     }
@@ -91,7 +231,58 @@ SD_Spi_Vfs_handle_t SD_Spi_Vfs_Init(gpio_num_t sd_miso_num, gpio_num_t sd_mosi_n
     // Card has been initialized, print its properties
     sdmmc_card_print_info(stdout, sd->sd_card);
 
-    ESP_LOGI(TAG, "Init successful.");
+    ESP_LOGI(TAG, "Init successful, %d kHz.", sd->freq_khz);
+    return sd;
+}
+
+/**
+  * @brief  Mount the SD card over the SDMMC host in 1 or 4 bit mode.
+  * @param[in]  config  SDMMC and mount configuration, see SD_MMC_VFS_CONFIG_DEFAULT().
+  * @param[in]  mount_path  Mount path name, add'/' in front.
+  * @retval  
+  *         successful  SD operation handle.
+  *         failed      NULL.
+  * @note   On the ESP32 the slot 1 pins are fixed: CLK 14, CMD 15, D0 2, D1 4, D2 12, D3 13.
+  *         GPIO12 is a strapping pin, a pull up on D2 needs the flash voltage set by eFuse.
+  * @note   Same clock fallback as SD_Spi_Vfs_InitConfig(). Use SD_Spi_Vfs_Deinit() to release it.
+  */
+SD_Spi_Vfs_handle_t SD_Mmc_Vfs_Init(const SD_Mmc_Vfs_Config_t *config, const char *mount_path)
+{
+    esp_err_t err;
+
+    ESP_LOGI(TAG, "Initializing SD card, SDMMC host");
+
+    if ((NULL == config) || ((1 != config->width) && (4 != config->width))) {
+        ESP_LOGE(TAG, "Invalid SDMMC config.");
+        return NULL;
+    }
+    SD_Spi_Vfs_handle_t sd = sd_vfs_new(mount_path);
+    if (NULL == sd) {
+        return NULL;
+    }
+    sd->sdmmc = true;
+
+    esp_vfs_fat_sdmmc_mount_config_t mount_config = {
+        .format_if_mount_failed = config->format_if_mount_failed,
+        .max_files = config->max_files,
+        .allocation_unit_size = config->allocation_unit_size,
+    };
+    sdmmc_host_t host = SDMMC_HOST_DEFAULT();
+    sdmmc_slot_config_t slot_config = SDMMC_SLOT_CONFIG_DEFAULT();
+    slot_config.width = config->width;
+    if (config->internal_pullup) {
+        slot_config.flags |= SDMMC_SLOT_FLAG_INTERNAL_PULLUP;
+    }
+    err = sd_vfs_mount(sd, &host, &slot_config, &mount_config, config->freq_khz);
+    if (err != ESP_OK) {
+        sd_vfs_mount_error(err);
+        free(sd);
+        return NULL;
+    }
+
+    sdmmc_card_print_info(stdout, sd->sd_card);
+
+    ESP_LOGI(TAG, "Init successful, %d bit, %d kHz.", config->width, sd->freq_khz);
     return sd;
 }
 
@@ -112,8 +303,87 @@ esp_err_t SD_Spi_Vfs_Deinit(SD_Spi_Vfs_handle_t* sd)
 
     esp_vfs_fat_sdcard_unmount((*sd)->sd_mount_path, (*sd)->sd_card);
     ESP_LOGI(TAG, "Card unmounted");
-    spi_bus_free((*sd)->sd_host);
+    if (!(*sd)->sdmmc) {
+        spi_bus_free((*sd)->sd_host);
+    }
     free(*sd);
     (*sd) = NULL;
     return ESP_OK;
 }
+
+/**
+  * @brief  Measure sequential write and read throughput through the file system.
+  * @param[in]  sd  SD operation handle.
+  * @param[in]  file_size  bytes written and read back.
+  * @param[in]  block_size  bytes per write and read call.
+  * @param[out]  result  throughput.
+  * @retval 
+  *         - ESP_OK    successful.
+  *         - ESP_FAIL  failed.
+  * @note   Uses SD_VFS_BENCH_FILE_NAME in the mount path and deletes it afterwards.
+  */
+esp_err_t SD_Vfs_Benchmark(SD_Spi_Vfs_handle_t sd, uint32_t file_size, uint32_t block_size, 
+                           SD_Vfs_BenchResult_t *result)
+{
+    char path[sizeof(sd->sd_mount_path) + sizeof(SD_VFS_BENCH_FILE_NAME)];
+    esp_err_t err = ESP_FAIL;
+    uint32_t done = 0;
+    int64_t start;
+    int fd;
+
+    if ((NULL == sd) || (NULL == result) || (0 == block_size) || (0 == file_size)) {
+        ESP_LOGE(TAG, "Invalid benchmark arguments.");
+        return ESP_FAIL;
+    }
+    // A DMA capable buffer lets FAT hand full sectors straight to the driver.
+    uint8_t *buf = heap_caps_malloc(block_size, MALLOC_CAP_DMA);
+    if (NULL == buf) {
+        ESP_LOGE(TAG, "Benchmark buffer malloc failed.");
+        return ESP_FAIL;
+    }
+    for (uint32_t i = 0; i < block_size; i++) {
+        buf[i] = (uint8_t)i;
+    }
+    snprintf(path, sizeof(path), "%s%s", sd->sd_mount_path, SD_VFS_BENCH_FILE_NAME);
+
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        goto SD_VFS_BENCH_FAILED;
+    }
+    start = esp_timer_get_time();
+    for (done = 0; done < file_size; done += block_size) {
+        uint32_t len = (file_size - done < block_size) ? (file_size - done) : block_size;
+        if (write(fd, buf, len) != (ssize_t)len) {
+            close(fd);
+            goto SD_VFS_BENCH_FAILED;
+        }
+    }
+    fsync(fd);
+    close(fd);
+    // Bytes per us is MB/s.
+    result->write_mbps = (float)file_size / (float)(esp_timer_get_time() - start);
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        goto SD_VFS_BENCH_FAILED;
+    }
+    start = esp_timer_get_time();
+    for (done = 0; done < file_size; ) {
+        ssize_t len = read(fd, buf, block_size);
+        if (len <= 0) {
+            break;
+        }
+        done += len;
+    }
+    close(fd);
+    result->read_mbps = (float)done / (float)(esp_timer_get_time() - start);
+    err = (done == file_size) ? ESP_OK : ESP_FAIL;
+
+SD_VFS_BENCH_FAILED:
+    if (ESP_OK != err) {
+        ESP_LOGE(TAG, "Benchmark on %s failed.", path);
+    }
+    unlink(path);
+    free(buf);
+    return err;
+}
@@ -0,0 +1,136 @@
+/*
+ * AXP192 fuel gauge replay test for a Linux host.
+ *
+ * Feeds a recorded or simulated battery trace through AXP192_FuelGaugeStep(), the same state
+ * of charge estimate AXP192_FuelGaugeUpdate() runs on the ESP32. The coulomb counter is
+ * simulated by integrating the trace current, optionally with a gain error, and the estimate
+ * is compared with the true state of charge column.
+ *
+ * fuel_gauge_trace.txt is written by gen_fuel_gauge_trace.py from a cell that does not match
+ * the configuration below: other OCV curve and internal resistance, polarization and noise.
+ * Replace it with a logged discharge of the real battery when one is available.
+ *
+ *     gcc -O2 -Wall -I../../../../../components/I2C_device/axp192/include \
+ *         fuel_gauge_replay.c ../../../../../components/I2C_device/axp192/axp192_fuel_gauge_core.c \
+ *         -o fuel_gauge_replay
+ *     ./fuel_gauge_replay fuel_gauge_trace.txt            # run the checks
+ *     ./fuel_gauge_replay fuel_gauge_trace.txt 5 -v       # counter 5% high, print every minute
+ *
+ * Trace lines: time_s battery_mV current_mA true_soc, current positive while charging,
+ * state of charge in 0.1%. Lines starting with # are echoed with -v.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "axp192_fuel_gauge_core.h"
+
+// Configuration under test, the default curve of axp192_fuel_gauge.c.
+static const AXP192_OcvPoint_t ocv_table[] = {
+    {3400, 0},   {3650, 100}, {3710, 200}, {3730, 300}, {3760, 400}, {3790, 500},
+    {3840, 600}, {3900, 700}, {3970, 800}, {4080, 900}, {4150, 1000},
+};
+
+static const AXP192_FuelGaugeConfig_t config = {
+    .capacity = 1000,
+    .internal_resistance = 150,
+    .rest_current = 20,
+    .ocv_table = ocv_table,
+    .ocv_table_len = sizeof(ocv_table) / sizeof(ocv_table[0]),
+};
+
+typedef struct{
+    int max_load_error;             // Largest |estimate - true| under load, 0.1%.
+    int max_rest_error;             // Largest |estimate - true| at the end of a rest, 0.1%.
+    int final_error;
+}ReplayResult_t;
+
+static int replay(const char *path, int gain_percent, int verbose, ReplayResult_t *result)
+{
+    AXP192_FuelGaugeState_t state = {0};
+    char line[160];
+    long time_s = 0, last_time = 0;
+    int vol = 0, current = 0, true_soc = 0, last_current = 0, last_error = 0;
+    double charge = 0;              // Simulated coulomb counter, uAh.
+
+    FILE *f = fopen(path, "r");
+    if (NULL == f) {
+        return -1;
+    }
+    memset(result, 0, sizeof(*result));
+    while (NULL != fgets(line, sizeof(line), f)) {
+        if ('#' == line[0]) {
+            if (verbose) {
+                printf("%s", line);
+            }
+            continue;
+        }
+        if (4 != sscanf(line, "%ld %d %d %d", &time_s, &vol, &current, &true_soc)) {
+            continue;
+        }
+        // A rest ended, its last estimate is the corrected one.
+        if ((abs(last_current) <= config.rest_current) && (abs(current) > config.rest_current) &&
+            (abs(last_error) > result->max_rest_error)) {
+            result->max_rest_error = abs(last_error);
+        }
+        charge += current * (time_s - last_time) * (1000.0 + 10 * gain_percent) / 3600;
+        last_time = time_s;
+        uint16_t soc = AXP192_FuelGaugeStep(&config, &state, (int64_t)charge, vol, current);
+        int error = (int)soc - true_soc;
+        if ((abs(current) > config.rest_current) && (abs(error) > result->max_load_error)) {
+            result->max_load_error = abs(error);
+        }
+        if (verbose && (0 == time_s % 60)) {
+            printf("%6ld s %5d mV %5d mA  true %4d  estimate %4d  error %4d\n", time_s, vol, current,
+                   true_soc, soc, error);
+        }
+        last_current = current;
+        last_error = error;
+    }
+    fclose(f);
+    result->final_error = abs(last_error);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    // Counter gain error(%), allowed error under load and after a rest, unit 0.1%. 
+    // The OCV curve mismatch of the simulated cell alone is worth about 2% after a rest.
+    static const int check[][3] = {
+        {0,  30, 30},
+        {5,  40, 30},
+        {-5, 40, 30},
+    };
+    ReplayResult_t result;
+    int pass = 1;
+
+    if (argc < 2) {
+        printf("usage: %s <trace> [counter gain error %%] [-v]\n", argv[0]);
+        return 1;
+    }
+    if (argc > 2) {
+        int verbose = (argc > 3) && (0 == strcmp(argv[3], "-v"));
+        if (0 != replay(argv[1], atoi(argv[2]), verbose, &result)) {
+            perror(argv[1]);
+            return 1;
+        }
+        printf("max error under load %d, after rest %d, final %d (0.1%%)\n", result.max_load_error,
+               result.max_rest_error, result.final_error);
+        return 0;
+    }
+
+    for (size_t i = 0; i < sizeof(check) / sizeof(check[0]); i++) {
+        if (0 != replay(argv[1], check[i][0], 0, &result)) {
+            perror(argv[1]);
+            return 1;
+        }
+        int ok = (result.max_load_error <= check[i][1]) && (result.max_rest_error <= check[i][2]) &&
+                 (result.final_error <= check[i][2]);
+        printf("counter gain %+d%%: max error under load %3d (<= %3d), after rest %3d, final %3d (<= %3d)  %s\n",
+               check[i][0], result.max_load_error, check[i][1], result.max_rest_error, result.final_error,
+               check[i][2], ok ? "PASS" : "FAIL");
+        pass &= ok;
+    }
+    printf("%s\n", pass ? "all passed" : "FAILED");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""Battery trace generator for the AXP192 fuel gauge replay test.
+
+Simulates a cell that does not match the fuel gauge configuration of
+fuel_gauge_replay.c: its own OCV curve, a larger internal resistance, a
+polarization branch that relaxes over minutes, an idle load during the rests,
+and measurement noise quantized to the AXP192 ADC steps. The trace is written
+with a fixed seed, so it is reproducible.
+
+    python3 gen_fuel_gauge_trace.py > fuel_gauge_trace.txt
+"""
+
+import random
+
+CAPACITY_MAH = 1000
+SAMPLE_S = 10
+
+# OCV curve of the simulated cell, soc(%) and mV. It differs from the default
+# curve of axp192_fuel_gauge.c by -10 ~ +20 mV and has more points.
+OCV_CURVE = [
+    (0, 3380), (5, 3540), (10, 3640), (15, 3690), (20, 3718), (25, 3731),
+    (30, 3742), (35, 3753), (40, 3768), (45, 3781), (50, 3798), (55, 3820),
+    (60, 3846), (65, 3874), (70, 3905), (75, 3938), (80, 3978), (85, 4030),
+    (90, 4085), (95, 4128), (100, 4170),
+]
+R0_OHM = 0.21               # Ohmic resistance, the fuel gauge assumes 0.15.
+R1_OHM = 0.06               # Polarization branch, not modelled by the fuel gauge.
+TAU_S = 90.0
+IDLE_MA = -8                # Load left during the rests.
+VOL_NOISE_MV = 3.0
+VOL_LSB_MV = 1.1            # AXP192 battery voltage ADC step.
+CUR_NOISE_MA = 5.0
+CUR_LSB_MA = 0.5            # AXP192 battery current ADC step.
+
+# (comment, current mA, duration s), a discharge stops early when the cell is empty.
+PROFILE = [
+    ("rest, full", IDLE_MA, 120),
+    ("discharge 400 mA", -400, 3600),
+    ("rest", IDLE_MA, 600),
+    ("discharge 800 mA", -800, 1800),
+    ("rest", IDLE_MA, 600),
+    ("discharge 300 mA, runs empty", -300, 3000),
+    ("rest, empty", 0, 300),
+    ("charge 500 mA", 500, 3600),
+    ("rest", IDLE_MA, 600),
+]
+
+
+def ocv(soc):
+    """Open circuit voltage of a state of charge in %, linear between the curve points."""
+    for (s0, v0), (s1, v1) in zip(OCV_CURVE, OCV_CURVE[1:]):
+        if soc <= s1:
+            return v0 + (v1 - v0) * (max(soc, s0) - s0) / (s1 - s0)
+    return OCV_CURVE[-1][1]
+
+
+def quantize(value, lsb):
+    return round(round(value / lsb) * lsb)
+
+
+def main():
+    rng = random.Random(1)
+    soc = 100.0                 # %
+    v1 = 0.0                    # Polarization voltage, mV.
+    t = 0
+
+    print("# AXP192 fuel gauge replay trace, written by gen_fuel_gauge_trace.py.")
+    print("# Cell model: %d mAh, R0 %d mOhm, R1 %d mOhm / %d s, its own OCV curve, "
+          "%d mA idle load at rest," % (CAPACITY_MAH, R0_OHM * 1000, R1_OHM * 1000, TAU_S, -IDLE_MA))
+    print("# voltage noise %.0f mV, current noise %.0f mA, %d s samples."
+          % (VOL_NOISE_MV, CUR_NOISE_MA, SAMPLE_S))
+    print("# Columns: time_s battery_mV current_mA(positive while charging) true_soc(0.1%)")
+    for comment, current, duration in PROFILE:
+        print("# " + comment)
+        for _ in range(duration):
+            if current < 0 and soc <= 0:
+                current = 0
+            # One second steps, the sample is taken at the end of each period.
+            soc = min(100.0, max(0.0, soc + current / 3600.0 / CAPACITY_MAH * 100))
+            v1 += (current * R1_OHM - v1) / TAU_S
+            t += 1
+            if t % SAMPLE_S:
+                continue
+            vol = ocv(soc) + current * R0_OHM + v1 + rng.gauss(0, VOL_NOISE_MV)
+            cur = current + rng.gauss(0, CUR_NOISE_MA)
+            print("%d %d %d %d" % (t, quantize(vol, VOL_LSB_MV), quantize(cur, CUR_LSB_MA),
+                                   round(soc * 10)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,74 @@
+/*
+ * BM8563 alarm and BCD encoding test for a Linux host.
+ *
+ *     gcc -O2 -Wall -I../../../../../components/I2C_device/bm8563/include \
+ *         alarm_encode_test.c ../../../../../components/I2C_device/bm8563/bm8563_codec.c \
+ *         -o alarm_encode_test
+ *     ./alarm_encode_test
+ *
+ * Register order: minute, hour, day, weekday. A field left at BM8563_ALARM_ANY is written 
+ * with only the AE bit set, which takes it out of the match.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "bm8563_codec.h"
+
+#define ANY     BM8563_ALARM_ANY
+#define AE      BM8563_ALARM_AE_BIT
+
+typedef struct{
+    const char *name;
+    BM8563_Alarm_t alarm;
+    int ret;                        // Expected return value.
+    uint8_t reg[4];                 // Expected register values when ret is 0.
+}AlarmCase_t;
+
+static const AlarmCase_t alarm_case[] = {
+    {"minute only",             {30, ANY, ANY, ANY},    0,  {0x30, AE, AE, AE}},
+    {"hour only",               {ANY, 7, ANY, ANY},     0,  {AE, 0x07, AE, AE}},
+    {"day only",                {ANY, ANY, 15, ANY},    0,  {AE, AE, 0x15, AE}},
+    {"weekday only",            {ANY, ANY, ANY, 6},     0,  {AE, AE, AE, 0x06}},
+    {"every field",             {59, 23, 31, 0},        0,  {0x59, 0x23, 0x31, 0x00}},
+    {"lowest values",           {0, 0, 1, 0},           0,  {0x00, 0x00, 0x01, 0x00}},
+    {"hour and minute",         {45, 12, ANY, ANY},     0,  {0x45, 0x12, AE, AE}},
+    {"no field to match",       {ANY, ANY, ANY, ANY},   -1, {0}},
+    {"minute 60",               {60, ANY, ANY, ANY},    -1, {0}},
+    {"hour 24",                 {ANY, 24, ANY, ANY},    -1, {0}},
+    {"day 0",                   {ANY, ANY, 0, ANY},     -1, {0}},
+    {"day 32",                  {ANY, ANY, 32, ANY},    -1, {0}},
+    {"weekday 7",               {ANY, ANY, ANY, 7},     -1, {0}},
+};
+
+int main(void)
+{
+    int pass = 1;
+
+    // BCD round trip of every register value, and the invalid codes.
+    int bcd_ok = 1;
+    for (uint32_t i = 0; i < 100; i++) {
+        uint8_t bcd = BM8563_HexToBcd(i);
+        bcd_ok &= (bcd == (((i / 10) << 4) | (i % 10))) && (BM8563_BcdToHex(bcd) == i);
+    }
+    for (uint32_t bcd = 0; bcd < 256; bcd++) {
+        if (((bcd & 0x0F) > 9) || (bcd > 0x99)) {
+            bcd_ok &= (0xFF == BM8563_BcdToHex(bcd));
+        }
+    }
+    bcd_ok &= (0x00 == BM8563_HexToBcd(100));
+    printf("%-20s %s\n", "bcd round trip", bcd_ok ? "PASS" : "FAIL");
+    pass &= bcd_ok;
+
+    for (size_t c = 0; c < sizeof(alarm_case) / sizeof(alarm_case[0]); c++) {
+        const AlarmCase_t *test = &alarm_case[c];
+        uint8_t reg[4] = {0};
+        int ret = BM8563_AlarmEncode(&test->alarm, reg);
+        int ok = (ret == test->ret) && ((0 != ret) || (0 == memcmp(reg, test->reg, sizeof(reg))));
+
+        printf("%-20s ret %2d  reg %02x %02x %02x %02x  %s\n", test->name, ret, reg[0], reg[1], reg[2], reg[3],
+               ok ? "PASS" : "FAIL");
+        pass &= ok;
+    }
+    printf("%s\n", pass ? "all passed" : "FAILED");
+    return pass ? 0 : 1;
+}
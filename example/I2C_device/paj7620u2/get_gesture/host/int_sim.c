@@ -0,0 +1,409 @@
+/*
+ * PAJ7620U2 gesture interrupt test for a Linux host.
+ *
+ * Builds the real driver against the headers in this directory and a simulated sensor. The
+ * simulated INT line is active low: it falls when a gesture flag is set and rises when the
+ * flag registers are read, and a falling edge calls the registered ISR, as the GPIO does.
+ *
+ *     gcc -O2 -Wall -pthread -I. -I../../../../../components/I2C_device/paj7620u2/include \
+ *         -I../../../../../components/I2C_device/i2c_master/include \
+ *         int_sim.c ../../../../../components/I2C_device/paj7620u2/paj7620u2_driver.c \
+ *         ../../../../../components/I2C_device/i2c_master/i2c_master_int.c -o int_sim
+ *     ./int_sim
+ *
+ * Cases:
+ *     enable race    a gesture lands after the flags were last read but before the ISR is added.
+ *     read failure   the first flag reads fail while INT is low.
+ *     steady         one gesture after the interrupt is enabled.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "paj7620u2_driver.h"
+#include "paj7620u2_reg.h"
+
+#define INT_PIN     4
+#define WAIT_MS     500
+
+/* ---------------- tasks and queues ---------------- */
+
+struct HostTask {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t notify;
+    TaskFunction_t fn;
+    void *arg;
+};
+
+struct HostQueue {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint8_t *items;
+    UBaseType_t len;
+    UBaseType_t item_size;
+    UBaseType_t head;
+    UBaseType_t count;
+};
+
+static __thread struct HostTask *current_task;
+
+static void deadline_after(struct timespec *ts, TickType_t ms)
+{
+    clock_gettime(CLOCK_REALTIME, ts);
+    ts->tv_sec += ms / 1000;
+    ts->tv_nsec += (long)(ms % 1000) * 1000000;
+    if (ts->tv_nsec >= 1000000000) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000;
+    }
+}
+
+static void *task_entry(void *arg)
+{
+    current_task = arg;
+    current_task->fn(current_task->arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg, UBaseType_t prio,
+                       TaskHandle_t *task)
+{
+    struct HostTask *t = calloc(1, sizeof(*t));
+
+    (void)name, (void)stack, (void)prio;
+    pthread_mutex_init(&t->lock, NULL);
+    pthread_cond_init(&t->cond, NULL);
+    t->fn = fn;
+    t->arg = arg;
+    *task = t;
+    pthread_create(&t->thread, NULL, task_entry, t);
+    pthread_detach(t->thread);
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    (void)task;
+    pthread_exit(NULL);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    usleep(ticks * 1000);
+}
+
+void vTaskDelayUntil(TickType_t *last_wake, TickType_t ticks)
+{
+    *last_wake += ticks;
+    vTaskDelay(ticks);
+}
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(esp_timer_get_time() / 1000);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks)
+{
+    struct HostTask *t = current_task;
+    struct timespec ts;
+    uint32_t value;
+
+    deadline_after(&ts, ticks);
+    pthread_mutex_lock(&t->lock);
+    while (0 == t->notify) {
+        if (portMAX_DELAY == ticks) {
+            pthread_cond_wait(&t->cond, &t->lock);
+        } else if (ETIMEDOUT == pthread_cond_timedwait(&t->cond, &t->lock, &ts)) {
+            break;
+        }
+    }
+    value = t->notify;
+    t->notify = clear ? 0 : (value ? value - 1 : 0);
+    pthread_mutex_unlock(&t->lock);
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    pthread_mutex_lock(&task->lock);
+    task->notify++;
+    pthread_cond_signal(&task->cond);
+    pthread_mutex_unlock(&task->lock);
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken)
+{
+    xTaskNotifyGive(task);
+    *woken = pdTRUE;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t len, UBaseType_t item_size)
+{
+    struct HostQueue *q = calloc(1, sizeof(*q));
+
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->cond, NULL);
+    q->items = calloc(len, item_size);
+    q->len = len;
+    q->item_size = item_size;
+    return q;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    free(queue->items);
+    free(queue);
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks)
+{
+    BaseType_t ret = pdFALSE;
+
+    (void)ticks;
+    pthread_mutex_lock(&queue->lock);
+    if (queue->count < queue->len) {
+        memcpy(queue->items + ((queue->head + queue->count) % queue->len) * queue->item_size, item,
+               queue->item_size);
+        queue->count++;
+        pthread_cond_signal(&queue->cond);
+        ret = pdTRUE;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return ret;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks)
+{
+    struct timespec ts;
+    BaseType_t ret = pdFALSE;
+
+    deadline_after(&ts, ticks);
+    pthread_mutex_lock(&queue->lock);
+    while (0 == queue->count) {
+        if (ETIMEDOUT == pthread_cond_timedwait(&queue->cond, &queue->lock, &ts)) {
+            break;
+        }
+    }
+    if (queue->count) {
+        memcpy(item, queue->items + queue->head * queue->item_size, queue->item_size);
+        queue->head = (queue->head + 1) % queue->len;
+        queue->count--;
+        ret = pdTRUE;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return ret;
+}
+
+/* ---------------- simulated sensor ---------------- */
+
+static pthread_mutex_t sensor_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint16_t sensor_flags;           // Gesture flag registers 0x43/0x44.
+static int int_level = 1;               // INT line, active low.
+static int fail_reads;                  // Number of flag reads to fail.
+static int flag_reads;                  // Successful flag reads.
+static gpio_isr_t int_isr;
+static void *int_isr_arg;
+static void (*gpio_config_hook)(void);  // Runs inside gpio_config(), in the enable window.
+
+static void sensor_gesture(uint16_t gesture)
+{
+    gpio_isr_t isr = NULL;
+
+    pthread_mutex_lock(&sensor_lock);
+    sensor_flags |= gesture;
+    if (1 == int_level) {
+        int_level = 0;
+        isr = int_isr;
+    }
+    pthread_mutex_unlock(&sensor_lock);
+    // Falling edge.
+    if (NULL != isr) {
+        isr(int_isr_arg);
+    }
+}
+
+esp_err_t I2cMaster_ReadReg(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr, uint8_t reg_addr,
+                            uint8_t *data_buf, uint32_t data_len)
+{
+    esp_err_t ret = ESP_OK;
+
+    (void)i2c_handle, (void)i2c_addr;
+    memset(data_buf, 0, data_len);
+    pthread_mutex_lock(&sensor_lock);
+    if (PAJ7620U2_STATUS_REG == reg_addr) {
+        data_buf[0] = 0x20;
+    } else if (PAJ7620U2_GET_INT_FLAG1 == reg_addr) {
+        if (fail_reads > 0) {
+            fail_reads--;
+            ret = ESP_FAIL;
+        } else {
+            data_buf[0] = sensor_flags & 0xFF;
+            if (data_len > 1) {
+                data_buf[1] = sensor_flags >> 8;
+            }
+            sensor_flags = 0;
+            int_level = 1;
+            flag_reads++;
+        }
+    }
+    pthread_mutex_unlock(&sensor_lock);
+    return ret;
+}
+
+esp_err_t I2cMaster_WriteReg(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr, uint8_t reg_addr,
+                             uint8_t *data_buf, uint32_t data_len)
+{
+    (void)i2c_handle, (void)i2c_addr, (void)reg_addr, (void)data_buf, (void)data_len;
+    return ESP_OK;
+}
+
+esp_err_t I2cMaster_WriteRegTable(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr, const uint8_t *table,
+                                  uint32_t table_len)
+{
+    (void)i2c_handle, (void)i2c_addr, (void)table, (void)table_len;
+    return ESP_OK;
+}
+
+bool I2CMaster_CheckDeviceAlive(I2cMaster_handle_t i2c_handle, uint8_t i2c_addr)
+{
+    (void)i2c_handle, (void)i2c_addr;
+    return true;
+}
+
+i2c_cmd_handle_t i2c_cmd_link_create(void) { return (i2c_cmd_handle_t)1; }
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd) { (void)cmd; }
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd) { (void)cmd; return ESP_OK; }
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd) { (void)cmd; return ESP_OK; }
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd, uint8_t data, bool ack) { (void)cmd, (void)data, (void)ack; return ESP_OK; }
+esp_err_t i2c_master_cmd_begin(i2c_port_t port, i2c_cmd_handle_t cmd, TickType_t ticks) { (void)port, (void)cmd, (void)ticks; return ESP_OK; }
+
+esp_err_t gpio_config(const gpio_config_t *config)
+{
+    (void)config;
+    if (NULL != gpio_config_hook) {
+        gpio_config_hook();
+    }
+    return ESP_OK;
+}
+
+esp_err_t gpio_install_isr_service(int flags)
+{
+    (void)flags;
+    return ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t pin, gpio_isr_t isr, void *arg)
+{
+    (void)pin;
+    pthread_mutex_lock(&sensor_lock);
+    int_isr = isr;
+    int_isr_arg = arg;
+    pthread_mutex_unlock(&sensor_lock);
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t pin)
+{
+    (void)pin;
+    pthread_mutex_lock(&sensor_lock);
+    int_isr = NULL;
+    pthread_mutex_unlock(&sensor_lock);
+    return ESP_OK;
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t pin)
+{
+    (void)pin;
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t pin)
+{
+    int level;
+
+    if (INT_PIN != pin) {
+        printf("  gpio_get_level() on pin %d\n", pin);
+        exit(1);
+    }
+    pthread_mutex_lock(&sensor_lock);
+    level = int_level;
+    pthread_mutex_unlock(&sensor_lock);
+    return level;
+}
+
+/* ---------------- cases ---------------- */
+
+static void gesture_up(void)
+{
+    sensor_gesture(PAJ7620U2_GESTURE_UP);
+}
+
+static int expect_gesture(PAJ7620U2_handle_t paj, uint16_t gesture)
+{
+    PAJ7620U2_GestureEvent_t event;
+    int pass = (ESP_OK == PAJ7620U2_GestureWaitEvent(paj, &event, pdMS_TO_TICKS(WAIT_MS))) &&
+               (gesture == event.gesture);
+
+    // Let the worker finish its level check before looking at the line.
+    vTaskDelay(pdMS_TO_TICKS(20));
+    pass = pass && (1 == gpio_get_level(INT_PIN));
+    printf("  gesture 0x%03x %s, INT %s\n", gesture, pass ? "received" : "missing",
+           gpio_get_level(INT_PIN) ? "high" : "stuck low");
+    return pass;
+}
+
+static int run_case(const char *name, void (*hook)(void), int fails, uint16_t gesture)
+{
+    static I2cMaster_t i2c = {.i2c_port = 0, .i2c_clk = 400000};
+    int pass;
+
+    printf("%s\n", name);
+    sensor_flags = 0;
+    int_level = 1;
+    fail_reads = 0;
+    PAJ7620U2_handle_t paj = PAJ7620U2_Init(&i2c, 0x73);
+    if ((NULL == paj) || (ESP_OK != PAJ7620U2_GestureInit(paj))) {
+        return 0;
+    }
+    gpio_config_hook = hook;
+    if (ESP_OK != PAJ7620U2_GestureIntrEnable(paj, INT_PIN, 5)) {
+        return 0;
+    }
+    gpio_config_hook = NULL;
+    if (NULL == hook) {
+        pthread_mutex_lock(&sensor_lock);
+        fail_reads = fails;
+        pthread_mutex_unlock(&sensor_lock);
+        sensor_gesture(gesture);
+    }
+    pass = expect_gesture(paj, gesture);
+    PAJ7620U2_Deinit(&paj);
+    printf("  %s\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+int main(void)
+{
+    int pass = 1;
+
+    pass &= run_case("enable race", gesture_up, 0, PAJ7620U2_GESTURE_UP);
+    pass &= run_case("read failure", NULL, 2, PAJ7620U2_GESTURE_LEFT);
+    pass &= run_case("steady", NULL, 0, PAJ7620U2_GESTURE_WAVE);
+    printf("%s\n", pass ? "all passed" : "FAILED");
+    return pass ? 0 : 1;
+}
@@ -4,20 +4,62 @@
 #include "freertos/task.h"
 #include "esp_system.h"
 #include "esp_spi_flash.h"
+#include "esp_timer.h"
 
 #include "i2c_master.h"
 #include "paj7620u2_driver.h"
+#include "paj7620u2_reg.h"
 
 #define PAJ_ADDR     0x73
 
+/**
+  * @brief  Write a register burst table one register per transaction, as before the burst tables.
+  * @param[in]  i2c_handle  i2c master operation handle.
+  * @param[in]  reg_table  burst table, {start register address, data length, data...}.
+  * @param[in]  table_len  burst table length(byte).
+  * @retval  reference esp_err_t.
+  */
+static esp_err_t write_table_per_reg(I2cMaster_handle_t i2c_handle, const uint8_t *reg_table, uint32_t table_len)
+{
+    esp_err_t err = ESP_OK;
+    uint8_t data = 0;
+
+    for (uint32_t i=0; i+1<table_len; i+=2+reg_table[i+1]) {
+        for (uint8_t j=0; j<reg_table[i+1]; j++) {
+            data = reg_table[i+2+j];
+            err = I2cMaster_WriteReg(i2c_handle, PAJ_ADDR, reg_table[i]+j, &data, 1);
+            if (ESP_OK != err) {
+                return err;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
 void app_main(void)
 {
     uint16_t gesture_val;
+    int64_t start_time = 0, init_time = 0, gesture_time = 0, per_reg_time = 0;
 
     I2cMaster_handle_t i2c_0 = I2cMaster_Init(I2C_NUM_0, 22, 21, 400000);
+    start_time = esp_timer_get_time();
     PAJ7620U2_handle_t paj = PAJ7620U2_Init(i2c_0, PAJ_ADDR);
+    init_time = esp_timer_get_time() - start_time;
+    if(NULL == paj){
+        printf("paj7620u2 init failed.");
+        return;
+    }
 
+    start_time = esp_timer_get_time();
     PAJ7620U2_GestureInit(paj);
+    gesture_time = esp_timer_get_time() - start_time;
+    // Same values again, so the sensor state does not change.
+    start_time = esp_timer_get_time();
+    write_table_per_reg(i2c_0, gesture_table, sizeof(gesture_table));
+    per_reg_time = esp_timer_get_time() - start_time;
+    // Init includes the two 10ms wake up delays.
+    printf("paj7620u2 init: %lld us, gesture init: %lld us, gesture table one register per write: %lld us\n", 
+           init_time, gesture_time, per_reg_time);
 
     while(1){
         PAJ7620U2_GestureGetState(paj, &gesture_val);
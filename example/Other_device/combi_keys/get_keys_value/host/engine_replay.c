@@ -0,0 +1,133 @@
+/*
+ * Combi keys engine replay test for a Linux host.
+ *
+ * Replays debounced key states through the same engine the ESP32 driver runs and prints 
+ * every event. Deadlines are handled in between the input lines, the way the driver timer does.
+ * With an expected output file the printed events are compared with it line by line.
+ *
+ *     gcc -O2 -Wall -I../../../../../components/Other_device/combi_keys/include \
+ *         engine_replay.c ../../../../../components/Other_device/combi_keys/combi_keys_engine.c \
+ *         -o engine_replay
+ *     ./engine_replay engine_trace.txt engine_trace.expected
+ *
+ * Trace lines: time_ms key_mask(hex, bit n set while key n is pressed). 
+ * Lines starting with # are echoed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "combi_keys_engine.h"
+
+static const char *event_name[COMBI_KEY_EVENT_MAX] = {
+    "press", "release", "short", "long", "repeat", "double", "chord", "sequence",
+};
+
+// Chords and sequences of the trace.
+static const CombiKey_Chord_t chord_table[] = {
+    {0x5, 1},                       // key0 + key2.
+    {0x7, 2},                       // key0 + key1 + key2.
+};
+static const CombiKey_Mask_t sequence_0[] = {0x1, 0x1, 0x4};
+static const CombiKey_Mask_t sequence_1[] = {0x2, 0x5};
+static const CombiKey_Sequence_t sequence_table[] = {
+    {sequence_0, 3, 10},
+    {sequence_1, 2, 11},
+};
+
+static FILE *expected;
+static int line_num;
+static int mismatch;
+
+// Print a line, and compare it with the next expected line.
+static void output(const char *line)
+{
+    char expect[160];
+
+    fputs(line, stdout);
+    if (NULL == expected) {
+        return;
+    }
+    line_num++;
+    if ((NULL == fgets(expect, sizeof(expect), expected)) || (0 != strcmp(expect, line))) {
+        printf("^^^ line %d differs, expected: %s", line_num, feof(expected) ? "end of file\n" : expect);
+        mismatch++;
+    }
+}
+
+static void emit(const CombiKey_Event_t *event, void *arg)
+{
+    char line[160];
+
+    (void)arg;
+    snprintf(line, sizeof(line), "  %6lld %-8s key%u mask=%x id=%u count=%u\n", (long long)event->time_us / 1000,
+             event_name[event->type], event->key, (unsigned)event->mask, event->id, event->count);
+    output(line);
+}
+
+// Handle every deadline up to now, in order.
+static void run_until(CombiKey_Engine_t *engine, int64_t now)
+{
+    int64_t deadline;
+
+    while ((0 != (deadline = CombiKeys_EngineNextDeadline(engine))) && (deadline <= now)) {
+        CombiKeys_EngineTick(engine, deadline);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    CombiKey_Engine_t engine;
+    char line[160];
+    long long time_ms;
+    unsigned mask;
+
+    if (argc < 2) {
+        printf("usage: %s <trace> [expected output]\n", argv[0]);
+        return 1;
+    }
+    FILE *trace = fopen(argv[1], "r");
+    if (NULL == trace) {
+        perror(argv[1]);
+        return 1;
+    }
+    if ((argc > 2) && (NULL == (expected = fopen(argv[2], "r")))) {
+        perror(argv[2]);
+        return 1;
+    }
+
+    CombiKeys_EngineInit(&engine, emit, NULL);
+    engine.long_press_time = 1000;
+    engine.repeat_time = 400;
+    engine.repeat_accel = 30;
+    engine.repeat_min_time = 100;
+    engine.double_click_time = 250;
+    engine.chord_table = chord_table;
+    engine.chord_num = sizeof(chord_table) / sizeof(chord_table[0]);
+    engine.sequence_table = sequence_table;
+    engine.sequence_num = sizeof(sequence_table) / sizeof(sequence_table[0]);
+
+    while (NULL != fgets(line, sizeof(line), trace)) {
+        if ('#' == line[0]) {
+            output(line);
+            continue;
+        }
+        if (2 != sscanf(line, "%lld %x", &time_ms, &mask)) {
+            continue;
+        }
+        run_until(&engine, time_ms * 1000);
+        CombiKeys_EngineUpdate(&engine, mask, time_ms * 1000);
+    }
+    run_until(&engine, INT64_MAX);
+    fclose(trace);
+
+    if (NULL != expected) {
+        if (NULL != fgets(line, sizeof(line), expected)) {
+            printf("^^^ expected output continues: %s", line);
+            mismatch++;
+        }
+        fclose(expected);
+        printf("%s\n", (0 == mismatch) ? "PASS" : "FAIL");
+    }
+    return (0 == mismatch) ? 0 : 1;
+}
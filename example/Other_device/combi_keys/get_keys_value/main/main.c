@@ -7,55 +7,47 @@
 #include "esp_system.h"
 #include "esp_spi_flash.h"
 #include "driver/gpio.h"
-#include "driver/rmt.h"
 
 #include "combi_keys_driver.h"
 
+#define KEY_UP      (1 << COMBI_KEY_UP)
+#define KEY_MID     (1 << COMBI_KEY_MID)
+#define KEY_DOWN    (1 << COMBI_KEY_DOWN)
+
+static const char *event_name[COMBI_KEY_EVENT_MAX] = {
+    "press", "release", "short press", "long press", "repeat", "double click", "chord", "sequence",
+};
+
+// Up and down together, and all three keys together.
+static const CombiKey_Chord_t chord_table[] = {
+    {KEY_UP | KEY_DOWN, 1},
+    {KEY_UP | KEY_MID | KEY_DOWN, 2},
+};
+
+// Up up down down, then mid.
+static const CombiKey_Mask_t unlock_steps[] = {KEY_UP, KEY_UP, KEY_DOWN, KEY_DOWN, KEY_MID};
+static const CombiKey_Sequence_t sequence_table[] = {
+    {unlock_steps, sizeof(unlock_steps) / sizeof(unlock_steps[0]), 1},
+};
+
 void app_main(void)
 {
-    CombiKey_Value_t key_value = 0;
+    CombiKey_Event_t event;
 
     CombiKey_handle_t keys = CombiKeys_Init(36, 37, 38);
 
     CombiKeys_SetLongPress(keys, 1000);
+    // Repeat every 200ms at first, 20% faster each time down to 50ms.
+    CombiKeys_SetRepeat(keys, 200);
+    CombiKeys_SetRepeatAccel(keys, 20, 50);
+    CombiKeys_SetDoubleClick(keys, 300);
+    CombiKeys_SetChords(keys, chord_table, sizeof(chord_table) / sizeof(chord_table[0]), 50);
+    CombiKeys_SetSequences(keys, sequence_table, sizeof(sequence_table) / sizeof(sequence_table[0]), 1000);
 
+    // The task sleeps until a debounced key event arrives.
     while(1){
-        key_value = CombiKeys_GetValue(keys);
-        switch(key_value){
-            case COMBI_KEY_UP_VALUE_PRESS: 
-                printf("key up press.\n");
-                break;
-            case COMBI_KEY_UP_VALUE_SHORT_PRESS: 
-                printf("key up short press.\n");
-                break;
-            case COMBI_KEY_UP_VALUE_LONG_PRESS: 
-                printf("key up long press.\n");
-                break;
-            case COMBI_KEY_MID_VALUE_PRESS: 
-                printf("key mid press.\n");
-                break;
-            case COMBI_KEY_MID_VALUE_SHORT_PRESS: 
-                printf("key mid short press.\n");
-                break;
-            case COMBI_KEY_MID_VALUE_LONG_PRESS: 
-                printf("key mid long press.\n");
-                break;
-            case COMBI_KEY_DOUN_VALUE_PRESS: 
-                printf("key down press.\n");
-                break;
-            case COMBI_KEY_DOUN_VALUE_SHORT_PRESS: 
-                printf("key down short press.\n");
-                break;
-            case COMBI_KEY_DOUN_VALUE_LONG_PRESS: 
-                printf("key down long press.\n");
-                break;
-            default :
-                printf("no keys press.\n");
-                break;
+        if(ESP_OK == CombiKeys_WaitEvent(keys, &event, portMAX_DELAY)){
+            printf("keys 0x%x %s, id %d, count %d.\n", (unsigned int)event.mask, event_name[event.type], event.id, event.count);
         }
-        vTaskDelay(50 / portTICK_PERIOD_MS);
-        printf("running......\n");
     }
 }
-
-
@@ -0,0 +1,270 @@
+/*
+ * Audio spectrum test for a Linux host.
+ *
+ * Writes test signals as 16 kHz 16 bit mono WAV files, reads them back through the analyzer
+ * with the configuration of the Music_beating example and checks the final band levels, both
+ * against expected ranges and against a floating point DFT of the same blocks.
+ * Other WAV files(16 bit mono PCM) given on the command line are only analyzed and printed.
+ *
+ *     gcc -O2 -Wall -I../../../../../components/Other_device/audio_spectrum/include \
+ *         spectrum_test.c ../../../../../components/Other_device/audio_spectrum/audio_spectrum.c \
+ *         -lm -o spectrum_test
+ *     ./spectrum_test                 # writes the WAV files to the current directory
+ *     ./spectrum_test music.wav
+ *
+ * Bands: bass 60~307 Hz, middle 307~1566 Hz, treble 1566~8000 Hz.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "audio_spectrum.h"
+
+#define SAMPLE_RATE     16000
+#define FFT_N           256
+#define BAND_NUM        3
+#define WAV_SAMPLES     SAMPLE_RATE             // 1 s.
+#define KICK_PERIOD     (SAMPLE_RATE / 2)       // 120 bpm.
+#define REF_TOLERANCE   4                       // Allowed level difference to the float reference.
+
+typedef enum{
+    SIGNAL_TONE,
+    SIGNAL_NOISE,
+    SIGNAL_KICK,
+}SignalType_t;
+
+typedef struct{
+    const char *name;
+    SignalType_t type;
+    double freq;                    // Hz, tone.
+    double db;                      // dB relative to full scale.
+    uint8_t level_min[BAND_NUM];    // Expected band levels after the last block.
+    uint8_t level_max[BAND_NUM];
+}TestCase_t;
+
+// A 100 Hz tone is 1.6 bins at 256 points. Its Hann leakage is about 41 dB down at bin 5, the 
+// first bin of the middle band, and about 37 dB summed over the band, level 60 of the 48 dB range.
+static const TestCase_t test_case[] = {
+    {"tone100.wav",    SIGNAL_TONE,  100,  0,   {250,  40,   0}, {255,  65,  40}},
+    {"tone1k.wav",     SIGNAL_TONE,  1000, 0,   {  0, 250,   0}, { 40, 255,  40}},
+    {"tone1k_m20.wav", SIGNAL_TONE,  1000, -20, {  0, 130,   0}, { 20, 190,  20}},
+    {"tone5k.wav",     SIGNAL_TONE,  5000, 0,   {  0,   0, 250}, { 40,  40, 255}},
+    {"noise.wav",      SIGNAL_NOISE, 0,    -12, {110, 140, 170}, {180, 205, 235}},
+    {"silence.wav",    SIGNAL_TONE,  0,    -200,{  0,   0,   0}, {  0,   0,   0}},
+    {"kick.wav",       SIGNAL_KICK,  60,   0,   { 20,   0,   0}, { 80,  40,  20}},
+};
+
+static int16_t pcm[WAV_SAMPLES * 4];
+
+static void put_le(uint8_t *p, uint32_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        p[i] = (v >> (8 * i)) & 0xFF;
+    }
+}
+
+static int wav_write(const char *name, const int16_t *samples, uint32_t num)
+{
+    uint8_t h[44] = "RIFF____WAVEfmt ";
+
+    put_le(h + 4, 36 + num * 2, 4);
+    put_le(h + 16, 16, 4);
+    put_le(h + 20, 1, 2);               // PCM.
+    put_le(h + 22, 1, 2);               // Mono.
+    put_le(h + 24, SAMPLE_RATE, 4);
+    put_le(h + 28, SAMPLE_RATE * 2, 4);
+    put_le(h + 32, 2, 2);
+    put_le(h + 34, 16, 2);
+    memcpy(h + 36, "data", 4);
+    put_le(h + 40, num * 2, 4);
+    FILE *f = fopen(name, "wb");
+    if (NULL == f) {
+        return -1;
+    }
+    fwrite(h, 1, sizeof(h), f);
+    fwrite(samples, 2, num, f);
+    fclose(f);
+    return 0;
+}
+
+// Minimal 16 bit mono PCM reader, the data chunk is expected right after the fmt chunk.
+static int wav_read(const char *name, int16_t *samples, uint32_t max, uint32_t *rate)
+{
+    uint8_t h[44];
+
+    FILE *f = fopen(name, "rb");
+    if (NULL == f) {
+        return -1;
+    }
+    if (sizeof(h) != fread(h, 1, sizeof(h), f) || memcmp(h, "RIFF", 4) || memcmp(h + 8, "WAVE", 4) ||
+        1 != (h[22] | h[23] << 8) || 16 != (h[34] | h[35] << 8)) {
+        fclose(f);
+        return -1;
+    }
+    *rate = h[24] | h[25] << 8 | h[26] << 16 | (uint32_t)h[27] << 24;
+    int num = (int)fread(samples, 2, max, f);
+    fclose(f);
+    return num;
+}
+
+static void make_signal(const TestCase_t *test, int16_t *samples, uint32_t num)
+{
+    double amp = 32767 * pow(10, test->db / 20);
+    uint32_t seed = 1;
+
+    for (uint32_t i = 0; i < num; i++) {
+        double t = (double)i / SAMPLE_RATE;
+        double v = 0;
+        if (SIGNAL_TONE == test->type) {
+            v = amp * sin(2 * M_PI * test->freq * t);
+        } else if (SIGNAL_NOISE == test->type) {
+            seed = seed * 1103515245 + 12345;
+            v = amp * (((seed >> 16) & 0x7FFF) / 16383.5 - 1);
+        } else {
+            // Decaying low sine at the start of every beat, 40 ms time constant.
+            double tk = (double)(i % KICK_PERIOD) / SAMPLE_RATE;
+            v = amp * exp(-tk / 0.04) * sin(2 * M_PI * test->freq * tk);
+        }
+        samples[i] = (int16_t)lrint(v);
+    }
+}
+
+static AudioSpectrum_Config_t make_config(uint32_t rate)
+{
+    AudioSpectrum_Config_t config = {
+        .fft_n = FFT_N,
+        .sample_rate = rate,
+        .band_num = BAND_NUM,
+        .freq_low = 60,
+        .freq_high = 8000,
+        .attack_ms = 10,
+        .decay_ms = 200,
+    };
+    return config;
+}
+
+// Floating point model of the analyzer: Hann window, 1/N DFT and the same band bins, level 
+// mapping and envelopes, without the fixed point scaling and the log2 approximation.
+static void reference(const int16_t *samples, int num, uint32_t rate, uint8_t *levels)
+{
+    AudioSpectrum_Config_t config = make_config(rate);
+    AudioSpectrum_handle_t spectrum = AudioSpectrum_Init(&config);
+    double block_ms = 1000.0 * FFT_N / rate;
+    double attack = 1 - exp(-block_ms / config.attack_ms);
+    double decay = 1 - exp(-block_ms / config.decay_ms);
+    double full_scale = pow(32767.0 / 4, 2);
+    double envelope[BAND_NUM] = {0};
+    double x[FFT_N];
+
+    if (NULL == spectrum) {
+        memset(levels, 0, BAND_NUM);
+        return;
+    }
+    for (int i = 0; i + FFT_N <= num; i += FFT_N) {
+        double mean = 0;
+        for (int j = 0; j < FFT_N; j++) {
+            mean += samples[i + j];
+        }
+        mean /= FFT_N;
+        for (int j = 0; j < FFT_N; j++) {
+            x[j] = (samples[i + j] - mean) * 0.5 * (1 - cos(2 * M_PI * j / FFT_N));
+        }
+        for (int b = 0; b < BAND_NUM; b++) {
+            double energy = 0;
+            for (int bin = spectrum->band_bin[b]; bin < spectrum->band_bin[b + 1]; bin++) {
+                double re = 0, im = 0;
+                for (int j = 0; j < FFT_N; j++) {
+                    re += x[j] * cos(2 * M_PI * bin * j / FFT_N);
+                    im -= x[j] * sin(2 * M_PI * bin * j / FFT_N);
+                }
+                energy += (re * re + im * im) / ((double)FFT_N * FFT_N);
+            }
+            double db = (energy > 0) ? 10 * log10(2 * energy / full_scale) : -1000;
+            double level = (db + AUDIO_SPECTRUM_RANGE_DB) * 255 / AUDIO_SPECTRUM_RANGE_DB;
+            level = (level < 0) ? 0 : ((level > 255) ? 255 : level);
+            envelope[b] += (level - envelope[b]) * ((level > envelope[b]) ? attack : decay);
+        }
+    }
+    for (int b = 0; b < BAND_NUM; b++) {
+        levels[b] = (uint8_t)lrint(envelope[b]);
+    }
+    AudioSpectrum_Deinit(&spectrum);
+}
+
+// Analyze a sample buffer, print the bass level every 4 blocks when trace is set.
+static void analyze(const int16_t *samples, int num, uint32_t rate, uint8_t *levels, int trace)
+{
+    AudioSpectrum_Config_t config = make_config(rate);
+    AudioSpectrum_handle_t spectrum = AudioSpectrum_Init(&config);
+    int block = 0;
+
+    if (NULL == spectrum) {
+        memset(levels, 0, BAND_NUM);
+        return;
+    }
+    for (int i = 0; i + FFT_N <= num; i += FFT_N) {
+        AudioSpectrum_Process(spectrum, samples + i);
+        if (trace && (0 == (++block % 4))) {
+            AudioSpectrum_GetLevels(spectrum, levels);
+            printf(" %3d", levels[0]);
+        }
+    }
+    AudioSpectrum_GetLevels(spectrum, levels);
+    AudioSpectrum_Deinit(&spectrum);
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t levels[BAND_NUM];
+    uint8_t ref[BAND_NUM];
+    uint32_t rate;
+    int pass = 1;
+
+    if (argc > 1) {
+        printf("%-24s %5s %5s %5s\n", "file", "bass", "mid", "treb");
+        for (int a = 1; a < argc; a++) {
+            int num = wav_read(argv[a], pcm, sizeof(pcm) / 2, &rate);
+            if (num < FFT_N) {
+                printf("%-24s not a 16 bit mono WAV file\n", argv[a]);
+                continue;
+            }
+            analyze(pcm, num, rate, levels, 0);
+            printf("%-24s %5d %5d %5d\n", argv[a], levels[0], levels[1], levels[2]);
+        }
+        return 0;
+    }
+
+    for (size_t c = 0; c < sizeof(test_case) / sizeof(test_case[0]); c++) {
+        const TestCase_t *test = &test_case[c];
+        int ok = 1;
+
+        make_signal(test, pcm, WAV_SAMPLES);
+        if (0 != wav_write(test->name, pcm, WAV_SAMPLES)) {
+            perror(test->name);
+            return 1;
+        }
+        memset(pcm, 0, sizeof(pcm));
+        int num = wav_read(test->name, pcm, sizeof(pcm) / 2, &rate);
+        if (SIGNAL_KICK == test->type) {
+            printf("%s bass every 64 ms:", test->name);
+        }
+        analyze(pcm, num, rate, levels, SIGNAL_KICK == test->type);
+        if (SIGNAL_KICK == test->type) {
+            printf("\n");
+        }
+        reference(pcm, num, rate, ref);
+        for (int b = 0; b < BAND_NUM; b++) {
+            ok &= (levels[b] >= test->level_min[b]) && (levels[b] <= test->level_max[b]);
+            ok &= abs(levels[b] - ref[b]) <= REF_TOLERANCE;
+        }
+        printf("%-16s levels %3d %3d %3d  float %3d %3d %3d  expected %3d~%3d %3d~%3d %3d~%3d  %s\n",
+               test->name, levels[0], levels[1], levels[2], ref[0], ref[1], ref[2],
+               test->level_min[0], test->level_max[0], test->level_min[1], test->level_max[1],
+               test->level_min[2], test->level_max[2], ok ? "PASS" : "FAIL");
+        pass &= ok;
+    }
+    printf("%s\n", pass ? "all passed" : "FAILED");
+    return pass ? 0 : 1;
+}
@@ -13,107 +13,124 @@
 #include "rgbled_driver.h"
 #include "rgbled_color.h"
 #include "rgbled_show.h"
+#include "rgbled_multi.h"
+#include "rgbled_engine.h"
+#include "audio_sampler.h"
+#include "audio_spectrum.h"
 
-uint8_t new_light_num = 0;
-uint8_t cur_light_num = 0;
+#define MIC_ADC_CHANNEL     ADC1_CHANNEL_6      // GPIO34.
+#define MIC_SAMPLE_RATE     16000
+#define MIC_FFT_N           256                 // 16 ms per block.
+#define MIC_BAND_NUM        3                   // One band per strip, bass, middle, treble.
+#define STRIP_LED_LEN       60
+#define STRIP_FPS           100
 
-static void MicCollectTask(void *pvParameter);
+// Band levels, written by the audio process task and read by the render tasks.
+static volatile uint8_t band_level[MIC_BAND_NUM];
+// Bar color, changed by app_main.
+static volatile uint32_t bar_color = 0xff00;
 
-void app_main(void)
+// Audio process task on core 1, one FFT per block.
+static void MicBlockCallback(const int16_t *block, uint16_t len, void *arg)
 {
-    RGBled_Color_t light_color = 0xff00;
-    uint8_t rgb_range = 0;
-    uint8_t color_loop = 20;
+    AudioSpectrum_handle_t spectrum = (AudioSpectrum_handle_t)arg;
+    uint8_t levels[MIC_BAND_NUM];
 
-    RGBled_handle_t rgbled = RGBled_Init(RGBLED_DEVICE_TYPE_WS2812, 27, 60, RMT_CHANNEL_0);
-    if(NULL == rgbled){
-        printf("rgbled init failed.");
+    AudioSpectrum_Process(spectrum, block);
+    AudioSpectrum_GetLevels(spectrum, levels);
+    for(uint8_t i=0; i<MIC_BAND_NUM; i++){
+        band_level[i] = levels[i];
     }
-    RGBled_handle_t rgbled_1 = RGBled_Init(RGBLED_DEVICE_TYPE_WS2812, 32, 60, RMT_CHANNEL_0);
-    RGBled_handle_t rgbled_2 = RGBled_Init(RGBLED_DEVICE_TYPE_WS2812, 33, 60, RMT_CHANNEL_0);
-
-    xTaskCreatePinnedToCore(MicCollectTask, "MicCollectTask", 4096*2, NULL, 0, NULL, 1);
-
-    while(1){  
-        color_loop--; 
-        if(color_loop == 0) {
-            rgb_range = rand()%9;
-            if(rgb_range == 0)
-                light_color = 0xFF0000;
-            else if(rgb_range == 1)
-                light_color = 0xFF8000;
-            else if(rgb_range == 2)
-                light_color = 0xFFFF00;
-            else if(rgb_range == 3)
-                light_color = 0x99FF00;
-            else if(rgb_range == 4)
-                light_color = 0x00FF00;
-            else if(rgb_range == 5)
-                light_color = 0x00FFB3;
-            else if(rgb_range == 6)
-                light_color = 0x00FFFF;
-            else if(rgb_range == 7)
-                light_color = 0x0000FF;
-            else if(rgb_range == 8)
-                light_color = 0x8000FF;
-            else
-                light_color = 0xFF0080;
-            color_loop = 100;    
-        }
-#if 0
-        if(cur_light_num < new_light_num){
-            RGBled_SetLenColor(rgbled, light_color, cur_light_num++);
-        }else if(cur_light_num > new_light_num){
-            RGBled_SetLenColor(rgbled, light_color, cur_light_num--);
-        }
-#elif 1
-        if(cur_light_num < new_light_num){
-            RGBled_SetLenColorMid(rgbled, light_color, cur_light_num++);
-            RGBled_SetLenColorMid(rgbled_1, light_color, cur_light_num-5);
-            RGBled_SetLenColorMid(rgbled_2, light_color, cur_light_num-5);
-        }else if(cur_light_num > new_light_num){
-            RGBled_SetLenColorMid(rgbled, light_color, cur_light_num--);
-            RGBled_SetLenColorMid(rgbled_1, light_color, cur_light_num-5);
-            RGBled_SetLenColorMid(rgbled_2, light_color, cur_light_num-5);
-        }
-            
-#endif 
-        vTaskDelay(10 / portTICK_PERIOD_MS);
-    } 
 }
 
-// 麦克风信号采集任务
-static void MicCollectTask(void *pvParameter)
+// Custom effect, a bar from the middle to the sides as long as the band level. effect->arg is the band.
+static void LevelBarRender(RGBled_Effect_t *effect, uint32_t *pixels, uint32_t led_len)
 {
-    uint16_t mic_val = 0;
-
-    adc1_config_width(ADC_WIDTH_BIT_12);
-    adc1_config_channel_atten(ADC1_CHANNEL_6, ADC_ATTEN_DB_11);
-    while(1){
-        vTaskDelay(30 / portTICK_PERIOD_MS);
-        mic_val = adc1_get_raw(ADC1_CHANNEL_6)-1500;
-        // printf("mic val = %d .\n", mic_val);
+    uint32_t band = (uint32_t)(uintptr_t)effect->arg;
+    uint32_t mid_num = led_len/2;
+    uint32_t led_half = band_level[band] * led_len / 255 / 2;
+    uint32_t color = bar_color;
 
-        // vTaskDelay(10 / portTICK_PERIOD_MS);
-        // mic_val = 0;
-        // for(uint8_t i=0; i<5; i++){
-        //     mic_val += adc1_get_raw(ADC1_CHANNEL_6)-1500;
-        //     vTaskDelay(20 / portTICK_PERIOD_MS);
-        // }
-        // mic_val /= 5;
-
-        if(mic_val > 2595 || mic_val <= 0){
-            new_light_num = 0;
-            continue;
-        }
-        new_light_num = (mic_val/((4095-1500)/60)*2) - 10;
-        if(new_light_num > 60){
-            new_light_num = 0;
-        }
-        // printf("light num = %d .\n", new_light_num);
+    if(led_half > mid_num){
+        led_half = mid_num;
+    }
+    for(uint32_t i=0; i<led_len; i++){
+        pixels[i] = (i >= mid_num-led_half && i < mid_num+led_half) ? color : 0x00;
     }
 }
 
+void app_main(void)
+{
+    uint8_t rgb_range = 0;
+    RGBled_EngineHandle_t engine[MIC_BAND_NUM];
 
+    // Each strip has its own RMT channel and 2 memory blocks, the frames are sent in parallel.
+    RGBled_StripConfig_t strip_config[] = {
+        {RGBLED_DEVICE_TYPE_WS2812, 27, STRIP_LED_LEN, RMT_CHANNEL_0, 2},
+        {RGBLED_DEVICE_TYPE_WS2812, 32, STRIP_LED_LEN, RMT_CHANNEL_2, 2},
+        {RGBLED_DEVICE_TYPE_WS2812, 33, STRIP_LED_LEN, RMT_CHANNEL_4, 2},
+    };
+    RGBled_MultiHandle_t strips = RGBled_MultiInit(strip_config, MIC_BAND_NUM);
+    if(NULL == strips){
+        printf("rgbled init failed.");
+        return;
+    }
+    // One engine per strip, the level bar on the bottom layer.
+    for(uint8_t i=0; i<MIC_BAND_NUM; i++){
+        engine[i] = RGBled_EngineInit(RGBled_MultiGetStrip(strips, i), STRIP_FPS, 5);
+        if(NULL == engine[i]){
+            printf("engine init failed.");
+            return;
+        }
+        RGBled_Effect_t level_bar = RGBled_EffectCustom(LevelBarRender, (void *)(uintptr_t)i);
+        RGBled_EngineSetLayer(engine[i], 0, &level_bar, RGBLED_BLEND_NORMAL, 0);
+    }
 
+    AudioSpectrum_Config_t spectrum_config = {
+        .fft_n = MIC_FFT_N,
+        .sample_rate = MIC_SAMPLE_RATE,
+        .band_num = MIC_BAND_NUM,
+        .freq_low = 60,
+        .freq_high = 8000,
+        .attack_ms = 10,
+        .decay_ms = 200,
+    };
+    AudioSpectrum_handle_t spectrum = AudioSpectrum_Init(&spectrum_config);
+    if(NULL == spectrum){
+        printf("spectrum init failed.");
+        return;
+    }
+    // Sampling and FFT on core 1 at priority 2 and 3, below the render tasks at 5.
+    AudioSampler_handle_t sampler = AudioSampler_Init(MIC_ADC_CHANNEL, MIC_SAMPLE_RATE, MIC_FFT_N, 
+                                                      1, 2, MicBlockCallback, spectrum);
+    if(NULL == sampler){
+        printf("audio sampler init failed.");
+        return;
+    }
 
+    // Change the bar color once per second.
+    while(1){  
+        rgb_range = rand()%9;
+        if(rgb_range == 0)
+            bar_color = 0xFF0000;
+        else if(rgb_range == 1)
+            bar_color = 0xFF8000;
+        else if(rgb_range == 2)
+            bar_color = 0xFFFF00;
+        else if(rgb_range == 3)
+            bar_color = 0x99FF00;
+        else if(rgb_range == 4)
+            bar_color = 0x00FF00;
+        else if(rgb_range == 5)
+            bar_color = 0x00FFB3;
+        else if(rgb_range == 6)
+            bar_color = 0x00FFFF;
+        else if(rgb_range == 7)
+            bar_color = 0x0000FF;
+        else if(rgb_range == 8)
+            bar_color = 0x8000FF;
+        else
+            bar_color = 0xFF0080;
+        vTaskDelay(1000 / portTICK_PERIOD_MS);
+    } 
+}
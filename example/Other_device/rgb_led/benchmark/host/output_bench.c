@@ -0,0 +1,135 @@
+/*
+ * RGB LED output stage benchmark for a Linux host.
+ *
+ * Times the rgbled_output encode used by RGBled Present against a plain copy of the frame,
+ * with and without temporal dithering, and the LUT rebuild done when a setting changes.
+ * Then checks that dithering averages low levels to their fractional value.
+ *
+ *     gcc -O2 -Wall -I../../../../../components/Other_device/rgbled/include \
+ *         output_bench.c ../../../../../components/Other_device/rgbled/rgbled_output.c -lm -o output_bench
+ *     ./output_bench              # 1000 LEDs
+ *     ./output_bench 300
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "rgbled_output.h"
+
+#define GAMMA           2.6f
+#define BRIGHTNESS      64
+#define BENCH_NS        200000000       // Run each case for about 0.2 s.
+
+static uint8_t *src;
+static uint8_t *dst;
+static volatile uint8_t sink;           // Keeps the encoded frames alive.
+
+static int64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+typedef enum{
+    BENCH_COPY,
+    BENCH_LUT,
+    BENCH_LUT_DITHER,
+}BenchCase_t;
+
+// Encode frames until BENCH_NS has passed, return ns per LED.
+static double bench_encode(RGBled_Output_t *output, BenchCase_t bench, uint32_t led_len)
+{
+    uint32_t frames = 0;
+
+    output->dither = (BENCH_LUT_DITHER == bench);
+    int64_t start = now_ns();
+    int64_t end = start;
+    while (end - start < BENCH_NS) {
+        for (int i = 0; i < 64; i++) {
+            if (BENCH_COPY == bench) {
+                memcpy(dst, src, led_len * RGBLED_OUTPUT_CHANNEL_NUM);
+            } else {
+                RGBled_OutputEncode(output, src, dst, led_len);
+            }
+            sink += dst[frames % led_len];
+            frames++;
+        }
+        end = now_ns();
+    }
+    return (double)(end - start) / frames / led_len;
+}
+
+// Average output of one input level over whole dithering periods.
+static double dither_average(RGBled_Output_t *output, uint8_t level, uint32_t led_len, uint8_t *single)
+{
+    uint32_t sum = 0;
+
+    memset(src, level, led_len * RGBLED_OUTPUT_CHANNEL_NUM);
+    output->dither = false;
+    RGBled_OutputEncode(output, src, dst, led_len);
+    *single = dst[0];
+    output->dither = true;
+    for (int f = 0; f < RGBLED_OUTPUT_DITHER_FRAMES; f++) {
+        RGBled_OutputEncode(output, src, dst, led_len);
+        sum += dst[0];
+    }
+    return (double)sum / RGBLED_OUTPUT_DITHER_FRAMES;
+}
+
+int main(int argc, char **argv)
+{
+    static const char *name[] = {"plain copy (memcpy)", "LUT", "LUT + dither"};
+    static const uint8_t check_level[] = {40, 128};
+    RGBled_Output_t output;
+    uint32_t led_len = (argc > 1) ? (uint32_t)atoi(argv[1]) : 1000;
+    int pass = 1;
+
+    if (0 == led_len) {
+        printf("usage: %s [LED number]\n", argv[0]);
+        return 1;
+    }
+    src = malloc(led_len * RGBLED_OUTPUT_CHANNEL_NUM);
+    dst = malloc(led_len * RGBLED_OUTPUT_CHANNEL_NUM);
+    if (NULL == src || NULL == dst) {
+        return 1;
+    }
+    srand(1);
+    for (uint32_t i = 0; i < led_len * RGBLED_OUTPUT_CHANNEL_NUM; i++) {
+        src[i] = rand() & 0xFF;
+    }
+
+    RGBled_OutputInit(&output);
+    output.gamma = GAMMA;
+    output.brightness = BRIGHTNESS;
+    int64_t start = now_ns();
+    int rebuilds = 0;
+    while (now_ns() - start < BENCH_NS / 4) {
+        RGBled_OutputBuildLut(&output);
+        rebuilds++;
+    }
+    double rebuild_us = (now_ns() - start) / 1000.0 / rebuilds;
+
+    printf("%u LEDs, gamma %.1f, brightness %d\n", (unsigned)led_len, GAMMA, BRIGHTNESS);
+    for (int b = BENCH_COPY; b <= BENCH_LUT_DITHER; b++) {
+        printf("  %-20s %6.2f ns/LED\n", name[b], bench_encode(&output, (BenchCase_t)b, led_len));
+    }
+    printf("  %-20s %6.1f us\n", "LUT rebuild", rebuild_us);
+
+    // Dithering must average to the ideal level within one dithering step.
+    for (size_t i = 0; i < sizeof(check_level); i++) {
+        uint8_t single = 0;
+        double ideal = powf(check_level[i] / 255.0f, GAMMA) * 255.0f * BRIGHTNESS / 255.0f;
+        double average = dither_average(&output, check_level[i], led_len, &single);
+        int ok = fabs(average - ideal) <= 1.0 / RGBLED_OUTPUT_DITHER_FRAMES;
+        printf("input %3d: ideal %6.3f, without dither %3d, dither average %6.3f  %s\n", check_level[i],
+               ideal, single, average, ok ? "PASS" : "FAIL");
+        pass &= ok;
+    }
+    free(src);
+    free(dst);
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_heap_trace.h"
+#include "esp_heap_caps.h"
+#include "driver/gpio.h"
+#include "driver/rmt.h"
+
+#include "rgbled_driver.h"
+#include "rgbled_color.h"
+#include "rgbled_output.h"
+
+#define BENCHMARK_LED_IO        27
+#define BENCHMARK_LED_LEN       60
+#define BENCHMARK_FRAME_NUM     1000
+#define BENCHMARK_TRACE_NUM     100
+#define BENCHMARK_LONG_LED_LEN  1000
+
+/**
+  * @brief  Heap used by one RGBled handle.
+  * @param[in]  led_len  Number of LEDs.
+  * @retval  bytes.
+  */
+static size_t benchmark_handle_heap(uint32_t led_len)
+{
+    size_t free_size = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    RGBled_handle_t rgbled = RGBled_Init(RGBLED_DEVICE_TYPE_WS2812, BENCHMARK_LED_IO, 
+                                         led_len, RMT_CHANNEL_0);
+    if (NULL == rgbled) {
+        return 0;
+    }
+    size_t used_size = free_size - heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    RGBled_Deinit(&rgbled);
+    return used_size;
+}
+
+/**
+  * @brief  Time of one pass of the output stage over a frame.
+  * @param[in]  output  output stage.
+  * @param[in]  src  GRB888 frame.
+  * @param[out]  dst  GRB888 frame.
+  * @retval  us per frame, memcpy if output is NULL.
+  */
+static double benchmark_output_stage(RGBled_Output_t *output, const uint8_t *src, uint8_t *dst)
+{
+    int64_t start_time = esp_timer_get_time();
+    for (uint32_t frame=0; frame<BENCHMARK_FRAME_NUM; frame++) {
+        if (NULL != output) {
+            RGBled_OutputEncode(output, src, dst, BENCHMARK_LONG_LED_LEN);
+        } else {
+            memcpy(dst, src, BENCHMARK_LONG_LED_LEN * RGBLED_BYTES_PER_LED);
+        }
+    }
+    return (double)(esp_timer_get_time() - start_time) / BENCHMARK_FRAME_NUM;
+}
+
+static heap_trace_record_t trace_record[BENCHMARK_TRACE_NUM];
+
+void app_main(void)
+{
+    RGBled_Color_t color_list[BENCHMARK_LED_LEN];
+    int64_t start_time = 0, draw_time = 0, present_time = 0, wire_time = 0;
+    size_t alloc_num = 0;
+
+    // The slope between two strip lengths removes the fixed RMT driver cost.
+    size_t short_heap = benchmark_handle_heap(BENCHMARK_LED_LEN);
+    size_t long_heap = benchmark_handle_heap(BENCHMARK_LONG_LED_LEN);
+    printf("rgbled heap: %d LEDs %u bytes, %d LEDs %u bytes, %.2f bytes per LED\n", 
+           BENCHMARK_LED_LEN, short_heap, BENCHMARK_LONG_LED_LEN, long_heap, 
+           (double)(long_heap - short_heap) / (BENCHMARK_LONG_LED_LEN - BENCHMARK_LED_LEN));
+
+    RGBled_handle_t ws2812 = RGBled_Init(RGBLED_DEVICE_TYPE_WS2812, BENCHMARK_LED_IO, 
+                                         BENCHMARK_LED_LEN, RMT_CHANNEL_0);
+    if(NULL == ws2812){
+        printf("ws2812 init failed.");
+        return;
+    }
+    ESP_ERROR_CHECK(heap_trace_init_standalone(trace_record, BENCHMARK_TRACE_NUM));
+
+    // Record every allocation, freed or not, made while the frames are sent.
+    // RGBled_SetAllColor() is split into its steps, the wire time would hide the CPU time.
+    ESP_ERROR_CHECK(heap_trace_start(HEAP_TRACE_ALL));
+    for (uint32_t frame=0; frame<BENCHMARK_FRAME_NUM; frame++) {
+        for (uint32_t i=0; i<BENCHMARK_LED_LEN; i++) {
+            color_list[i] = Rainbow_Color[(i + frame) % 10];
+        }
+        // Let the strip latch the last frame first, Present would spin on it.
+        while (esp_timer_get_time() - ws2812->tx_end_time < ws2812->reset_us) {
+            ;
+        }
+        start_time = esp_timer_get_time();
+        RGBled_CopyPixel(ws2812, 0, color_list, BENCHMARK_LED_LEN);
+        draw_time += esp_timer_get_time() - start_time;
+
+        start_time = esp_timer_get_time();
+        RGBled_Present(ws2812);
+        present_time += esp_timer_get_time() - start_time;
+
+        start_time = esp_timer_get_time();
+        RGBled_WaitPresentDone(ws2812, portMAX_DELAY);
+        wire_time += esp_timer_get_time() - start_time;
+    }
+    ESP_ERROR_CHECK(heap_trace_stop());
+    alloc_num = heap_trace_get_count();
+
+    printf("rgbled benchmark: %d LEDs, %d frames\n", BENCHMARK_LED_LEN, BENCHMARK_FRAME_NUM);
+    // The trace buffer stops recording when it is full.
+    printf("  allocations per frame: %s%.3f\n", (alloc_num >= BENCHMARK_TRACE_NUM) ? ">= " : "", 
+           (double)alloc_num / BENCHMARK_FRAME_NUM);
+    printf("  draw (back buffer):    %.1f us\n", (double)draw_time / BENCHMARK_FRAME_NUM);
+    printf("  present (encode, rmt): %.1f us\n", (double)present_time / BENCHMARK_FRAME_NUM);
+    printf("  wire (rmt transmit):   %.1f us\n", (double)wire_time / BENCHMARK_FRAME_NUM);
+    if (alloc_num > 0) {
+        heap_trace_dump();
+    }
+
+    RGBled_Deinit(&ws2812);
+
+    // Output stage cost per LED, the only extra work of Present when it is enabled.
+    uint8_t *src = malloc(BENCHMARK_LONG_LED_LEN * RGBLED_BYTES_PER_LED);
+    uint8_t *dst = malloc(BENCHMARK_LONG_LED_LEN * RGBLED_BYTES_PER_LED);
+    RGBled_Output_t *output = malloc(sizeof(RGBled_Output_t));
+    if (NULL == src || NULL == dst || NULL == output) {
+        printf("output stage benchmark malloc failed.");
+        goto BENCHMARK_OUTPUT_EXIT;
+    }
+    for (uint32_t i=0; i<BENCHMARK_LONG_LED_LEN * RGBLED_BYTES_PER_LED; i++) {
+        src[i] = rand();
+    }
+    RGBled_OutputInit(output);
+    output->gamma = 2.6f;
+    output->brightness = 64;
+    RGBled_OutputBuildLut(output);
+    printf("rgbled output stage: %d LEDs\n", BENCHMARK_LONG_LED_LEN);
+    printf("  copy:         %.3f us per LED\n", 
+           benchmark_output_stage(NULL, src, dst) / BENCHMARK_LONG_LED_LEN);
+    printf("  lut:          %.3f us per LED\n", 
+           benchmark_output_stage(output, src, dst) / BENCHMARK_LONG_LED_LEN);
+    output->dither = true;
+    printf("  lut + dither: %.3f us per LED\n", 
+           benchmark_output_stage(output, src, dst) / BENCHMARK_LONG_LED_LEN);
+
+BENCHMARK_OUTPUT_EXIT:
+    free(output);
+    free(dst);
+    free(src);
+}
@@ -0,0 +1,208 @@
+/*
+ * RGB LED effect test for a Linux host.
+ *
+ * Runs the rgbled_effect unit used by the effects example, no LED driver needed, and checks
+ * the HSV conversion, color mixing, layer crossfade and fade out, and the one shot effects.
+ *
+ *     gcc -O2 -Wall -I../../../../../components/Other_device/rgbled/include \
+ *         effect_test.c ../../../../../components/Other_device/rgbled/rgbled_effect.c -o effect_test
+ *     ./effect_test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "rgbled_effect.h"
+
+#define LED_LEN     8
+
+static int fail_count;
+
+static void check(int ok, const char *what, uint32_t got, uint32_t expected)
+{
+    if (!ok) {
+        printf("FAIL  %-44s got 0x%06X expected 0x%06X\n", what, (unsigned)got, (unsigned)expected);
+        fail_count++;
+    }
+}
+
+static void check_color(const char *what, uint32_t got, uint32_t expected)
+{
+    check(got == expected, what, got, expected);
+}
+
+// Every channel within tolerance of the expected color.
+static void check_near(const char *what, uint32_t got, uint32_t expected, int tolerance)
+{
+    int ok = 1;
+
+    for (int shift = 0; shift <= 16; shift += 8) {
+        ok &= abs((int)(got >> shift & 0xFF) - (int)(expected >> shift & 0xFF)) <= tolerance;
+    }
+    check(ok, what, got, expected);
+}
+
+static void test_hsv(void)
+{
+    static const struct{
+        uint16_t hue;
+        uint8_t sat;
+        uint8_t val;
+        uint32_t rgb;
+    }hsv[] = {
+        {0,    255, 255, 0xFF0000},
+        {128,  255, 255, 0xFF8000},
+        {256,  255, 255, 0xFFFF00},
+        {512,  255, 255, 0x00FF00},
+        {768,  255, 255, 0x00FFFF},
+        {1024, 255, 255, 0x0000FF},
+        {1280, 255, 255, 0xFF00FF},
+        {1408, 255, 255, 0xFF007F},
+        {1536, 255, 255, 0xFF0000},         // Wraps.
+        {2048, 255, 255, 0x00FF00},
+        {300,  0,   200, 0xC8C8C8},         // No saturation is gray.
+        {1000, 0,   255, 0xFFFFFF},
+        {700,  255, 0,   0x000000},         // No value is black.
+        {512,  255, 128, 0x008000},
+    };
+    char what[48];
+
+    for (size_t i = 0; i < sizeof(hsv) / sizeof(hsv[0]); i++) {
+        snprintf(what, sizeof(what), "hsv %u %u %u", hsv[i].hue, hsv[i].sat, hsv[i].val);
+        check_color(what, RGBled_HsvToRgb(hsv[i].hue, hsv[i].sat, hsv[i].val), hsv[i].rgb);
+    }
+    // Adjacent hues never jump by more than one step of a channel.
+    for (uint16_t hue = 1; hue < RGBLED_HSV_HUE_MAX; hue++) {
+        snprintf(what, sizeof(what), "hsv continuous at %u", hue);
+        check_near(what, RGBled_HsvToRgb(hue, 255, 255), RGBled_HsvToRgb(hue - 1, 255, 255), 1);
+    }
+}
+
+static void test_mix(void)
+{
+    check_color("mix t 0", RGBled_ColorMix(0x102030, 0xF0E0D0, 0), 0x102030);
+    check_color("mix t 255", RGBled_ColorMix(0x102030, 0xF0E0D0, 255), 0xF0E0D0);
+    check_near("mix t 128", RGBled_ColorMix(0x000000, 0xFF80FF, 128), 0x804080, 1);
+    check_color("scale 0", RGBled_ColorScale(0xFFFFFF, 0), 0x000000);
+    check_color("scale 255", RGBled_ColorScale(0x123456, 255), 0x123456);
+}
+
+// Red crossfades into blue over 4 frames, then stays blue.
+static void test_crossfade(void)
+{
+    RGBled_EffectStackHandle_t stack = RGBled_EffectStackInit(LED_LEN);
+    RGBled_Effect_t red = RGBled_EffectSolid(0xFF0000);
+    RGBled_Effect_t blue = RGBled_EffectSolid(0x0000FF);
+    uint32_t pixels[LED_LEN];
+    uint32_t last_red = 0xFF;
+    char what[48];
+
+    check(NULL != stack, "stack init", 0, 0);
+    if (NULL == stack) {
+        return;
+    }
+    RGBled_EffectStackSetLayer(stack, 0, &red, RGBLED_BLEND_NORMAL, 0);
+    RGBled_EffectStackRender(stack, pixels);
+    check_color("solid red", pixels[0], 0xFF0000);
+    RGBled_EffectStackSetLayer(stack, 0, &blue, RGBLED_BLEND_NORMAL, 4);
+    for (int f = 0; f < 4; f++) {
+        RGBled_EffectStackRender(stack, pixels);
+        uint32_t r = pixels[0] >> 16 & 0xFF;
+        snprintf(what, sizeof(what), "crossfade frame %d red falls", f);
+        check((r < last_red) || (3 == f && 0 == r), what, pixels[0], 0);
+        snprintf(what, sizeof(what), "crossfade frame %d sums to full", f);
+        check_near(what, pixels[0], (pixels[0] & 0xFF0000) | (0xFF - r), 1);
+        snprintf(what, sizeof(what), "crossfade frame %d same on all LEDs", f);
+        check_color(what, pixels[LED_LEN - 1], pixels[0]);
+        last_red = r;
+    }
+    check_color("crossfade ends on the new effect", pixels[0], 0x0000FF);
+    RGBled_EffectStackRender(stack, pixels);
+    check_color("crossfade done", pixels[0], 0x0000FF);
+
+    // An empty layer fades in from transparent over the layer below.
+    RGBled_EffectStackSetLayer(stack, 1, &red, RGBLED_BLEND_NORMAL, 2);
+    RGBled_EffectStackRender(stack, pixels);
+    check_near("fade in half way", pixels[0], 0x800080, 1);
+    RGBled_EffectStackRender(stack, pixels);
+    check_color("fade in done", pixels[0], 0xFF0000);
+    RGBled_EffectStackDeinit(&stack);
+}
+
+// A cleared layer keeps rendering while it fades out and is removed after the last frame.
+static void test_clear_after_fade(void)
+{
+    RGBled_EffectStackHandle_t stack = RGBled_EffectStackInit(LED_LEN);
+    RGBled_Effect_t green = RGBled_EffectSolid(0x00FF00);
+    uint32_t pixels[LED_LEN];
+    uint32_t last_green = 0xFF;
+    char what[48];
+
+    if (NULL == stack) {
+        check(0, "stack init", 0, 0);
+        return;
+    }
+    RGBled_EffectStackSetLayer(stack, 2, &green, RGBLED_BLEND_ADD, 0);
+    RGBled_EffectStackClearLayer(stack, 2, 3);
+    for (int f = 0; f < 3; f++) {
+        snprintf(what, sizeof(what), "fade out frame %d still active", f);
+        check(RGBled_EffectStackIsLayerActive(stack, 2), what, 0, 1);
+        RGBled_EffectStackRender(stack, pixels);
+        uint32_t g = pixels[0] >> 8 & 0xFF;
+        snprintf(what, sizeof(what), "fade out frame %d green falls", f);
+        check(g < last_green, what, pixels[0], 0);
+        last_green = g;
+    }
+    check_color("fade out ends black", pixels[0], 0x000000);
+    check(!RGBled_EffectStackIsLayerActive(stack, 2), "cleared after fade", 1, 0);
+    RGBled_EffectStackRender(stack, pixels);
+    check_color("cleared layer renders nothing", pixels[0], 0x000000);
+
+    // Cleared without fade, removed at once.
+    RGBled_EffectStackSetLayer(stack, 2, &green, RGBLED_BLEND_NORMAL, 0);
+    RGBled_EffectStackClearLayer(stack, 2, 0);
+    check(!RGBled_EffectStackIsLayerActive(stack, 2), "cleared at once", 1, 0);
+    check(NULL == RGBled_EffectStackInit(0), "stack init without LEDs fails", 1, 0);
+    RGBled_EffectStackDeinit(&stack);
+}
+
+static void test_one_shot(void)
+{
+    static const uint32_t colors[] = {0xFF0000, 0x00FF00, 0x0000FF};
+    RGBled_Effect_t roll = RGBled_EffectRoll(colors, 3, 2, true);
+    RGBled_Effect_t fill = RGBled_EffectFillIn(0xFFFFFF, 1, true);
+    uint32_t pixels[LED_LEN];
+    char what[48];
+
+    // Steps 0, 1, 2 of 2 frames each, then holds step 2.
+    for (int f = 0; f < 10; f++) {
+        RGBled_EffectRender(&roll, pixels, LED_LEN);
+        uint32_t step = (f / 2 < 2) ? (f / 2) : 2;
+        snprintf(what, sizeof(what), "roll once frame %d", f);
+        check_color(what, pixels[0], colors[step]);
+        snprintf(what, sizeof(what), "roll once frame %d done", f);
+        check(roll.done == (f >= 4), what, roll.done, f >= 4);
+    }
+
+    for (int f = 0; f < LED_LEN + 2; f++) {
+        RGBled_EffectRender(&fill, pixels, LED_LEN);
+    }
+    check(fill.done, "fill in once done", 0, 1);
+    check_color("fill in once holds full", pixels[LED_LEN - 1], 0xFFFFFF);
+
+    // No LEDs, nothing to render.
+    RGBled_EffectRender(&fill, pixels, 0);
+    fill = RGBled_EffectFillIn(0xFFFFFF, 1, false);
+    RGBled_EffectRender(&fill, pixels, 0);
+}
+
+int main(void)
+{
+    test_hsv();
+    test_mix();
+    test_crossfade();
+    test_clear_after_fade();
+    test_one_shot();
+    printf("%s\n", (0 == fail_count) ? "all passed" : "FAILED");
+    return (0 == fail_count) ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_system.h"
+#include "driver/gpio.h"
+#include "driver/rmt.h"
+
+#include "rgbled_driver.h"
+#include "rgbled_color.h"
+#include "rgbled_effect.h"
+#include "rgbled_engine.h"
+
+#define EFFECTS_LED_IO          27
+#define EFFECTS_LED_LEN         60
+#define EFFECTS_FPS             50
+
+void app_main(void)
+{
+    RGBled_handle_t ws2812 = RGBled_Init(RGBLED_DEVICE_TYPE_WS2812, EFFECTS_LED_IO, 
+                                         EFFECTS_LED_LEN, RMT_CHANNEL_0);
+    if(NULL == ws2812){
+        printf("ws2812 init failed.");
+        return;
+    }
+    RGBled_EngineHandle_t engine = RGBled_EngineInit(ws2812, EFFECTS_FPS, 5);
+    if(NULL == engine){
+        printf("engine init failed.");
+        return;
+    }
+
+    // Rainbow on the bottom layer, fading in over one second.
+    RGBled_Effect_t rainbow = RGBled_EffectRainbow(RGBLED_HSV_HUE_MAX / EFFECTS_LED_LEN, 2);
+    RGBled_EngineSetLayer(engine, 0, &rainbow, RGBLED_BLEND_NORMAL, EFFECTS_FPS);
+    vTaskDelay(3000 / portTICK_PERIOD_MS);
+
+    // White breathing added on top.
+    RGBled_Effect_t breath = RGBled_EffectBreath(0x404040, 2 * EFFECTS_FPS);
+    RGBled_EngineSetLayer(engine, 1, &breath, RGBLED_BLEND_ADD, 0);
+    vTaskDelay(5000 / portTICK_PERIOD_MS);
+
+    // Crossfade the bottom layer to the color roll.
+    RGBled_Effect_t roll = RGBled_EffectRoll((const uint32_t *)Rainbow_Color, 10, 5, false);
+    RGBled_EngineSetLayer(engine, 0, &roll, RGBLED_BLEND_NORMAL, EFFECTS_FPS);
+    vTaskDelay(5000 / portTICK_PERIOD_MS);
+
+    // Cancel the breathing, then fill in red once and hold it.
+    RGBled_EngineClearLayer(engine, 1, EFFECTS_FPS / 2);
+    RGBled_Effect_t fill = RGBled_EffectFillIn(RGBLED_COLOR_RED, 2, true);
+    RGBled_EngineSetLayer(engine, 2, &fill, RGBLED_BLEND_LIGHTEN, 0);
+    vTaskDelay(5000 / portTICK_PERIOD_MS);
+
+    // Fade everything out.
+    for(uint8_t i=0; i<RGBLED_EFFECT_LAYER_MAX; i++){
+        RGBled_EngineClearLayer(engine, i, EFFECTS_FPS);
+    }
+    while(RGBled_EngineIsLayerActive(engine, 0) || RGBled_EngineIsLayerActive(engine, 2)){
+        vTaskDelay(100 / portTICK_PERIOD_MS);
+    }
+    RGBled_EngineDeinit(&engine);
+    RGBled_SetAllOff(ws2812);
+    RGBled_Deinit(&ws2812);
+}
@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+"""DDP load generator for the rgbled UDP stream example.
+
+Sends a scrolling rainbow as DDP packets at a fixed frame rate and prints the
+achieved rate once per second.
+
+    python3 ddp_load.py 192.168.4.1 --leds 510 --fps 60 --duration 30
+"""
+
+import argparse
+import colorsys
+import socket
+import struct
+import time
+
+DDP_PORT = 4048
+DDP_DATA_MAX = 1440
+DDP_FLAG_VER1 = 0x40
+DDP_FLAG_PUSH = 0x01
+DDP_TYPE_RGB8 = 0x0B
+DDP_ID_DISPLAY = 1
+
+
+def build_frames(leds, count):
+    """Precompute the RGB888 frames so pacing is not limited by Python."""
+    wheel = []
+    for i in range(leds):
+        r, g, b = colorsys.hsv_to_rgb(i / leds, 1.0, 1.0)
+        wheel.append(bytes((int(r * 255), int(g * 255), int(b * 255))))
+    frames = []
+    for shift in range(count):
+        frames.append(b"".join(wheel[(i + shift) % leds] for i in range(leds)))
+    return frames
+
+
+def frame_packets(frame, seq):
+    """Split a frame into DDP packets, the last one carries the push flag."""
+    packets = []
+    for offset in range(0, len(frame), DDP_DATA_MAX):
+        data = frame[offset:offset + DDP_DATA_MAX]
+        flags = DDP_FLAG_VER1
+        if offset + len(data) >= len(frame):
+            flags |= DDP_FLAG_PUSH
+        header = struct.pack(">BBBBIH", flags, seq, DDP_TYPE_RGB8, DDP_ID_DISPLAY, offset, len(data))
+        packets.append(header + data)
+        seq = seq % 15 + 1
+    return packets, seq
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("host")
+    parser.add_argument("--port", type=int, default=DDP_PORT)
+    parser.add_argument("--leds", type=int, default=510)
+    parser.add_argument("--fps", type=float, default=60.0)
+    parser.add_argument("--duration", type=float, default=10.0, help="seconds, 0 runs until stopped")
+    args = parser.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    frames = build_frames(args.leds, args.leds)
+    period = 1.0 / args.fps
+    seq = 1
+    sent_frames = sent_packets = sent_bytes = 0
+    start = next_time = report_time = time.perf_counter()
+    report_frames = 0
+
+    try:
+        while args.duration <= 0 or time.perf_counter() - start < args.duration:
+            packets, seq = frame_packets(frames[sent_frames % len(frames)], seq)
+            for packet in packets:
+                sock.sendto(packet, (args.host, args.port))
+                sent_bytes += len(packet)
+            sent_packets += len(packets)
+            sent_frames += 1
+            report_frames += 1
+
+            now = time.perf_counter()
+            if now - report_time >= 1.0:
+                print("%.1f fps, %d packets, %.2f Mbit/s" % (
+                    report_frames / (now - report_time), sent_packets,
+                    sent_bytes * 8 / (now - start) / 1e6))
+                report_time = now
+                report_frames = 0
+            # Fixed schedule, a late frame does not shift the following ones.
+            next_time += period
+            delay = next_time - time.perf_counter()
+            if delay > 0:
+                time.sleep(delay)
+    except KeyboardInterrupt:
+        pass
+
+    elapsed = time.perf_counter() - start
+    print("total: %d frames, %d packets in %.1f s, %.1f fps" % (
+        sent_frames, sent_packets, elapsed, sent_frames / elapsed))
+
+
+if __name__ == "__main__":
+    main()
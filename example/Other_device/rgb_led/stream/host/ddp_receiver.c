@@ -0,0 +1,212 @@
+/*
+ * DDP receiver for a Linux host.
+ *
+ * Checks the rgbled_ddp parser on fixed packets, then optionally receives a stream from
+ * ddp_load.py the way rgbled_stream.c does: parse, drop late packets, reorder RGB to GRB
+ * into a frame buffer and count a frame on the push flag. Prints the counters and the
+ * parse and copy time per packet when the sender stops.
+ *
+ *     gcc -O2 -Wall -I../../../../../components/Other_device/rgbled/include \
+ *         ddp_receiver.c ../../../../../components/Other_device/rgbled/rgbled_ddp.c -o ddp_receiver
+ *     ./ddp_receiver                          # parser checks only
+ *     ./ddp_receiver 4048 510 &               # then: python3 ../ddp_load.py 127.0.0.1 --leds 510
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include "rgbled_ddp.h"
+
+#define IDLE_TIMEOUT_S      2       // Stop after the stream pauses this long.
+
+static int fail_count;
+
+static void check(int ok, const char *what)
+{
+    if (!ok) {
+        printf("FAIL  %s\n", what);
+        fail_count++;
+    }
+}
+
+static uint32_t build_packet(uint8_t *buf, uint8_t flags, uint8_t seq, uint8_t type, uint8_t id,
+                             uint32_t offset, uint16_t len)
+{
+    uint32_t header_len = RGBLED_DDP_HEADER_LEN;
+
+    buf[0] = flags;
+    buf[1] = seq;
+    buf[2] = type;
+    buf[3] = id;
+    buf[4] = offset >> 24;
+    buf[5] = offset >> 16;
+    buf[6] = offset >> 8;
+    buf[7] = offset;
+    buf[8] = len >> 8;
+    buf[9] = len;
+    if (flags & RGBLED_DDP_FLAG_TIMECODE) {
+        memset(&buf[header_len], 0, RGBLED_DDP_TIMECODE_LEN);
+        header_len += RGBLED_DDP_TIMECODE_LEN;
+    }
+    for (uint16_t i = 0; i < len; i++) {
+        buf[header_len + i] = i;
+    }
+    return header_len + len;
+}
+
+static void test_parse(void)
+{
+    static uint8_t buf[RGBLED_DDP_PACKET_MAX];
+    const uint8_t ver1 = RGBLED_DDP_FLAG_VER1;
+    RGBled_DdpPacket_t packet;
+    uint32_t size = 0;
+
+    size = build_packet(buf, ver1 | RGBLED_DDP_FLAG_PUSH, 3, RGBLED_DDP_TYPE_RGB8,
+                        RGBLED_DDP_ID_DISPLAY, 0x010203, 30);
+    check(0 == RGBled_DdpParse(buf, size, &packet), "rgb888 packet accepted");
+    check(3 == packet.seq && 0x010203 == packet.offset && 30 == packet.len, "rgb888 header fields");
+    check(packet.data == &buf[RGBLED_DDP_HEADER_LEN], "rgb888 data pointer");
+
+    size = build_packet(buf, ver1 | RGBLED_DDP_FLAG_TIMECODE, 0, RGBLED_DDP_TYPE_RGB8,
+                        RGBLED_DDP_ID_DISPLAY, 0, 6);
+    check(0 == RGBled_DdpParse(buf, size, &packet), "timecode packet accepted");
+    check(packet.data == &buf[RGBLED_DDP_HEADER_LEN + RGBLED_DDP_TIMECODE_LEN], "timecode skipped");
+
+    // Data types other than RGB 8 bit.
+    size = build_packet(buf, ver1, 1, 0x1B, RGBLED_DDP_ID_DISPLAY, 0, 32);
+    check(0 != RGBled_DdpParse(buf, size, &packet), "rgbw packet rejected");
+    size = build_packet(buf, ver1, 1, 0x0C, RGBLED_DDP_ID_DISPLAY, 0, 30);
+    check(0 != RGBled_DdpParse(buf, size, &packet), "rgb 16 bit packet rejected");
+    size = build_packet(buf, ver1, 1, 0x8B, RGBLED_DDP_ID_DISPLAY, 0, 30);
+    check(0 != RGBled_DdpParse(buf, size, &packet), "custom type packet rejected");
+    size = build_packet(buf, ver1, 1, 0x00, RGBLED_DDP_ID_DISPLAY, 0, 30);
+    check(0 != RGBled_DdpParse(buf, size, &packet), "undefined type packet rejected");
+
+    // Not pixel data, or broken.
+    size = build_packet(buf, ver1 | RGBLED_DDP_FLAG_QUERY, 1, RGBLED_DDP_TYPE_RGB8, RGBLED_DDP_ID_DISPLAY, 0, 0);
+    check(0 != RGBled_DdpParse(buf, size, &packet), "query rejected");
+    size = build_packet(buf, ver1, 1, RGBLED_DDP_TYPE_RGB8, RGBLED_DDP_ID_CONTROL, 0, 0);
+    check(0 != RGBled_DdpParse(buf, size, &packet), "control id rejected");
+    size = build_packet(buf, 0x80, 1, RGBLED_DDP_TYPE_RGB8, RGBLED_DDP_ID_DISPLAY, 0, 3);
+    check(0 != RGBled_DdpParse(buf, size, &packet), "version 2 rejected");
+    size = build_packet(buf, ver1, 1, RGBLED_DDP_TYPE_RGB8, RGBLED_DDP_ID_DISPLAY, 0, 30);
+    check(0 != RGBled_DdpParse(buf, size - 1, &packet), "short data rejected");
+    check(0 != RGBled_DdpParse(buf, RGBLED_DDP_HEADER_LEN - 1, &packet), "short header rejected");
+    size = build_packet(buf, ver1 | RGBLED_DDP_FLAG_TIMECODE, 1, RGBLED_DDP_TYPE_RGB8, RGBLED_DDP_ID_DISPLAY, 0, 0);
+    check(0 != RGBled_DdpParse(buf, RGBLED_DDP_HEADER_LEN, &packet), "missing timecode rejected");
+
+    check(0 == RGBled_DdpSeqLost(4, 5), "seq in order");
+    check(0 == RGBled_DdpSeqLost(15, 1), "seq wraps");
+    check(2 == RGBled_DdpSeqLost(14, 2), "seq lost across the wrap");
+    check(-1 == RGBled_DdpSeqLost(5, 5), "seq duplicate");
+    check(-1 == RGBled_DdpSeqLost(5, 3), "seq late");
+    check(0 == RGBled_DdpSeqLost(0, 9) && 0 == RGBled_DdpSeqLost(9, 0), "seq not used");
+}
+
+static int64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// Same byte order and clipping as RGBled_CopyRgbBytes, without the dirty range.
+static void copy_rgb_bytes(uint8_t *frame, uint32_t size, uint32_t offset, const uint8_t *data, uint32_t len)
+{
+    static const uint8_t grb_pos[3] = {1, 0, 2};
+    uint32_t led = offset / 3;
+    uint32_t color = offset % 3;
+
+    if (len > size - offset) {
+        len = size - offset;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+        frame[led * 3 + grb_pos[color]] = data[i];
+        if (++color == 3) {
+            color = 0;
+            led++;
+        }
+    }
+}
+
+static int receive(uint16_t port, uint32_t led_len)
+{
+    static uint8_t buf[RGBLED_DDP_PACKET_MAX];
+    uint32_t frame_size = led_len * 3;
+    uint8_t *frame = calloc(1, frame_size);
+    uint32_t packets = 0, frames = 0, lost_packets = 0, late_packets = 0, invalid_packets = 0;
+    uint8_t last_seq = 0;
+    int64_t busy_ns = 0;
+    RGBled_DdpPacket_t packet;
+
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    struct timeval timeout = {
+        .tv_sec = IDLE_TIMEOUT_S,
+    };
+    if (NULL == frame || sock < 0 || 0 != bind(sock, (struct sockaddr *)&addr, sizeof(addr))) {
+        perror("receiver");
+        return 1;
+    }
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    printf("listening on udp port %u, %u LEDs\n", port, (unsigned)led_len);
+    while (1) {
+        ssize_t len = recv(sock, buf, sizeof(buf), 0);
+        if (len < 0) {
+            if (packets + invalid_packets > 0) {
+                break;
+            }
+            continue;
+        }
+        int64_t start = now_ns();
+        if (0 != RGBled_DdpParse(buf, len, &packet)) {
+            invalid_packets++;
+            continue;
+        }
+        int lost = RGBled_DdpSeqLost(last_seq, packet.seq);
+        if (lost < 0) {
+            late_packets++;
+            continue;
+        }
+        lost_packets += lost;
+        packets++;
+        if (0 != packet.seq) {
+            last_seq = packet.seq;
+        }
+        if (packet.len > 0 && packet.offset < frame_size) {
+            copy_rgb_bytes(frame, frame_size, packet.offset, packet.data, packet.len);
+        }
+        if ((packet.flags & RGBLED_DDP_FLAG_PUSH) || packet.offset + packet.len >= frame_size) {
+            frames++;
+        }
+        busy_ns += now_ns() - start;
+    }
+    printf("%u frames, %u packets, lost %u, late %u, invalid %u, %.2f us parse and copy per packet\n",
+           (unsigned)frames, (unsigned)packets, (unsigned)lost_packets, (unsigned)late_packets,
+           (unsigned)invalid_packets, packets ? busy_ns / 1000.0 / packets : 0.0);
+    close(sock);
+    free(frame);
+    return (0 == lost_packets && 0 == late_packets && 0 == invalid_packets) ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    test_parse();
+    printf("parser checks %s\n", (0 == fail_count) ? "passed" : "FAILED");
+    if (fail_count) {
+        return 1;
+    }
+    if (argc > 1) {
+        return receive(atoi(argv[1]), (argc > 2) ? atoi(argv[2]) : 510);
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_system.h"
+#include "esp_log.h"
+#include "nvs_flash.h"
+#include "driver/gpio.h"
+#include "driver/rmt.h"
+
+#include "rgbled_driver.h"
+#include "rgbled_stream.h"
+#include "wifi_driver.h"
+
+#define WIFI_AP_SSID        "Rubik wifi"
+#define WIFI_AP_PASS        "88888888"
+
+#define STREAM_LED_IO       27
+#define STREAM_LED_LEN      510
+
+// Run ddp_load.py 192.168.4.1 --leds 510 --fps 60 from a computer connected to the AP.
+void app_main(void)
+{
+    RGBled_StreamStats_t stats, last_stats = { 0 };
+
+    esp_err_t ret = nvs_flash_init();               
+    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) { 
+      ESP_ERROR_CHECK(nvs_flash_erase());             
+      ret = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(ret);
+
+    RGBled_handle_t ws2812 = RGBled_Init(RGBLED_DEVICE_TYPE_WS2812, STREAM_LED_IO, 
+                                         STREAM_LED_LEN, RMT_CHANNEL_0);
+    if(NULL == ws2812){
+        printf("ws2812 init failed.");
+        return;
+    }
+
+    WIFI_Init();
+    WIFI_Init_Softap(WIFI_AP_SSID, WIFI_AP_PASS);
+
+    RGBled_StreamHandle_t stream = RGBled_StreamInit(ws2812, RGBLED_DDP_PORT, 10);
+    if(NULL == stream){
+        printf("stream init failed.");
+        return;
+    }
+
+    while(1){
+        vTaskDelay(1000 / portTICK_PERIOD_MS);
+        RGBled_StreamGetStats(stream, &stats);
+        printf("%u fps, %u packets, lost %u, late %u, invalid %u\n", 
+               stats.frames - last_stats.frames, stats.packets - last_stats.packets, 
+               stats.lost_packets, stats.late_packets, stats.invalid_packets);
+        last_stats = stats;
+    }
+}
@@ -0,0 +1,202 @@
+/*
+ * SD logger throughput benchmark for a Linux host.
+ *
+ * Runs the same sd_logger_core used on the ESP32 against a file, next to plain stdio logging,
+ * and prints MB/s and the slowest record write seen by the producer. Both sync once per second.
+ *
+ *     gcc -O2 -pthread -I../../../../../components/Other_device/sd_logger/include \
+ *         logger_bench.c ../../../../../components/Other_device/sd_logger/sd_logger_core.c -o logger_bench
+ *
+ * To get close to the card, run it on a FAT file system in a file-backed block device
+ * without the page cache in front of the image:
+ *
+ *     truncate -s 512M sd.img && mkfs.vfat -s 32 sd.img
+ *     sudo losetup --direct-io=on -f --show sd.img        # prints /dev/loopN
+ *     sudo mount -o sync /dev/loopN /mnt/sd
+ *     ./logger_bench /mnt/sd/log.bin 64
+ *
+ * Any file system on the loop device works when FAT tools are missing, or point it at 
+ * a real card in a USB reader.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "sd_logger_core.h"
+
+#define RECORD_SIZE     48
+#define SYNC_INTERVAL   1000            // ms
+#define RING_SIZE       (256 * 1024)
+#define CHUNK_SIZE      (16 * 1024)
+#define PREALLOC_SIZE   (4 * 1024 * 1024)
+
+typedef struct{
+    const char *name;
+    double seconds;
+    int64_t max_record_us;
+}BenchResult_t;
+
+static SD_LoggerCore_t core;
+static volatile int producer_done;
+static pthread_mutex_t wake_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;
+
+static int64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void make_record(uint8_t *record, uint32_t i)
+{
+    memset(record, (int)(i & 0xFF), RECORD_SIZE);
+    memcpy(record, &i, sizeof(i));
+}
+
+// Baseline, the way the apps log today: fwrite per record, fflush and fsync every sync interval.
+static int bench_stdio(const char *path, uint64_t total, BenchResult_t *result)
+{
+    uint8_t record[RECORD_SIZE];
+    int64_t last_sync = now_us();
+    int64_t start = last_sync;
+
+    FILE *f = fopen(path, "w");
+    if (NULL == f) {
+        return -1;
+    }
+    result->max_record_us = 0;
+    for (uint32_t i = 0; (uint64_t)i * RECORD_SIZE < total; i++) {
+        make_record(record, i);
+        int64_t t = now_us();
+        fwrite(record, 1, RECORD_SIZE, f);
+        if (t - last_sync >= SYNC_INTERVAL * 1000) {
+            fflush(f);
+            fsync(fileno(f));
+            last_sync = t;
+        }
+        int64_t cost = now_us() - t;
+        if (cost > result->max_record_us) {
+            result->max_record_us = cost;
+        }
+    }
+    fflush(f);
+    fsync(fileno(f));
+    fclose(f);
+    result->seconds = (now_us() - start) / 1e6;
+    return 0;
+}
+
+// Flush side of the logger, as the ESP32 flush task does it: woken per chunk, sync on timeout.
+static void *flush_thread(void *arg)
+{
+    int64_t last_sync = now_us();
+    struct timespec deadline;
+
+    (void)arg;
+    while (!producer_done) {
+        pthread_mutex_lock(&wake_lock);
+        if (!producer_done && (SD_LoggerCore_Fill(&core) < CHUNK_SIZE)) {
+            // Wait until the next sync is due, not a full interval from this wake.
+            int64_t left = last_sync + SYNC_INTERVAL * 1000 - now_us();
+            if (left > 0) {
+                clock_gettime(CLOCK_REALTIME, &deadline);
+                deadline.tv_sec += left / 1000000;
+                deadline.tv_nsec += (left % 1000000) * 1000;
+                if (deadline.tv_nsec >= 1000000000) {
+                    deadline.tv_sec++;
+                    deadline.tv_nsec -= 1000000000;
+                }
+                pthread_cond_timedwait(&wake, &wake_lock, &deadline);
+            }
+        }
+        pthread_mutex_unlock(&wake_lock);
+        int64_t t = now_us();
+        bool sync = (t - last_sync >= SYNC_INTERVAL * 1000);
+        if (sync) {
+            last_sync = t;
+        }
+        SD_LoggerCore_Flush(&core, sync);
+    }
+    return NULL;
+}
+
+static void flush_wake(void)
+{
+    pthread_mutex_lock(&wake_lock);
+    pthread_cond_signal(&wake);
+    pthread_mutex_unlock(&wake_lock);
+}
+
+static int bench_logger(const char *path, uint64_t total, BenchResult_t *result)
+{
+    uint8_t record[RECORD_SIZE];
+    pthread_t flusher;
+    uint32_t stalls = 0;
+
+    uint8_t *ring = aligned_alloc(SD_LOGGER_SECTOR_SIZE, RING_SIZE);
+    if ((NULL == ring) || (0 != SD_LoggerCore_Init(&core, ring, RING_SIZE, CHUNK_SIZE, NULL)) ||
+        (0 != SD_LoggerCore_Open(&core, path, PREALLOC_SIZE))) {
+        free(ring);
+        return -1;
+    }
+    producer_done = 0;
+    int64_t start = now_us();
+    pthread_create(&flusher, NULL, flush_thread, NULL);
+    result->max_record_us = 0;
+    for (uint32_t i = 0; (uint64_t)i * RECORD_SIZE < total; i++) {
+        make_record(record, i);
+        int64_t t = now_us();
+        // The producer outruns any card, wait for room instead of dropping to measure throughput.
+        while (0 == SD_LoggerCore_Push(&core, record, RECORD_SIZE)) {
+            stalls++;
+            flush_wake();
+            sched_yield();
+        }
+        // Wake the flush side once per completed chunk.
+        if (((core.head - RECORD_SIZE) / CHUNK_SIZE) != (core.head / CHUNK_SIZE)) {
+            flush_wake();
+        }
+        int64_t cost = now_us() - t;
+        if (cost > result->max_record_us) {
+            result->max_record_us = cost;
+        }
+    }
+    producer_done = 1;
+    flush_wake();
+    pthread_join(flusher, NULL);
+    SD_LoggerCore_Close(&core);
+    result->seconds = (now_us() - start) / 1e6;
+    printf("  logger: %u chunk writes, %u syncs, %u full ring retries, %u write errors\n",
+           (unsigned)(core.bytes_written / CHUNK_SIZE), (unsigned)core.sync_count, (unsigned)stalls,
+           (unsigned)core.write_error);
+    free(ring);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    BenchResult_t results[2] = {{.name = "stdio"}, {.name = "sd_logger"}};
+
+    if (argc < 2) {
+        printf("usage: %s <file> [MB]\n", argv[0]);
+        return 1;
+    }
+    uint64_t total = (uint64_t)((argc > 2) ? atoi(argv[2]) : 16) * 1024 * 1024;
+
+    if ((0 != bench_stdio(argv[1], total, &results[0])) || (0 != bench_logger(argv[1], total, &results[1]))) {
+        perror(argv[1]);
+        return 1;
+    }
+    printf("%-10s %10s %16s\n", "writer", "MB/s", "max record us");
+    for (int i = 0; i < 2; i++) {
+        printf("%-10s %10.1f %16lld\n", results[i].name, total / 1048576.0 / results[i].seconds,
+               (long long)results[i].max_record_us);
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <string.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "sd_spi_vfs.h"
+#include "sd_logger.h"
+
+static const char *TAG = "SD_LOGGER_TEST";
+
+#define MOUNT_POINT     "/sd_card"
+#define LOG_RATE_HZ     1000            // Records per second from the sampling task.
+#define LOG_SECONDS     60
+
+static TaskHandle_t main_task;
+
+// One CSV record per sample, a few dozen bytes each.
+static void SampleTask(void *arg)
+{
+    SD_Logger_handle_t logger = (SD_Logger_handle_t)arg;
+    TickType_t last_wake = xTaskGetTickCount();
+    int64_t max_write_us = 0;
+    char line[64];
+
+    for(uint32_t i=0; i<LOG_RATE_HZ*LOG_SECONDS; i++){
+        int len = snprintf(line, sizeof(line), "%lld,%u,%d,%d,%d\n", 
+                           (long long)esp_timer_get_time(), (unsigned)i, (int)(i % 4096), (int)((i * 7) % 4096), (int)((i * 13) % 4096));
+        int64_t start = esp_timer_get_time();
+        if(ESP_OK != SD_Logger_Write(logger, line, len)){
+            ESP_LOGW(TAG, "record %u dropped", (unsigned)i);
+        }
+        int64_t cost = esp_timer_get_time() - start;
+        if(cost > max_write_us){
+            max_write_us = cost;
+        }
+        // 1 ms per record at a 1000 Hz tick, otherwise several records per tick.
+        if(0 == (i % (LOG_RATE_HZ / configTICK_RATE_HZ))){
+            vTaskDelayUntil(&last_wake, 1);
+        }
+    }
+    ESP_LOGI(TAG, "sampling done, slowest SD_Logger_Write %lld us", (long long)max_write_us);
+    xTaskNotifyGive(main_task);
+    vTaskDelete(NULL);
+}
+
+void app_main(void)
+{
+    SD_LoggerStats_t stats;
+
+    // 16 KB SPI transfers so a logger chunk goes to the card in one DMA transfer.
+    SD_Spi_Vfs_Config_t sd_config = SD_SPI_VFS_CONFIG_DEFAULT(19, 33, 32, 4);
+    SD_Spi_Vfs_handle_t sd_card = SD_Spi_Vfs_InitConfig(&sd_config, MOUNT_POINT);
+    if(NULL == sd_card){
+        return;
+    }
+
+    // 64 KB ring, 16 KB writes, at most 1 s of data lost.
+    SD_LoggerConfig_t config = SD_LOGGER_CONFIG_DEFAULT(MOUNT_POINT"/log.csv");
+    SD_Logger_handle_t logger = SD_Logger_Init(&config);
+    if(NULL == logger){
+        SD_Spi_Vfs_Deinit(&sd_card);
+        return;
+    }
+
+    main_task = xTaskGetCurrentTaskHandle();
+    xTaskCreatePinnedToCore(SampleTask, "sample", 3072, logger, 5, NULL, 1);
+    while(0 == ulTaskNotifyTake(pdTRUE, 1000 / portTICK_PERIOD_MS)){
+        SD_Logger_GetStats(logger, &stats);
+        ESP_LOGI(TAG, "written %llu, lost %u, max fill %u, syncs %u, errors %u", (unsigned long long)stats.bytes_written, 
+                 (unsigned)stats.bytes_lost, (unsigned)stats.max_fill, (unsigned)stats.sync_count, (unsigned)stats.write_error);
+    }
+
+    SD_Logger_Deinit(&logger);
+    SD_Spi_Vfs_Deinit(&sd_card);
+    ESP_LOGI(TAG, "log closed");
+}
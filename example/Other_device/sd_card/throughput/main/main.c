@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <string.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "sd_spi_vfs.h"
+
+static const char *TAG = "SD_THROUGHPUT";
+
+#define MOUNT_POINT     "/sd_card"
+#define BENCH_FILE_SIZE (4 * 1024 * 1024)
+#define BENCH_BLOCK     (16 * 1024)
+// Set to 1 on boards that route the SDMMC slot 1 pins to the card.
+#define BENCH_SDMMC     0
+
+typedef struct{
+    int freq_khz;
+    int max_transfer_sz;
+}SpiBenchConfig_t;
+
+// SPI clock and DMA transfer size combinations to compare.
+static const SpiBenchConfig_t spi_configs[] = {
+    {SDMMC_FREQ_DEFAULT, 4000},         // The old SD_Spi_Vfs_Init() settings.
+    {SDMMC_FREQ_DEFAULT, 16 * 1024},
+    {SDMMC_FREQ_HIGHSPEED, 4000},
+    {SDMMC_FREQ_HIGHSPEED, 16 * 1024},
+    {SDMMC_FREQ_HIGHSPEED, 32 * 1024},
+};
+
+static void PrintResult(const char *bus, int freq_khz, int transfer, const SD_Vfs_BenchResult_t *result)
+{
+    printf("%-6s %8d %10d %10.2f %10.2f\n", bus, freq_khz, transfer, result->write_mbps, result->read_mbps);
+}
+
+void app_main(void)
+{
+    SD_Vfs_BenchResult_t results[sizeof(spi_configs) / sizeof(spi_configs[0])];
+    int freq[sizeof(spi_configs) / sizeof(spi_configs[0])] = {0};
+
+    for(uint8_t i=0; i<sizeof(spi_configs)/sizeof(spi_configs[0]); i++){
+        SD_Spi_Vfs_Config_t config = SD_SPI_VFS_CONFIG_DEFAULT(19, 33, 32, 4);
+        config.freq_khz = spi_configs[i].freq_khz;
+        config.max_transfer_sz = spi_configs[i].max_transfer_sz;
+
+        SD_Spi_Vfs_handle_t sd_card = SD_Spi_Vfs_InitConfig(&config, MOUNT_POINT);
+        if(NULL == sd_card){
+            ESP_LOGE(TAG, "mount at %d kHz failed", config.freq_khz);
+            continue;
+        }
+        // The clock may have been lowered after CRC errors.
+        freq[i] = sd_card->freq_khz;
+        if(ESP_OK != SD_Vfs_Benchmark(sd_card, BENCH_FILE_SIZE, BENCH_BLOCK, &results[i])){
+            freq[i] = 0;
+        }
+        SD_Spi_Vfs_Deinit(&sd_card);
+    }
+
+    printf("%-6s %8s %10s %10s %10s\n", "bus", "kHz", "transfer", "write MB/s", "read MB/s");
+    for(uint8_t i=0; i<sizeof(spi_configs)/sizeof(spi_configs[0]); i++){
+        if(0 != freq[i]){
+            PrintResult("SPI", freq[i], spi_configs[i].max_transfer_sz, &results[i]);
+        }
+    }
+
+#if BENCH_SDMMC
+    SD_Vfs_BenchResult_t mmc_result;
+    SD_Mmc_Vfs_Config_t mmc_config = SD_MMC_VFS_CONFIG_DEFAULT();
+    SD_Spi_Vfs_handle_t mmc_card = SD_Mmc_Vfs_Init(&mmc_config, MOUNT_POINT);
+    if(NULL != mmc_card){
+        if(ESP_OK == SD_Vfs_Benchmark(mmc_card, BENCH_FILE_SIZE, BENCH_BLOCK, &mmc_result)){
+            PrintResult("SDMMC", mmc_card->freq_khz, 0, &mmc_result);
+        }
+        SD_Spi_Vfs_Deinit(&mmc_card);
+    }
+#endif
+
+    while(1){
+        vTaskDelay(1000 / portTICK_PERIOD_MS);
+    }
+}